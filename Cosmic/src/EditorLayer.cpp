@@ -6,6 +6,8 @@
 #include "Nebula/ImGui/NebulaGui.h"
 #include "Nebula/Application.h"
 #include "Nebula/Project/Project.h"
+#include "Nebula/Core/AssetPack.h"
+#include "Nebula/Core/DerivedDataCache.h"
 #include "Nebula/Scripting/ScriptEngine.h"
 #include "Nebula/Scripting/ScriptBuilder.h"
 #include <Nebula/Scene/Components.h>
@@ -26,6 +28,7 @@
 #include "EditorWindows/PropertiesPanel.h"
 #include "EditorWindows/MenuBar.h"
 #include "EditorWindows/ContentBrowser.h"
+#include "EditorWindows/ScriptProfilerWindow.h"
 
 #include "Nebula/Input.h"
 #include "Nebula/Keycodes.h"
@@ -106,6 +109,17 @@ namespace Cosmic {
 
 		SceneHierarchy::SetContext(m_ActiveScene);
 
+		// Long editor sessions browse a lot of assets, keep the unused ones from piling up
+		Nebula::AssetManager::SetMemoryBudget(512ull * 1024 * 1024);
+
+		// A file the open scene uses changed on disk, swap in just what came from it
+		Nebula::AssetManager::SetDependencyChangedCallback([this](const std::string& dependent, const std::string& changedPath)
+		{
+			if (m_ActiveScene && !m_CurrentScenePath.empty() &&
+				Nebula::AssetManager::NormalizeAssetPath(dependent) == Nebula::AssetManager::NormalizeAssetPath(m_CurrentScenePath))
+				m_ActiveScene->ReloadAssetReferences(changedPath);
+		});
+
 		// Setup content browser
 		ContentBrowser::Initialize();
 		ContentBrowser::SetContentPath("assets");
@@ -122,11 +136,16 @@ namespace Cosmic {
 			[this]() { ToggleRuntime(); },
 			[this]() { m_SceneListWindow.SetOpen(true); }
 		);
+		MenuBar::SetBuildAssetPackCallback([this]() { BuildAssetPack(); });
 
 	}
 
 	void EditorLayer::OnDetach()
 	{
+		Nebula::FileWatcher::Unwatch(m_ScriptWatch);
+		Nebula::ScriptBuilder::WaitForBuild();
+		Nebula::AssetManager::SetDependencyChangedCallback(nullptr);
+
 		delete m_Framebuffer;
 		delete m_GameViewFramebuffer;
 
@@ -140,10 +159,18 @@ namespace Cosmic {
 	{
 		glm::vec2 viewportSize = m_ViewportSize;
 
-		// Check for script file changes (only in editor mode)
+		// Rebuild on script changes and pick up finished builds (only in editor mode).
+		// This runs before any scene update, so it's a safe point to swap the script assembly.
 		if (!m_RuntimeMode && m_ProjectLoaded)
 		{
-			CheckScriptFileChanges();
+			if (m_ScriptsDirty)
+			{
+				m_ScriptsDirty = false;
+				NB_CORE_INFO("Script file changes detected, rebuilding...");
+				ConsoleWindow::AddLog("Script changes detected, rebuilding...", Nebula::LogLevel::LOG_INFO);
+				RebuildScripts();
+			}
+			PollScriptBuild();
 		}
 
 		// Handle gizmo interaction (only in editor mode)
@@ -554,6 +581,9 @@ namespace Cosmic {
 		// Debug Window
 		DebugWindow::OnImGuiRender(m_ActiveScene, m_RuntimeMode);
 
+		// Script Profiler
+		ScriptProfilerWindow::OnImGuiRender();
+
 		// Content Browser
 		ContentBrowser::OnImGuiRender();
 
@@ -621,6 +651,47 @@ namespace Cosmic {
 		}
 	}
 
+	void EditorLayer::BuildAssetPack()
+	{
+		// Mounted by the runtime as Game.nbpak. Library holds the engine files the runtime opens
+		// directly, so all of it goes in. Game assets only when a scene in the scene list reaches them.
+		Nebula::AssetPackBuilder builder;
+		if (std::filesystem::exists("Library"))
+			builder.AddDirectory("Library", "Library");
+
+		std::vector<std::string> roots = { "assets/SceneList.json" };
+		const auto& sceneList = Nebula::SceneManager::Get().GetSceneList();
+		roots.insert(roots.end(), sceneList.begin(), sceneList.end());
+
+		size_t assetCount = 0;
+		for (const std::string& path : Nebula::AssetManager::CollectDependencies(roots))
+		{
+			// Named the way the runtime's VirtualFileSystem will ask for it
+			std::string packPath = Nebula::AssetManager::NormalizeAssetPath(path);
+			std::error_code error;
+			if (std::filesystem::is_directory(path, error))
+				builder.AddDirectory(path, packPath);
+			else if (std::filesystem::is_regular_file(path, error))
+				builder.AddFile(path, packPath);
+			else
+			{
+				NB_CORE_WARN("Asset referenced but missing, not packed: {0}", path);
+				continue;
+			}
+			assetCount++;
+		}
+
+		if (builder.GetFileCount() == 0)
+		{
+			NB_CORE_WARN("Nothing to pack, no scene list or Library directory found");
+			return;
+		}
+
+		NB_CORE_INFO("Packing {0} reachable assets", assetCount);
+
+		builder.Write("Game.nbpak");
+	}
+
 	void EditorLayer::LoadScene()
 	{
 		Nebula::FileDialog* dialog = Nebula::FileDialog::Create();
@@ -680,6 +751,13 @@ namespace Cosmic {
 				return;
 			}
 
+			if (Nebula::ScriptBuilder::IsBuilding())
+			{
+				ConsoleWindow::AddLog("Cannot start runtime: Scripts are still compiling", Nebula::LogLevel::LOG_WARN);
+				NB_CORE_WARN("Cannot start runtime: Script build in progress");
+				return;
+			}
+
 			// Check for build errors
 			if (m_HasBuildErrors)
 			{
@@ -826,6 +904,9 @@ namespace Cosmic {
 			return;
 		}
 
+		// Processed textures, meshes and shader binaries, so reopening the project skips reimporting unchanged files
+		Nebula::DerivedDataCache::Init(projectPath / "DerivedData");
+
 		// Build the project scripts
 		NB_CORE_INFO("Building project scripts...");
 		if (!Nebula::ScriptBuilder::BuildProjectScripts(projectPath))
@@ -850,10 +931,12 @@ namespace Cosmic {
 
 		// Setup script file watching
 		m_ScriptsDirectory = projectPath / "Assets" / "Scripts";
-		if (std::filesystem::exists(m_ScriptsDirectory))
-		{
-			m_LastScriptModifyTime = std::filesystem::last_write_time(m_ScriptsDirectory);
-		}
+		WatchScriptFiles();
+
+		// Hot reload project assets and the engine shaders
+		Nebula::AssetManager::DisableHotReload();
+		Nebula::AssetManager::EnableHotReload(Nebula::Project::GetAssetDirectory());
+		Nebula::AssetManager::EnableHotReload("Library/shaders");
 
 		// Load the start scene if specified
 		if (!project->GetConfig().StartScene.empty())
@@ -919,65 +1002,60 @@ public class ExampleScript : ScriptBehavior
 		NB_CORE_INFO("Project created successfully!");
 	}
 
-	void EditorLayer::CheckScriptFileChanges()
+	void EditorLayer::WatchScriptFiles()
 	{
-		if (!std::filesystem::exists(m_ScriptsDirectory))
-			return;
-
-		try
+		Nebula::FileWatcher::Unwatch(m_ScriptWatch);
+		m_ScriptWatch = Nebula::FileWatcher::Watch(m_ScriptsDirectory, [this](const std::vector<Nebula::FileWatchChange>& changes)
 		{
-			auto currentTime = std::filesystem::last_write_time(m_ScriptsDirectory);
-
-			// Also check all .cs files for changes
-			bool filesChanged = false;
-			for (const auto& entry : std::filesystem::recursive_directory_iterator(m_ScriptsDirectory))
-			{
-				if (entry.is_regular_file() && entry.path().extension() == ".cs")
-				{
-					auto fileTime = std::filesystem::last_write_time(entry.path());
-					if (fileTime > m_LastScriptModifyTime)
-					{
-						filesChanged = true;
-						break;
-					}
-				}
-			}
-
-			if (filesChanged)
+			for (const auto& change : changes)
 			{
-				NB_CORE_INFO("Script file changes detected, rebuilding...");
-				ConsoleWindow::AddLog("Script changes detected, rebuilding...", Nebula::LogLevel::LOG_INFO);
-				m_LastScriptModifyTime = std::filesystem::file_time_type::clock::now();
-				RebuildScripts();
+				// dotnet build writes generated .cs files into obj/, those must not trigger another build
+				auto relative = std::filesystem::relative(change.Path, m_ScriptsDirectory);
+				auto topLevel = relative.begin() != relative.end() ? *relative.begin() : std::filesystem::path();
+				if (topLevel == "bin" || topLevel == "obj")
+					continue;
+
+				// Picked up in OnUpdate, so edits made during play mode rebuild once we're back in the editor
+				m_ScriptsDirty = true;
+				return;
 			}
-		}
-		catch (const std::filesystem::filesystem_error& e)
-		{
-			NB_CORE_ERROR("Error checking script files: {0}", e.what());
-		}
+		}, { ".cs" });
 	}
 
 	void EditorLayer::RebuildScripts()
 	{
 		auto projectPath = Nebula::Project::GetProjectDirectory();
-		bool success = Nebula::ScriptBuilder::RebuildScripts(projectPath);
+		Nebula::ScriptBuilder::RebuildScriptsAsync(projectPath);
+	}
 
-		if (success)
+	void EditorLayer::PollScriptBuild()
+	{
+		std::vector<Nebula::ScriptBuildMessage> messages;
+		Nebula::ScriptBuildStatus status = Nebula::ScriptBuilder::PollBuild(messages);
+
+		for (const auto& message : messages)
 		{
+			ConsoleWindow::AddLog(message.Message, message.Level);
+		}
+
+		switch (status)
+		{
+		case Nebula::ScriptBuildStatus::Succeeded:
 			m_HasBuildErrors = false;
 			ConsoleWindow::AddLog("Scripts rebuilt successfully!", Nebula::LogLevel::LOG_INFO);
 			NB_CORE_INFO("Scripts rebuilt successfully!");
-		}
-		else
-		{
+			break;
+		case Nebula::ScriptBuildStatus::UpToDate:
+			m_HasBuildErrors = false;
+			ConsoleWindow::AddLog("Scripts are up to date", Nebula::LogLevel::LOG_INFO);
+			break;
+		case Nebula::ScriptBuildStatus::Failed:
 			m_HasBuildErrors = true;
-			std::string errorMsg = Nebula::ScriptBuilder::GetLastBuildError();
 			ConsoleWindow::AddLog("Scripts build failed!", Nebula::LogLevel::LOG_ERROR);
-			if (!errorMsg.empty())
-			{
-				ConsoleWindow::AddLog(errorMsg, Nebula::LogLevel::LOG_ERROR);
-			}
 			NB_CORE_ERROR("Failed to rebuild scripts");
+			break;
+		default:
+			break;
 		}
 	}
 
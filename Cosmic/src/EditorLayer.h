@@ -7,6 +7,7 @@
 #include "Nebula/Renderer/LineRenderer.h"
 #include "Nebula/Scene/Scene.h"
 #include "Nebula/Scene/Entity.h"
+#include "Nebula/Core/FileWatcher.h"
 #include "EditorWindows/SceneListWindow.h"
 #include "EditorWindows/ConsoleWindow.h"
 #include "EditorWindows/DebugWindow.h"
@@ -37,8 +38,10 @@ namespace Cosmic {
 		void LoadScene();
 		void LoadSceneFromPath(const std::string& filepath);
 		void ToggleRuntime();
+		void BuildAssetPack();
 		void RebuildScripts();
-		void CheckScriptFileChanges();
+		void PollScriptBuild();
+		void WatchScriptFiles();
 		
 		void OpenProject(const std::filesystem::path& projectPath);
 		void CreateNewProject(const std::string& name, const std::filesystem::path& path);
@@ -66,7 +69,8 @@ namespace Cosmic {
 	bool m_CursorStateOverridden = false;
 	
 	// Script file watching
-	std::filesystem::file_time_type m_LastScriptModifyTime;
+	Nebula::FileWatchID m_ScriptWatch = 0;
+	bool m_ScriptsDirty = false;
 	std::filesystem::path m_ScriptsDirectory;
 	
 	// Editor Windows
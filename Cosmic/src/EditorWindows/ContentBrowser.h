@@ -2,6 +2,7 @@
 
 #include "Nebula/ImGui/NebulaGui.h"
 #include "Nebula/Asset/AssetManager.h"
+#include "Nebula/Core/FileWatcher.h"
 #include "Nebula/Renderer/Texture.h"
 #include "Nebula/Log.h"
 #include <filesystem>
@@ -34,6 +35,19 @@ namespace Cosmic {
 		{
 			s_BaseDirectory = path;
 			s_CurrentDirectory = s_BaseDirectory;
+			s_EntriesDirty = true;
+
+			// The listing is cached and only re-enumerated when something under the base directory changes
+			Nebula::FileWatcher::Unwatch(s_WatchID);
+			s_WatchID = Nebula::FileWatcher::Watch(s_BaseDirectory, [](const std::vector<Nebula::FileWatchChange>& changes)
+			{
+				for (const auto& change : changes)
+				{
+					if (change.Event != Nebula::FileWatchEvent::Added)
+						s_TextureCache.erase(change.Path.string());
+				}
+				s_EntriesDirty = true;
+			});
 		}
 
 		static void SetSceneLoadCallback(SceneLoadCallback callback)
@@ -66,9 +80,11 @@ namespace Cosmic {
 
 			Nebula::NebulaGui::Columns(columnCount, nullptr, false);
 
-			if (std::filesystem::exists(s_CurrentDirectory))
+			RefreshEntries();
+
+			if (!s_DirectoryEntries.empty())
 			{
-				for (auto& directoryEntry : std::filesystem::directory_iterator(s_CurrentDirectory))
+				for (auto& directoryEntry : s_DirectoryEntries)
 				{
 					const auto& path = directoryEntry.path();
 					auto relativePath = std::filesystem::relative(path, s_BaseDirectory);
@@ -253,6 +269,22 @@ namespace Cosmic {
 		}
 
 	private:
+		static void RefreshEntries()
+		{
+			if (!s_EntriesDirty && s_ListedDirectory == s_CurrentDirectory)
+				return;
+
+			s_DirectoryEntries.clear();
+			s_ListedDirectory = s_CurrentDirectory;
+			s_EntriesDirty = false;
+
+			std::error_code ec;
+			for (auto it = std::filesystem::directory_iterator(s_CurrentDirectory, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+			{
+				s_DirectoryEntries.push_back(*it);
+			}
+		}
+
 		static void CreateNewScript()
 		{
 			// Find a unique filename
@@ -280,6 +312,7 @@ namespace Cosmic {
 				scriptFile << "    -- dt = delta time in seconds\n";
 				scriptFile << "end\n";
 				scriptFile.close();
+				s_EntriesDirty = true;
 				
 				NB_CORE_INFO("Created new script: {0}", scriptPath.string());
 			}
@@ -322,6 +355,7 @@ namespace Cosmic {
 			}
 			else
 			{
+				s_EntriesDirty = true;
 				NB_CORE_INFO("Renamed {0} to {1}", oldRelPath, newRelPath);
 				NB_CORE_INFO("Updated all asset references in scene files");
 			}
@@ -413,6 +447,12 @@ namespace Cosmic {
 		
 		// Cache for texture thumbnails
 		static std::unordered_map<std::string, std::shared_ptr<Nebula::Texture2D>> s_TextureCache;
+
+		// Cached listing of s_CurrentDirectory
+		static std::vector<std::filesystem::directory_entry> s_DirectoryEntries;
+		static std::filesystem::path s_ListedDirectory;
+		static bool s_EntriesDirty;
+		static Nebula::FileWatchID s_WatchID;
 	};
 
 	inline std::filesystem::path ContentBrowser::s_BaseDirectory = "";
@@ -431,4 +471,8 @@ namespace Cosmic {
 	inline std::shared_ptr<Nebula::Texture2D> ContentBrowser::s_ShaderIcon = nullptr;
 	inline std::shared_ptr<Nebula::Texture2D> ContentBrowser::s_MeshIcon = nullptr;
 	inline std::unordered_map<std::string, std::shared_ptr<Nebula::Texture2D>> ContentBrowser::s_TextureCache;
+	inline std::vector<std::filesystem::directory_entry> ContentBrowser::s_DirectoryEntries;
+	inline std::filesystem::path ContentBrowser::s_ListedDirectory = "";
+	inline bool ContentBrowser::s_EntriesDirty = true;
+	inline Nebula::FileWatchID ContentBrowser::s_WatchID = 0;
 }
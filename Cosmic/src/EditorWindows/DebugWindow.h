@@ -4,6 +4,8 @@
 #include "Nebula/Scene/Scene.h"
 #include "Nebula/Scene/Components.h"
 #include "Nebula/Application.h"
+#include "Nebula/Asset/AssetManager.h"
+#include "Nebula/Core/DerivedDataCache.h"
 #include <memory>
 #include <chrono>
 
@@ -120,6 +122,29 @@ namespace Cosmic {
 				Nebula::NebulaGui::Text("  Draw Calls: ~%d", (int)meshView.size() + (int)pointLightView.size());
 				Nebula::NebulaGui::Separator();
 
+				// Asset residency
+				Nebula::AssetResidency total = Nebula::AssetManager::GetTotalResidency();
+				uint64_t budget = Nebula::AssetManager::GetMemoryBudget();
+				Nebula::NebulaGui::Text("Assets");
+				if (budget > 0)
+					Nebula::NebulaGui::Text("  Resident: %d (%.1f / %.1f MB)", (int)total.Count, total.TotalBytes() / (1024.0f * 1024.0f), budget / (1024.0f * 1024.0f));
+				else
+					Nebula::NebulaGui::Text("  Resident: %d (%.1f MB, no budget)", (int)total.Count, total.TotalBytes() / (1024.0f * 1024.0f));
+				for (uint16_t i = (uint16_t)Nebula::AssetType::Texture2D; i <= (uint16_t)Nebula::AssetType::Script; i++)
+				{
+					Nebula::AssetType type = (Nebula::AssetType)i;
+					Nebula::AssetResidency residency = Nebula::AssetManager::GetResidency(type);
+					if (residency.Count == 0)
+						continue;
+					Nebula::NebulaGui::Text("    %s: %d (CPU %.1f MB, GPU %.1f MB)", Nebula::AssetTypeToString(type), (int)residency.Count,
+						residency.CPUBytes / (1024.0f * 1024.0f), residency.GPUBytes / (1024.0f * 1024.0f));
+				}
+				Nebula::NebulaGui::Text("  Evicted: %d  Loading: %d", (int)Nebula::AssetManager::GetEvictionCount(), (int)Nebula::AssetManager::GetPendingAsyncLoadCount());
+				if (Nebula::DerivedDataCache::IsEnabled())
+					Nebula::NebulaGui::Text("  Derived data: %d hits, %d misses", (int)Nebula::DerivedDataCache::GetHitCount(), (int)Nebula::DerivedDataCache::GetMissCount());
+
+				Nebula::NebulaGui::Separator();
+
 				// Runtime mode indicator
 				Nebula::NebulaGui::Text("Runtime Mode: %s", isRuntimeMode ? "ON" : "OFF");
 			}
@@ -15,6 +15,7 @@ namespace Cosmic {
 		using ExitCallback = std::function<void()>;
 		using RunCallback = std::function<void()>;
 		using SceneListCallback = std::function<void()>;
+		using BuildAssetPackCallback = std::function<void()>;
 
 		static void SetCallbacks(
 			NewSceneCallback newSceneCallback,
@@ -32,6 +33,8 @@ namespace Cosmic {
 			s_SceneListCallback = sceneListCallback;
 		}
 
+		static void SetBuildAssetPackCallback(BuildAssetPackCallback callback) { s_BuildAssetPackCallback = callback; }
+
 		static void SetRuntimeMode(bool runtime) { s_RuntimeMode = runtime; }
 
 		static void OnImGuiRender()
@@ -66,6 +69,12 @@ namespace Cosmic {
 							s_RunCallback();
 					}
 
+					if (Nebula::NebulaGui::MenuItem("Build Asset Pack"))
+					{
+						if (s_BuildAssetPackCallback)
+							s_BuildAssetPackCallback();
+					}
+
 					Nebula::NebulaGui::Separator();
 
 					if (Nebula::NebulaGui::MenuItem("Exit"))
@@ -106,6 +115,7 @@ namespace Cosmic {
 		static ExitCallback s_ExitCallback;
 		static RunCallback s_RunCallback;
 		static SceneListCallback s_SceneListCallback;
+		static BuildAssetPackCallback s_BuildAssetPackCallback;
 		static bool s_RuntimeMode;
 	};
 
@@ -115,5 +125,6 @@ inline MenuBar::LoadSceneCallback MenuBar::s_LoadSceneCallback = nullptr;
 inline MenuBar::ExitCallback MenuBar::s_ExitCallback = nullptr;
 inline MenuBar::RunCallback MenuBar::s_RunCallback = nullptr;
 inline MenuBar::SceneListCallback MenuBar::s_SceneListCallback = nullptr;
+inline MenuBar::BuildAssetPackCallback MenuBar::s_BuildAssetPackCallback = nullptr;
 inline bool MenuBar::s_RuntimeMode = false;
 }
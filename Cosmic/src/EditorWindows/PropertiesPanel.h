@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Nebula/Scene/Entity.h"
+#include "Nebula/Scene/Scene.h"
 #include "Nebula/Scene/Components.h"
 #include "Nebula/ImGui/NebulaGui.h"
 #include "Nebula/Renderer/Material.h"
@@ -31,7 +32,7 @@ namespace Cosmic {
 				// Tag Component
 				if (s_SelectedEntity.HasComponent<Nebula::TagComponent>())
 				{
-					DrawTagComponent(s_SelectedEntity.GetComponent<Nebula::TagComponent>());
+					DrawTagComponent(s_SelectedEntity);
 				}
 
 				// Transform Component
@@ -173,8 +174,9 @@ namespace Cosmic {
 
 	private:
 
-		static void DrawTagComponent(Nebula::TagComponent& tag)
+		static void DrawTagComponent(Nebula::Entity entity)
 		{
+			auto& tag = entity.GetComponent<Nebula::TagComponent>();
 			if (Nebula::NebulaGui::CollapsingHeader("Tag", true))
 			{
 				char buffer[256];
@@ -183,7 +185,7 @@ namespace Cosmic {
 				
 				if (Nebula::NebulaGui::InputText("Name", buffer, sizeof(buffer)))
 				{
-					tag.Tag = std::string(buffer);
+					entity.GetScene()->SetEntityTag(entity, std::string(buffer));
 				}
 			}
 		}
@@ -428,33 +430,27 @@ namespace Cosmic {
 								tempInstance = Nebula::CreateRef<Nebula::ScriptInstance>(scriptClass, s_SelectedEntity);
 							}
 							
-							for (const auto& [fieldName, field] : fields)
+							for (int32_t fieldIndex = 0; fieldIndex < (int32_t)fields.size(); fieldIndex++)
 							{
+								const auto& field = fields[fieldIndex];
+								const std::string& fieldName = field.Name;
+
 								// Initialize default values if not already set
-								if (script.FieldValues.find(fieldName) == script.FieldValues.end())
+								if (!script.FieldValues.Contains(fieldName))
 								{
 									auto valueSource = instance ? instance : tempInstance;
 									switch (field.Type)
 									{
 									case Nebula::ScriptFieldType::Float:
-									{
-										float value = valueSource->GetFieldValue<float>(fieldName);
-										script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+										script.FieldValues.Set(fieldName, valueSource->GetFieldValue<float>(fieldIndex));
 										break;
-									}
 									case Nebula::ScriptFieldType::Int:
-									{
-										int value = valueSource->GetFieldValue<int>(fieldName);
-										script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+										script.FieldValues.Set(fieldName, valueSource->GetFieldValue<int>(fieldIndex));
 										break;
-									}
 									case Nebula::ScriptFieldType::Bool:
-									{
-										bool value = valueSource->GetFieldValue<bool>(fieldName);
-										script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+										script.FieldValues.Set(fieldName, valueSource->GetFieldValue<bool>(fieldIndex));
 										break;
 									}
-									}
 								}
 								
 								// Display and edit field values
@@ -464,20 +460,16 @@ namespace Cosmic {
 								{
 									float value = 0.0f;
 									if (instance)
-									{
-										value = instance->GetFieldValue<float>(fieldName);
-									}
-									else if (script.FieldValues.find(fieldName) != script.FieldValues.end())
-									{
-										value = script.FieldValues[fieldName].FloatValue;
-									}
+										value = instance->GetFieldValue<float>(fieldIndex);
+									else
+										script.FieldValues.Get(fieldName, value);
 									
 									if (Nebula::NebulaGui::DragFloat(fieldName.c_str(), &value, 0.1f))
 									{
 										if (instance)
-											instance->SetFieldValue(fieldName, value);
+											instance->SetFieldValue(fieldIndex, value);
 										else
-											script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+											script.FieldValues.Set(fieldName, value);
 									}
 									break;
 								}
@@ -485,20 +477,16 @@ namespace Cosmic {
 								{
 									int value = 0;
 									if (instance)
-									{
-										value = instance->GetFieldValue<int>(fieldName);
-									}
-									else if (script.FieldValues.find(fieldName) != script.FieldValues.end())
-									{
-										value = script.FieldValues[fieldName].IntValue;
-									}
+										value = instance->GetFieldValue<int>(fieldIndex);
+									else
+										script.FieldValues.Get(fieldName, value);
 									
 									if (Nebula::NebulaGui::DragInt(fieldName.c_str(), &value, 1.0f))
 									{
 										if (instance)
-											instance->SetFieldValue(fieldName, value);
+											instance->SetFieldValue(fieldIndex, value);
 										else
-											script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+											script.FieldValues.Set(fieldName, value);
 									}
 									break;
 								}
@@ -506,20 +494,16 @@ namespace Cosmic {
 								{
 									bool value = false;
 									if (instance)
-									{
-										value = instance->GetFieldValue<bool>(fieldName);
-									}
-									else if (script.FieldValues.find(fieldName) != script.FieldValues.end())
-									{
-										value = script.FieldValues[fieldName].BoolValue;
-									}
+										value = instance->GetFieldValue<bool>(fieldIndex);
+									else
+										script.FieldValues.Get(fieldName, value);
 									
 									if (Nebula::NebulaGui::Checkbox(fieldName.c_str(), &value))
 									{
 										if (instance)
-											instance->SetFieldValue(fieldName, value);
+											instance->SetFieldValue(fieldIndex, value);
 										else
-											script.FieldValues[fieldName] = Nebula::ScriptVariable(fieldName, value);
+											script.FieldValues.Set(fieldName, value);
 									}
 									break;
 								}
@@ -770,6 +754,9 @@ namespace Cosmic {
 				// Spatial
 				Nebula::NebulaGui::Checkbox("Spatial (3D)", &audioSource.Spatial);
 
+				// Priority
+				Nebula::NebulaGui::DragInt("Priority", &audioSource.Priority, 1.0f, 0, 256);
+
 				if (audioSource.Spatial)
 				{
 					Nebula::NebulaGui::Text("  Spatial Audio Settings:");
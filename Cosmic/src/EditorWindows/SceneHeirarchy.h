@@ -112,10 +112,7 @@ namespace Cosmic {
                 {
                     // Enter pressed - apply rename
                     if (entity.HasComponent<Nebula::TagComponent>())
-                    {
-                        auto& tag = entity.GetComponent<Nebula::TagComponent>();
-                        tag.Tag = s_RenameBuffer;
-                    }
+                        entity.GetScene()->SetEntityTag(entity, s_RenameBuffer);
                     s_RenamingEntity = {};
                 }
             }
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Nebula/ImGui/NebulaGui.h"
+#include "Nebula/Scripting/ScriptProfiler.h"
+#include "Nebula/Core/FileDialog.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Cosmic {
+
+	class ScriptProfilerWindow
+	{
+	public:
+		static void OnImGuiRender()
+		{
+			Nebula::NebulaGui::Begin("Script Profiler");
+
+			bool enabled = Nebula::ScriptProfiler::IsEnabled();
+			if (Nebula::NebulaGui::Checkbox("Enabled", &enabled))
+				Nebula::ScriptProfiler::SetEnabled(enabled);
+
+			Nebula::NebulaGui::SameLine();
+			Nebula::NebulaGui::Checkbox("Per Entity", &s_PerEntity);
+
+			Nebula::NebulaGui::SameLine();
+			if (Nebula::NebulaGui::Button("Reset"))
+				Nebula::ScriptProfiler::Reset();
+
+			Nebula::NebulaGui::SameLine();
+			if (Nebula::NebulaGui::Button("Export CSV"))
+				ExportCSV();
+
+			int windowSize = (int)Nebula::ScriptProfiler::GetWindowSize();
+			if (Nebula::NebulaGui::DragInt("Window (frames)", &windowSize, 1.0f, 1, 10000))
+				Nebula::ScriptProfiler::SetWindowSize((uint32_t)windowSize);
+
+			uint32_t frames = Nebula::ScriptProfiler::GetFramesRecorded();
+			float frameCount = frames > 0 ? (float)frames : 1.0f;
+			Nebula::NebulaGui::Text("Frames recorded: %u", frames);
+			Nebula::NebulaGui::Separator();
+
+			std::vector<Nebula::ScriptProfileEntry> entries = s_PerEntity
+				? Nebula::ScriptProfiler::GetEntityStats()
+				: Nebula::ScriptProfiler::GetClassStats();
+			SortEntries(entries);
+
+			// Header row, click a column to sort by it (again to flip the direction)
+			Nebula::NebulaGui::Columns(ColumnCount, "ScriptProfilerColumns", true);
+			for (int i = 0; i < ColumnCount; i++)
+			{
+				std::string label = s_ColumnNames[i];
+				if (i == 1 && s_PerEntity)
+					label = "Entity";
+				if (i == s_SortColumn)
+					label += s_SortDescending ? " v" : " ^";
+
+				if (Nebula::NebulaGui::Selectable(label.c_str(), i == s_SortColumn))
+				{
+					if (s_SortColumn == i)
+						s_SortDescending = !s_SortDescending;
+					else
+					{
+						s_SortColumn = i;
+						s_SortDescending = true;
+					}
+				}
+				Nebula::NebulaGui::NextColumn();
+			}
+			Nebula::NebulaGui::Separator();
+
+			for (const auto& entry : entries)
+			{
+				const auto& update = entry.Callbacks[(int)Nebula::ScriptCallback::OnUpdate];
+				const auto& create = entry.Callbacks[(int)Nebula::ScriptCallback::OnCreate];
+				const auto& destroy = entry.Callbacks[(int)Nebula::ScriptCallback::OnDestroy];
+				int64_t allocated = update.AllocatedBytes + create.AllocatedBytes + destroy.AllocatedBytes;
+
+				Nebula::NebulaGui::Text("%s", entry.ClassName.c_str()); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%u", s_PerEntity ? entry.EntityID : entry.InstanceCount); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.3f", update.TotalTimeMs / frameCount); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.3f", update.MaxTimeMs); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.1f", (double)update.Calls / frameCount); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.0f", (double)allocated / frameCount); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.3f", create.TotalTimeMs); Nebula::NebulaGui::NextColumn();
+				Nebula::NebulaGui::Text("%.3f", destroy.TotalTimeMs); Nebula::NebulaGui::NextColumn();
+			}
+
+			Nebula::NebulaGui::Columns(1);
+
+			if (entries.empty())
+			{
+				Nebula::NebulaGui::TextColored({ 0.7f, 0.7f, 0.7f, 1.0f },
+					enabled ? "No script callbacks recorded yet. Enter play mode to collect data." : "Profiler is disabled.");
+			}
+
+			Nebula::NebulaGui::End();
+		}
+
+	private:
+		static constexpr int ColumnCount = 8;
+
+		static double SortKey(const Nebula::ScriptProfileEntry& entry, int column)
+		{
+			const auto& update = entry.Callbacks[(int)Nebula::ScriptCallback::OnUpdate];
+			switch (column)
+			{
+			case 1: return s_PerEntity ? (double)entry.EntityID : (double)entry.InstanceCount;
+			case 2: return update.TotalTimeMs;
+			case 3: return update.MaxTimeMs;
+			case 4: return (double)update.Calls;
+			case 5:
+			{
+				double allocated = 0.0;
+				for (const auto& callback : entry.Callbacks)
+					allocated += (double)callback.AllocatedBytes;
+				return allocated;
+			}
+			case 6: return entry.Callbacks[(int)Nebula::ScriptCallback::OnCreate].TotalTimeMs;
+			case 7: return entry.Callbacks[(int)Nebula::ScriptCallback::OnDestroy].TotalTimeMs;
+			default: return 0.0;
+			}
+		}
+
+		static void SortEntries(std::vector<Nebula::ScriptProfileEntry>& entries)
+		{
+			std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b)
+			{
+				if (s_SortColumn == 0)
+					return s_SortDescending ? a.ClassName > b.ClassName : a.ClassName < b.ClassName;
+
+				double keyA = SortKey(a, s_SortColumn);
+				double keyB = SortKey(b, s_SortColumn);
+				return s_SortDescending ? keyA > keyB : keyA < keyB;
+			});
+		}
+
+		static void ExportCSV()
+		{
+			Nebula::FileDialog* dialog = Nebula::FileDialog::Create();
+			auto result = dialog->SaveFile("CSV File\0*.csv\0All Files\0*.*\0", "csv");
+			delete dialog;
+
+			if (result.has_value())
+				Nebula::ScriptProfiler::ExportCSV(result.value());
+		}
+
+		inline static bool s_PerEntity = false;
+		inline static int s_SortColumn = 2;
+		inline static bool s_SortDescending = true;
+		inline static const char* s_ColumnNames[ColumnCount] = {
+			"Class", "Instances", "Update ms/frame", "Update max ms", "Calls/frame", "Alloc B/frame", "Create ms", "Destroy ms"
+		};
+	};
+
+}
@@ -6,6 +6,10 @@
 #pragma once
 
 #include "Nebula/Core/FileDialog.h"
+#include "Nebula/Core/FileWatcher.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Core/AssetPack.h"
+#include "Nebula/Core/DerivedDataCache.h"
 #include "Nebula/Application.h"
 #include "Nebula/Input.h"
 #include "Nebula/MouseButtonCodes.h"
@@ -52,6 +56,7 @@
 
 // Scripting System
 #include "Nebula/Scripting/ScriptEngine.h"
+#include "Nebula/Scripting/ScriptProfiler.h"
 
 // Project System
 #include "Nebula/Project/Project.h"
@@ -8,6 +8,9 @@
 #include "Nebula/Asset/AssetManager.h"
 #include "Nebula/Asset/AssetManagerRegistry.h"
 #include "Nebula/Scripting/ScriptEngine.h"
+#include "Nebula/Core/FileWatcher.h"
+#include "Nebula/Core/JobSystem.h"
+#include "Nebula/Core/DerivedDataCache.h"
 
 #include <GLFW/glfw3.h>
 
@@ -42,6 +45,8 @@ namespace Nebula {
 
 		AssetManager::Init();
 		AssetManagerRegistry::RegisterImporters();
+		FileWatcher::Init();
+		JobSystem::Init();
 
 	ScriptEngine::Init();
 
@@ -52,6 +57,9 @@ namespace Nebula {
 Application::~Application()
 {
 	ScriptEngine::Shutdown();
+	FileWatcher::Shutdown();
+	JobSystem::Shutdown();
+	DerivedDataCache::Shutdown();
 }
 
 void Application::OnEvent(Event& e)
@@ -91,6 +99,11 @@ void Application::PushOverlay(Layer* overlay)
 			m_Time += m_DeltaTime;
 			m_FrameCount++;
 
+			// Hand file change notifications to subscribers before anything else runs this frame
+			FileWatcher::Update();
+			// Finish async asset loads (GPU uploads) within this frame's budget
+			AssetManager::Update();
+
 			RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
 			RenderCommand::Clear();
 
@@ -48,6 +48,14 @@ namespace Nebula {
 			: Handle(handle), Type(type), FilePath(path) {}
 	};
 
+	struct NEBULA_API AssetMemoryUsage
+	{
+		uint64_t CPUBytes = 0;
+		uint64_t GPUBytes = 0;
+
+		uint64_t Total() const { return CPUBytes + GPUBytes; }
+	};
+
 	// Base class for all engine assets
 	class NEBULA_API Asset
 	{
@@ -61,6 +69,9 @@ namespace Nebula {
 		bool IsValid() const { return m_Handle.IsValid(); }
 		bool IsLoaded() const { return m_IsLoaded; }
 
+		// What keeping this asset resident costs, counted against AssetManager's memory budget
+		virtual AssetMemoryUsage GetMemoryUsage() const { return {}; }
+
 		static AssetType GetStaticType() { return AssetType::None; }
 
 	protected:
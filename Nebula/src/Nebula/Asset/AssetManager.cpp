@@ -1,14 +1,169 @@
 #include "nbpch.h"
 #include "AssetManager.h"
 #include "Nebula/Log.h"
+#include "Nebula/Renderer/Shader.h"
+#include "Nebula/Core/JobSystem.h"
+#include "Nebula/Core/AssetPack.h"
 #include <random>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <deque>
 
 namespace Nebula {
 
+	struct AssetLoadRequest
+	{
+		std::string FilePath;
+		AssetMetadata Metadata;
+		std::shared_ptr<AssetImporter> Importer;
+		AssetLoadPriority Priority = AssetLoadPriority::Normal; // Guarded by the queue mutex
+		uint64_t Sequence = 0;
+		bool NewHandle = false; // The registry entry was added for this load
+
+		std::atomic<AssetLoadState> State{ AssetLoadState::Queued };
+		std::unique_ptr<AssetImportData> Data;
+
+		// Written once, before State becomes Ready or Failed
+		std::shared_ptr<Asset> Result;
+		// Guarded by the queue mutex
+		std::vector<AssetLoadHandle::Callback> Callbacks;
+	};
+
+	struct AsyncAssetLoadQueue
+	{
+		std::mutex Mutex;
+		std::condition_variable Changed; // A request was decoded or finished
+		std::vector<std::shared_ptr<AssetLoadRequest>> Queued;   // Waiting for a worker
+		std::vector<std::shared_ptr<AssetLoadRequest>> Decoded;  // Waiting for the main thread
+		bool Cancelled = false;
+	};
+
+	// Highest priority first, then oldest. A linear scan, the queues stay short.
+	static std::shared_ptr<AssetLoadRequest> PopNextRequest(std::vector<std::shared_ptr<AssetLoadRequest>>& requests)
+	{
+		if (requests.empty())
+			return nullptr;
+
+		size_t best = 0;
+		for (size_t i = 1; i < requests.size(); i++)
+		{
+			const AssetLoadRequest& a = *requests[i];
+			const AssetLoadRequest& b = *requests[best];
+			if (a.Priority > b.Priority || (a.Priority == b.Priority && a.Sequence < b.Sequence))
+				best = i;
+		}
+
+		std::shared_ptr<AssetLoadRequest> request = std::move(requests[best]);
+		requests.erase(requests.begin() + best);
+		return request;
+	}
+
+	static bool RemoveRequest(std::vector<std::shared_ptr<AssetLoadRequest>>& requests, const std::shared_ptr<AssetLoadRequest>& request)
+	{
+		auto it = std::find(requests.begin(), requests.end(), request);
+		if (it == requests.end())
+			return false;
+		requests.erase(it);
+		return true;
+	}
+
+	static bool IsFinished(AssetLoadState state)
+	{
+		return state == AssetLoadState::Ready || state == AssetLoadState::Failed;
+	}
+
+	AssetLoadState AssetLoadHandle::GetState() const
+	{
+		return m_Request ? m_Request->State.load() : AssetLoadState::Failed;
+	}
+
+	bool AssetLoadHandle::IsDone() const
+	{
+		return IsFinished(GetState());
+	}
+
+	AssetHandle AssetLoadHandle::GetHandle() const
+	{
+		return m_Request ? m_Request->Metadata.Handle : AssetHandle(0);
+	}
+
+	std::shared_ptr<Asset> AssetLoadHandle::GetAsset() const
+	{
+		return m_Request && IsDone() ? m_Request->Result : nullptr;
+	}
+
+	void AssetLoadHandle::OnComplete(Callback callback) const
+	{
+		if (!m_Request || !callback)
+			return;
+
+		if (AssetManager::s_Instance)
+		{
+			std::lock_guard<std::mutex> lock(AssetManager::s_Instance->m_AsyncQueue->Mutex);
+			if (!IsDone())
+			{
+				m_Request->Callbacks.push_back(std::move(callback));
+				return;
+			}
+		}
+		callback(GetAsset());
+	}
+
+	std::shared_ptr<Asset> AssetLoadHandle::Wait() const
+	{
+		if (!m_Request || IsDone() || !AssetManager::s_Instance)
+			return GetAsset();
+
+		std::shared_ptr<AsyncAssetLoadQueue> queue = AssetManager::s_Instance->m_AsyncQueue;
+		bool mainThread = std::this_thread::get_id() == AssetManager::s_Instance->m_MainThread;
+
+		bool decodeHere = false;
+		{
+			std::unique_lock<std::mutex> lock(queue->Mutex);
+			if (RemoveRequest(queue->Queued, m_Request))
+			{
+				// Its job will take the next request, or find the queue empty
+				m_Request->State = AssetLoadState::Loading;
+				decodeHere = true;
+			}
+			else if (mainThread)
+			{
+				queue->Changed.wait(lock, [&]() { return queue->Cancelled || RemoveRequest(queue->Decoded, m_Request); });
+				if (queue->Cancelled)
+					return nullptr;
+			}
+		}
+
+		if (decodeHere)
+			m_Request->Data = m_Request->Importer->LoadAssetData(m_Request->Metadata);
+
+		if (mainThread)
+		{
+			AssetManager::FinishAsyncLoad(m_Request);
+			return GetAsset();
+		}
+
+		// Only the main thread may finish loads (GPU uploads), wait for its Update()
+		std::unique_lock<std::mutex> lock(queue->Mutex);
+		if (decodeHere && !queue->Cancelled)
+		{
+			queue->Decoded.push_back(m_Request);
+			queue->Changed.notify_all();
+		}
+		queue->Changed.wait(lock, [&]() { return queue->Cancelled || IsDone(); });
+		return GetAsset();
+	}
+
 	AssetManager* AssetManager::s_Instance = nullptr;
 
+	AssetManager::AssetManager()
+		: m_MainThread(std::this_thread::get_id()), m_AsyncQueue(std::make_shared<AsyncAssetLoadQueue>())
+	{
+	}
+
 	void AssetManager::Init()
 	{
 		if (!s_Instance)
@@ -22,13 +177,30 @@ namespace Nebula {
 	{
 		if (s_Instance)
 		{
+			DisableHotReload();
+
+			// Workers still decoding drop their result into the orphaned queue, waiters give up
+			{
+				std::lock_guard<std::mutex> lock(s_Instance->m_AsyncQueue->Mutex);
+				s_Instance->m_AsyncQueue->Cancelled = true;
+				s_Instance->m_AsyncQueue->Queued.clear();
+				s_Instance->m_AsyncQueue->Decoded.clear();
+			}
+			s_Instance->m_AsyncQueue->Changed.notify_all();
+			s_Instance->m_AsyncLoads.clear();
+
 			s_Instance->m_LoadedAssets.clear();
+			s_Instance->m_Residency.clear();
 			s_Instance->m_AssetRegistry.clear();
+			s_Instance->m_PathToHandle.clear();
 			s_Instance->m_Importers.clear();
-			
+			s_Instance->m_DependencyGraph.clear();
+			s_Instance->m_DependencyScanners.clear();
+			s_Instance->m_DependencyChangedCallback = nullptr;
+
 			delete s_Instance;
 			s_Instance = nullptr;
-			
+
 			NB_CORE_INFO("AssetManager shutdown");
 		}
 	}
@@ -41,20 +213,29 @@ namespace Nebula {
 			return nullptr;
 		}
 
-		// Check if already loaded
-		auto it = s_Instance->m_LoadedAssets.find(handle);
-		if (it != s_Instance->m_LoadedAssets.end())
-			return it->second;
-
-		// Asset not loaded, try to load it
-		auto metaIt = s_Instance->m_AssetRegistry.find(handle);
-		if (metaIt == s_Instance->m_AssetRegistry.end())
+		std::string filepath;
 		{
-			NB_CORE_ERROR("Asset handle {0} not found in registry", handle.Value);
-			return nullptr;
+			std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+
+			// Check if already loaded
+			auto it = s_Instance->m_LoadedAssets.find(handle);
+			if (it != s_Instance->m_LoadedAssets.end())
+			{
+				TouchAsset(handle);
+				return it->second;
+			}
+
+			// Asset not loaded (or evicted), try to load it
+			auto metaIt = s_Instance->m_AssetRegistry.find(handle);
+			if (metaIt == s_Instance->m_AssetRegistry.end())
+			{
+				NB_CORE_ERROR("Asset handle {0} not found in registry", handle.Value);
+				return nullptr;
+			}
+			filepath = metaIt->second.FilePath;
 		}
 
-		return LoadAssetFromPath(metaIt->second.FilePath);
+		return LoadAssetFromPath(filepath);
 	}
 
 	std::shared_ptr<Asset> AssetManager::LoadAssetFromPath(const std::string& filepath)
@@ -66,56 +247,418 @@ namespace Nebula {
 		}
 
 		// Check if already loaded by filepath
-		AssetHandle existingHandle = GetAssetHandleFromPath(filepath);
-		if (existingHandle.IsValid())
 		{
+			std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			AssetHandle existingHandle = FindHandle(filepath);
 			auto it = s_Instance->m_LoadedAssets.find(existingHandle);
 			if (it != s_Instance->m_LoadedAssets.end())
+			{
+				TouchAsset(existingHandle);
 				return it->second;
+			}
 		}
 
-		// Get asset type from extension
-		std::filesystem::path path(filepath);
-		std::string extension = path.extension().string();
-		AssetType type = GetAssetTypeFromExtension(extension);
+		// Same path as async loads, so concurrent requests for one asset share a single import
+		return LoadAssetAsync(filepath, AssetLoadPriority::High).Wait();
+	}
 
-		if (type == AssetType::None)
+	AssetLoadHandle AssetManager::LoadAssetAsync(const std::string& filepath, AssetLoadPriority priority)
+	{
+		if (!s_Instance)
 		{
-			NB_CORE_WARN("Unknown asset type for file: {0}", filepath);
-			return nullptr;
+			NB_CORE_ERROR("AssetManager not initialized!");
+			return AssetLoadHandle();
 		}
 
-		// Find appropriate importer
-		auto importerIt = s_Instance->m_Importers.find(type);
-		if (importerIt == s_Instance->m_Importers.end())
+		auto request = std::make_shared<AssetLoadRequest>();
+		request->FilePath = filepath;
+		request->Priority = priority;
+
+		std::shared_ptr<AsyncAssetLoadQueue> queue = s_Instance->m_AsyncQueue;
 		{
-			NB_CORE_ERROR("No importer registered for asset type: {0}", AssetTypeToString(type));
-			return nullptr;
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+
+			AssetHandle existingHandle = FindHandle(filepath);
+			auto loadedIt = s_Instance->m_LoadedAssets.find(existingHandle);
+			if (loadedIt != s_Instance->m_LoadedAssets.end())
+			{
+				TouchAsset(existingHandle);
+				request->Metadata = s_Instance->m_AssetRegistry[existingHandle];
+				request->Result = loadedIt->second;
+				request->State = AssetLoadState::Ready;
+				return AssetLoadHandle(request);
+			}
+
+			// Spelled differently, the same file is still one load
+			std::string key = NormalizeAssetPath(filepath);
+			auto inFlight = s_Instance->m_AsyncLoads.find(key);
+			if (inFlight != s_Instance->m_AsyncLoads.end())
+			{
+				std::lock_guard<std::mutex> queueLock(queue->Mutex);
+				if (priority > inFlight->second->Priority)
+					inFlight->second->Priority = priority;
+				return AssetLoadHandle(inFlight->second);
+			}
+
+			AssetType type = GetAssetTypeFromExtension(std::filesystem::path(filepath).extension().string());
+			if (type == AssetType::None)
+			{
+				NB_CORE_WARN("Unknown asset type for file: {0}", filepath);
+				request->State = AssetLoadState::Failed;
+				return AssetLoadHandle(request);
+			}
+
+			auto importerIt = s_Instance->m_Importers.find(type);
+			if (importerIt == s_Instance->m_Importers.end())
+			{
+				NB_CORE_ERROR("No importer registered for asset type: {0}", AssetTypeToString(type));
+				request->State = AssetLoadState::Failed;
+				return AssetLoadHandle(request);
+			}
+
+			// Registered but not loaded, so WaitForAssetLoaded in scripts waits on it
+			AssetHandle handle = existingHandle.IsValid() ? existingHandle : GenerateAssetHandle();
+			request->Metadata = AssetMetadata(handle, type, filepath);
+			request->Importer = importerIt->second;
+			request->Sequence = s_Instance->m_AsyncSequence++;
+			if (!existingHandle.IsValid())
+			{
+				SetMetadata(request->Metadata);
+				request->NewHandle = true;
+			}
+
+			s_Instance->m_AsyncLoads[key] = request;
+
+			std::lock_guard<std::mutex> queueLock(queue->Mutex);
+			queue->Queued.push_back(request);
 		}
 
-		// Generate or retrieve asset handle
-		AssetHandle handle = existingHandle.IsValid() ? existingHandle : GenerateAssetHandle();
+		// Each job decodes whichever queued request is most urgent when it runs, not necessarily this one
+		JobSystem::Submit([queue]()
+		{
+			std::shared_ptr<AssetLoadRequest> next;
+			{
+				std::lock_guard<std::mutex> lock(queue->Mutex);
+				if (queue->Cancelled)
+					return;
+				next = PopNextRequest(queue->Queued);
+				if (!next)
+					return;
+				next->State = AssetLoadState::Loading;
+			}
+
+			next->Data = next->Importer->LoadAssetData(next->Metadata);
 
-		// Create metadata
-		AssetMetadata metadata(handle, type, filepath);
-		
-		// Import the asset
-		std::shared_ptr<Asset> asset = importerIt->second->ImportAsset(handle, metadata);
-		
-		if (asset)
+			{
+				std::lock_guard<std::mutex> lock(queue->Mutex);
+				if (queue->Cancelled)
+					return;
+				queue->Decoded.push_back(next);
+			}
+			queue->Changed.notify_all();
+		});
+
+		return AssetLoadHandle(request);
+	}
+
+	void AssetManager::FinishAsyncLoad(const std::shared_ptr<AssetLoadRequest>& request)
+	{
+		const AssetMetadata& metadata = request->Metadata;
+
+		// Loaded some other way while this one was decoding, keep that one
+		std::shared_ptr<Asset> asset;
 		{
-			metadata.IsLoaded = true;
-			s_Instance->m_AssetRegistry[handle] = metadata;
-			s_Instance->m_LoadedAssets[handle] = asset;
-			
-			NB_CORE_INFO("Loaded asset: {0} (Handle: {1})", filepath, handle.Value);
+			std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			auto loadedIt = s_Instance->m_LoadedAssets.find(metadata.Handle);
+			if (loadedIt != s_Instance->m_LoadedAssets.end())
+				asset = loadedIt->second;
 		}
+
+		// No locks held, importers may load other assets
+		if (!asset)
+			asset = request->Importer->FinalizeAsset(metadata.Handle, metadata, std::move(request->Data));
+		request->Data.reset();
+
+		std::shared_ptr<Asset> replaced;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			auto inFlight = s_Instance->m_AsyncLoads.find(NormalizeAssetPath(request->FilePath));
+			if (inFlight != s_Instance->m_AsyncLoads.end() && inFlight->second == request)
+				s_Instance->m_AsyncLoads.erase(inFlight);
+
+			if (asset)
+			{
+				AssetMetadata loadedMetadata = metadata;
+				loadedMetadata.IsLoaded = true;
+				SetMetadata(loadedMetadata);
+				auto loadedIt = s_Instance->m_LoadedAssets.find(metadata.Handle);
+				if (loadedIt == s_Instance->m_LoadedAssets.end() || loadedIt->second != asset)
+					replaced = SetLoadedAsset(metadata.Handle, asset);
+			}
+			else if (request->NewHandle)
+			{
+				RemoveMetadata(metadata.Handle);
+			}
+		}
+
+		if (asset)
+			NB_CORE_INFO("Loaded asset: {0} (Handle: {1})", request->FilePath, metadata.Handle.Value);
 		else
+			NB_CORE_ERROR("Failed to import asset: {0}", request->FilePath);
+
+		std::vector<AssetLoadHandle::Callback> callbacks;
+		{
+			std::lock_guard<std::mutex> lock(s_Instance->m_AsyncQueue->Mutex);
+			request->Result = asset;
+			request->State = asset ? AssetLoadState::Ready : AssetLoadState::Failed;
+			callbacks = std::move(request->Callbacks);
+		}
+		s_Instance->m_AsyncQueue->Changed.notify_all();
+
+		for (auto& callback : callbacks)
+			callback(asset);
+	}
+
+	void AssetManager::Update()
+	{
+		if (!s_Instance)
+			return;
+
+		// Before this frame's uploads, so nothing is evicted the frame it arrives
+		uint64_t budget = GetMemoryBudget();
+		if (budget > 0 && GetTotalResidency().TotalBytes() > budget)
+			EvictUnusedAssets(budget);
+
+		auto start = std::chrono::steady_clock::now();
+		std::shared_ptr<AsyncAssetLoadQueue> queue = s_Instance->m_AsyncQueue;
+		while (true)
+		{
+			std::shared_ptr<AssetLoadRequest> request;
+			{
+				std::lock_guard<std::mutex> lock(queue->Mutex);
+				request = PopNextRequest(queue->Decoded);
+			}
+			if (!request)
+				break;
+
+			FinishAsyncLoad(request);
+
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (elapsed >= GetAsyncUploadBudget())
+				break;
+		}
+	}
+
+	void AssetManager::SetAsyncUploadBudget(float milliseconds)
+	{
+		if (!s_Instance)
+			return;
+
+		std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		s_Instance->m_AsyncUploadBudget = milliseconds;
+	}
+
+	float AssetManager::GetAsyncUploadBudget()
+	{
+		if (!s_Instance)
+			return 0.0f;
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return s_Instance->m_AsyncUploadBudget;
+	}
+
+	uint32_t AssetManager::GetPendingAsyncLoadCount()
+	{
+		if (!s_Instance)
+			return 0;
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return (uint32_t)s_Instance->m_AsyncLoads.size();
+	}
+
+	void AssetManager::WaitForAsyncLoads()
+	{
+		while (s_Instance)
+		{
+			std::shared_ptr<AssetLoadRequest> request;
+			{
+				std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+				if (s_Instance->m_AsyncLoads.empty())
+					return;
+				request = s_Instance->m_AsyncLoads.begin()->second;
+			}
+			AssetLoadHandle(request).Wait();
+		}
+	}
+
+	void AssetManager::SetMetadata(const AssetMetadata& metadata)
+	{
+		auto it = s_Instance->m_AssetRegistry.find(metadata.Handle);
+		if (it != s_Instance->m_AssetRegistry.end() && it->second.FilePath != metadata.FilePath)
+			s_Instance->m_PathToHandle.erase(NormalizeAssetPath(it->second.FilePath));
+
+		s_Instance->m_AssetRegistry[metadata.Handle] = metadata;
+		if (!metadata.FilePath.empty())
+			s_Instance->m_PathToHandle[NormalizeAssetPath(metadata.FilePath)] = metadata.Handle;
+	}
+
+	void AssetManager::RemoveMetadata(AssetHandle handle)
+	{
+		auto it = s_Instance->m_AssetRegistry.find(handle);
+		if (it == s_Instance->m_AssetRegistry.end())
+			return;
+
+		auto pathIt = s_Instance->m_PathToHandle.find(NormalizeAssetPath(it->second.FilePath));
+		if (pathIt != s_Instance->m_PathToHandle.end() && pathIt->second == handle)
+			s_Instance->m_PathToHandle.erase(pathIt);
+		s_Instance->m_AssetRegistry.erase(it);
+	}
+
+	AssetHandle AssetManager::FindHandle(const std::string& filepath)
+	{
+		auto it = s_Instance->m_PathToHandle.find(NormalizeAssetPath(filepath));
+		return it != s_Instance->m_PathToHandle.end() ? it->second : AssetHandle(0);
+	}
+
+	std::shared_ptr<Asset> AssetManager::SetLoadedAsset(AssetHandle handle, const std::shared_ptr<Asset>& asset)
+	{
+		std::shared_ptr<Asset> previous = RemoveLoadedAsset(handle);
+		if (!asset)
+			return previous;
+		s_Instance->m_LoadedAssets[handle] = asset;
+
+		ResidentAsset& resident = s_Instance->m_Residency[handle];
+		resident.Type = asset->GetType();
+		resident.Memory = asset->GetMemoryUsage();
+		resident.LastUsed = ++s_Instance->m_UseCounter;
+
+		for (AssetResidency* residency : { &s_Instance->m_TypeResidency[resident.Type], &s_Instance->m_TotalResidency })
 		{
-			NB_CORE_ERROR("Failed to import asset: {0}", filepath);
+			residency->Count++;
+			residency->CPUBytes += resident.Memory.CPUBytes;
+			residency->GPUBytes += resident.Memory.GPUBytes;
 		}
+		return previous;
+	}
 
-		return asset;
+	std::shared_ptr<Asset> AssetManager::RemoveLoadedAsset(AssetHandle handle)
+	{
+		std::shared_ptr<Asset> removed;
+		auto loadedIt = s_Instance->m_LoadedAssets.find(handle);
+		if (loadedIt == s_Instance->m_LoadedAssets.end())
+			return removed;
+		removed = std::move(loadedIt->second);
+		s_Instance->m_LoadedAssets.erase(loadedIt);
+
+		auto it = s_Instance->m_Residency.find(handle);
+		if (it == s_Instance->m_Residency.end())
+			return removed;
+
+		const ResidentAsset& resident = it->second;
+		for (AssetResidency* residency : { &s_Instance->m_TypeResidency[resident.Type], &s_Instance->m_TotalResidency })
+		{
+			residency->Count--;
+			residency->CPUBytes -= resident.Memory.CPUBytes;
+			residency->GPUBytes -= resident.Memory.GPUBytes;
+		}
+		s_Instance->m_Residency.erase(it);
+		return removed;
+	}
+
+	void AssetManager::TouchAsset(AssetHandle handle)
+	{
+		auto it = s_Instance->m_Residency.find(handle);
+		if (it != s_Instance->m_Residency.end())
+			it->second.LastUsed.store(s_Instance->m_UseCounter.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	uint32_t AssetManager::EvictUnusedAssets(uint64_t targetBytes)
+	{
+		if (!s_Instance)
+			return 0;
+
+		// Destroyed once the lock is released
+		std::vector<std::shared_ptr<Asset>> evicted;
+		uint64_t residentBytes = 0;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			if (s_Instance->m_TotalResidency.TotalBytes() <= targetBytes)
+				return 0;
+
+			// Only copies handed out under the lock add references, so the count can't grow while it's held.
+			// Skipped: still used somewhere, can't be reloaded, or frees nothing.
+			std::vector<std::pair<uint64_t, AssetHandle>> candidates;
+			for (auto& [handle, resident] : s_Instance->m_Residency)
+			{
+				auto metaIt = s_Instance->m_AssetRegistry.find(handle);
+				if (s_Instance->m_LoadedAssets[handle].use_count() > 1 || resident.Memory.Total() == 0 ||
+					metaIt == s_Instance->m_AssetRegistry.end() || metaIt->second.IsMemoryAsset)
+					continue;
+				candidates.push_back({ resident.LastUsed.load(std::memory_order_relaxed), handle });
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			for (const auto& [lastUsed, handle] : candidates)
+			{
+				if (s_Instance->m_TotalResidency.TotalBytes() <= targetBytes)
+					break;
+
+				evicted.push_back(RemoveLoadedAsset(handle));
+				s_Instance->m_AssetRegistry[handle].IsLoaded = false;
+				s_Instance->m_EvictionCount++;
+			}
+			residentBytes = s_Instance->m_TotalResidency.TotalBytes();
+		}
+
+		if (!evicted.empty())
+			NB_CORE_INFO("Evicted {0} unused assets, {1} KB resident", evicted.size(), residentBytes / 1024);
+		return (uint32_t)evicted.size();
+	}
+
+	void AssetManager::SetMemoryBudget(uint64_t bytes)
+	{
+		if (!s_Instance)
+			return;
+
+		std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		s_Instance->m_MemoryBudget = bytes;
+	}
+
+	uint64_t AssetManager::GetMemoryBudget()
+	{
+		if (!s_Instance)
+			return 0;
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return s_Instance->m_MemoryBudget;
+	}
+
+	AssetResidency AssetManager::GetResidency(AssetType type)
+	{
+		if (!s_Instance)
+			return AssetResidency();
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		auto it = s_Instance->m_TypeResidency.find(type);
+		return it != s_Instance->m_TypeResidency.end() ? it->second : AssetResidency();
+	}
+
+	AssetResidency AssetManager::GetTotalResidency()
+	{
+		if (!s_Instance)
+			return AssetResidency();
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return s_Instance->m_TotalResidency;
+	}
+
+	uint64_t AssetManager::GetEvictionCount()
+	{
+		if (!s_Instance)
+			return 0;
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return s_Instance->m_EvictionCount;
 	}
 
 	AssetHandle AssetManager::ImportAsset(const std::string& filepath)
@@ -126,11 +669,6 @@ namespace Nebula {
 			return AssetHandle(0);
 		}
 
-		// Check if already registered
-		AssetHandle existingHandle = GetAssetHandleFromPath(filepath);
-		if (existingHandle.IsValid())
-			return existingHandle;
-
 		// Create new asset entry
 		std::filesystem::path path(filepath);
 		std::string extension = path.extension().string();
@@ -142,13 +680,21 @@ namespace Nebula {
 			return AssetHandle(0);
 		}
 
-		AssetHandle handle = GenerateAssetHandle();
-		AssetMetadata metadata(handle, type, filepath);
-		
-		s_Instance->m_AssetRegistry[handle] = metadata;
-		
+		AssetHandle handle;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+
+			// Check if already registered
+			AssetHandle existingHandle = FindHandle(filepath);
+			if (existingHandle.IsValid())
+				return existingHandle;
+
+			handle = GenerateAssetHandle();
+			SetMetadata(AssetMetadata(handle, type, filepath));
+		}
+
 		NB_CORE_INFO("Imported asset: {0} (Handle: {1})", filepath, handle.Value);
-		
+
 		return handle;
 	}
 
@@ -160,40 +706,164 @@ namespace Nebula {
 			return;
 		}
 
-		s_Instance->m_AssetRegistry[metadata.Handle] = metadata;
-		s_Instance->m_LoadedAssets[metadata.Handle] = asset;
+		std::shared_ptr<Asset> replaced;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			SetMetadata(metadata);
+			replaced = SetLoadedAsset(metadata.Handle, asset);
+		}
 	}
 
 	void AssetManager::UnloadAsset(AssetHandle handle)
 	{
 		if (!s_Instance) return;
 
-		auto it = s_Instance->m_LoadedAssets.find(handle);
-		if (it != s_Instance->m_LoadedAssets.end())
+		std::shared_ptr<Asset> removed;
 		{
-			s_Instance->m_LoadedAssets.erase(it);
-			
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			removed = RemoveLoadedAsset(handle);
+			if (!removed)
+				return;
+
 			// Update metadata
 			auto metaIt = s_Instance->m_AssetRegistry.find(handle);
 			if (metaIt != s_Instance->m_AssetRegistry.end())
 				metaIt->second.IsLoaded = false;
-			
-			NB_CORE_INFO("Unloaded asset with handle: {0}", handle.Value);
 		}
+
+		NB_CORE_INFO("Unloaded asset with handle: {0}", handle.Value);
+	}
+
+	bool AssetManager::ReloadAsset(AssetHandle handle)
+	{
+		if (!s_Instance)
+			return false;
+
+		AssetMetadata metadata;
+		std::shared_ptr<AssetImporter> importer;
+		{
+			std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			auto metaIt = s_Instance->m_AssetRegistry.find(handle);
+			if (metaIt == s_Instance->m_AssetRegistry.end() || metaIt->second.IsMemoryAsset)
+				return false;
+
+			auto importerIt = s_Instance->m_Importers.find(metaIt->second.Type);
+			if (importerIt == s_Instance->m_Importers.end())
+				return false;
+
+			metadata = metaIt->second;
+			importer = importerIt->second;
+		}
+
+		std::shared_ptr<Asset> asset = importer->ImportAsset(handle, metadata);
+		if (!asset)
+		{
+			NB_CORE_ERROR("Failed to reload asset: {0}", metadata.FilePath);
+			return false;
+		}
+
+		std::shared_ptr<Asset> replaced;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			replaced = SetLoadedAsset(handle, asset);
+			s_Instance->m_AssetRegistry[handle].IsLoaded = true;
+		}
+		NB_CORE_INFO("Reloaded asset: {0}", metadata.FilePath);
+		return true;
+	}
+
+	void AssetManager::EnableHotReload(const std::filesystem::path& directory)
+	{
+		if (!s_Instance)
+		{
+			NB_CORE_ERROR("AssetManager not initialized!");
+			return;
+		}
+
+		FileWatchID id = FileWatcher::Watch(directory, [](const std::vector<FileWatchChange>& changes)
+		{
+			for (const auto& change : changes)
+			{
+				if (change.IsDirectory)
+					continue;
+
+				AssetType type = GetAssetTypeFromExtension(change.Path.extension().string());
+				if (type == AssetType::None)
+					continue;
+
+				// Normalize once so a batch of changes is one index lookup each, not a registry scan
+				std::string changedKey = NormalizeAssetPath(change.Path.string());
+				AssetHandle handle(0);
+				{
+					std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+					auto pathIt = s_Instance->m_PathToHandle.find(changedKey);
+					if (pathIt != s_Instance->m_PathToHandle.end())
+					{
+						auto it = s_Instance->m_AssetRegistry.find(pathIt->second);
+						if (it != s_Instance->m_AssetRegistry.end() && !it->second.IsMemoryAsset)
+							handle = pathIt->second;
+					}
+				}
+
+				if (change.Event == FileWatchEvent::Removed)
+				{
+					if (handle.IsValid())
+						UnloadAsset(handle);
+					continue;
+				}
+
+				// Shaders are mostly created directly through Shader::Create, so recompile those in place too
+				if (type == AssetType::Shader)
+					Shader::ReloadFromFile(change.Path.string());
+
+				if (handle.IsValid() && IsAssetLoaded(handle))
+					ReloadAsset(handle);
+
+				// Then only what depends on it
+				DependencyChangedCallback callback;
+				{
+					std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+					callback = s_Instance->m_DependencyChangedCallback;
+				}
+				for (const std::string& dependent : CollectDependents(change.Path.string()))
+				{
+					AssetHandle dependentHandle = GetAssetHandleFromPath(dependent);
+					if (dependentHandle.IsValid() && IsAssetLoaded(dependentHandle))
+						ReloadAsset(dependentHandle);
+					else if (callback)
+						callback(dependent, change.Path.string());
+				}
+			}
+		});
+
+		if (id != 0)
+		{
+			s_Instance->m_HotReloadWatches.push_back(id);
+			NB_CORE_INFO("Asset hot reload enabled for: {0}", directory.string());
+		}
+	}
+
+	void AssetManager::DisableHotReload()
+	{
+		if (!s_Instance)
+			return;
+
+		for (FileWatchID id : s_Instance->m_HotReloadWatches)
+			FileWatcher::Unwatch(id);
+		s_Instance->m_HotReloadWatches.clear();
 	}
 
-	AssetMetadata& AssetManager::GetMetadata(AssetHandle handle)
+	AssetMetadata AssetManager::GetMetadata(AssetHandle handle)
 	{
-		static AssetMetadata s_NullMetadata;
-		
 		if (!s_Instance)
-			return s_NullMetadata;
+			return AssetMetadata();
 
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
 		auto it = s_Instance->m_AssetRegistry.find(handle);
 		if (it != s_Instance->m_AssetRegistry.end())
 			return it->second;
 
-		return s_NullMetadata;
+		return AssetMetadata();
 	}
 
 	AssetMetadata AssetManager::GetMetadataFromPath(const std::string& filepath)
@@ -201,11 +871,10 @@ namespace Nebula {
 		if (!s_Instance)
 			return AssetMetadata();
 
-		for (auto& [handle, metadata] : s_Instance->m_AssetRegistry)
-		{
-			if (metadata.FilePath == filepath)
-				return metadata;
-		}
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		auto it = s_Instance->m_AssetRegistry.find(FindHandle(filepath));
+		if (it != s_Instance->m_AssetRegistry.end())
+			return it->second;
 
 		return AssetMetadata();
 	}
@@ -215,13 +884,8 @@ namespace Nebula {
 		if (!s_Instance)
 			return AssetHandle(0);
 
-		for (auto& [handle, metadata] : s_Instance->m_AssetRegistry)
-		{
-			if (metadata.FilePath == filepath)
-				return handle;
-		}
-
-		return AssetHandle(0);
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		return FindHandle(filepath);
 	}
 
 	bool AssetManager::IsAssetHandleValid(AssetHandle handle)
@@ -229,6 +893,7 @@ namespace Nebula {
 		if (!s_Instance || !handle.IsValid())
 			return false;
 
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
 		return s_Instance->m_AssetRegistry.find(handle) != s_Instance->m_AssetRegistry.end();
 	}
 
@@ -237,6 +902,7 @@ namespace Nebula {
 		if (!s_Instance)
 			return false;
 
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
 		return s_Instance->m_LoadedAssets.find(handle) != s_Instance->m_LoadedAssets.end();
 	}
 
@@ -248,10 +914,199 @@ namespace Nebula {
 			return;
 		}
 
-		s_Instance->m_Importers[type] = importer;
+		{
+			std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+			s_Instance->m_Importers[type] = importer;
+		}
 		NB_CORE_INFO("Registered importer for asset type: {0}", AssetTypeToString(type));
 	}
 
+	std::string AssetManager::NormalizeAssetPath(const std::string& filepath)
+	{
+		std::filesystem::path path(filepath);
+		if (path.is_absolute())
+		{
+			std::error_code error;
+			std::filesystem::path relative = std::filesystem::relative(path, std::filesystem::current_path(error), error);
+			if (!error && !relative.empty() && relative.native()[0] != '.')
+				path = relative;
+		}
+
+		std::string normalized = AssetPack::NormalizePath(path.lexically_normal().generic_string());
+		while (normalized.size() > 1 && normalized.back() == '/')
+			normalized.pop_back();
+		return normalized;
+	}
+
+	void AssetManager::SetDependencies(const std::string& filepath, const std::vector<std::string>& dependencies)
+	{
+		if (!s_Instance)
+			return;
+
+		std::string key = NormalizeAssetPath(filepath);
+		std::vector<std::pair<std::string, const std::string*>> dependencyKeys;
+		for (const std::string& dependency : dependencies)
+		{
+			if (!dependency.empty())
+				dependencyKeys.push_back({ NormalizeAssetPath(dependency), &dependency });
+		}
+
+		std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		auto& graph = s_Instance->m_DependencyGraph;
+		DependencyNode& node = graph[key];
+		node.Path = filepath;
+
+		for (const std::string& old : node.Dependencies)
+			graph[old].Dependents.erase(key);
+		node.Dependencies.clear();
+
+		for (const auto& [dependencyKey, dependency] : dependencyKeys)
+		{
+			if (dependencyKey == key || std::find(node.Dependencies.begin(), node.Dependencies.end(), dependencyKey) != node.Dependencies.end())
+				continue;
+
+			// node stays valid, unordered_map never moves its elements
+			DependencyNode& dependencyNode = graph[dependencyKey];
+			if (dependencyNode.Path.empty())
+				dependencyNode.Path = *dependency;
+			dependencyNode.Dependents.insert(key);
+			node.Dependencies.push_back(dependencyKey);
+		}
+	}
+
+	std::vector<std::string> AssetManager::GetDependencies(const std::string& filepath)
+	{
+		std::vector<std::string> dependencies;
+		if (!s_Instance)
+			return dependencies;
+
+		std::string key = NormalizeAssetPath(filepath);
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		auto it = s_Instance->m_DependencyGraph.find(key);
+		if (it == s_Instance->m_DependencyGraph.end())
+			return dependencies;
+
+		for (const std::string& dependency : it->second.Dependencies)
+			dependencies.push_back(s_Instance->m_DependencyGraph.at(dependency).Path);
+		return dependencies;
+	}
+
+	std::vector<std::string> AssetManager::GetDependents(const std::string& filepath)
+	{
+		std::vector<std::string> dependents;
+		if (!s_Instance)
+			return dependents;
+
+		std::string key = NormalizeAssetPath(filepath);
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		auto it = s_Instance->m_DependencyGraph.find(key);
+		if (it == s_Instance->m_DependencyGraph.end())
+			return dependents;
+
+		for (const std::string& dependent : it->second.Dependents)
+			dependents.push_back(s_Instance->m_DependencyGraph.at(dependent).Path);
+		return dependents;
+	}
+
+	void AssetManager::RegisterDependencyScanner(AssetType type, DependencyScanner scanner)
+	{
+		if (!s_Instance)
+		{
+			NB_CORE_ERROR("AssetManager not initialized!");
+			return;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		s_Instance->m_DependencyScanners[type] = std::move(scanner);
+	}
+
+	std::vector<std::string> AssetManager::CollectDependencies(const std::vector<std::string>& roots)
+	{
+		std::vector<std::string> reachable;
+		if (!s_Instance)
+			return reachable;
+
+		std::unordered_set<std::string> visited;
+		std::deque<std::string> pending(roots.begin(), roots.end());
+		while (!pending.empty())
+		{
+			std::string path = std::move(pending.front());
+			pending.pop_front();
+			if (path.empty() || !visited.insert(NormalizeAssetPath(path)).second)
+				continue;
+			reachable.push_back(path);
+
+			DependencyScanner scanner;
+			{
+				std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+				AssetType type = GetAssetTypeFromExtension(std::filesystem::path(path).extension().string());
+				auto it = s_Instance->m_DependencyScanners.find(type);
+				if (it != s_Instance->m_DependencyScanners.end())
+					scanner = it->second;
+			}
+
+			// What's on disk now, the recorded edges may be from before the last save
+			std::vector<std::string> dependencies;
+			if (scanner)
+			{
+				dependencies = scanner(path);
+				SetDependencies(path, dependencies);
+			}
+			else
+			{
+				dependencies = GetDependencies(path);
+			}
+			pending.insert(pending.end(), dependencies.begin(), dependencies.end());
+		}
+		return reachable;
+	}
+
+	std::vector<std::string> AssetManager::CollectDependents(const std::string& filepath)
+	{
+		std::vector<std::string> dependents;
+		if (!s_Instance)
+			return dependents;
+
+		// Folders count too, a skybox depends on the folder its faces are in
+		std::deque<std::string> pending;
+		std::unordered_set<std::string> visited;
+		std::filesystem::path path(NormalizeAssetPath(filepath));
+		for (; !path.empty(); path = path.parent_path())
+		{
+			visited.insert(path.generic_string());
+			pending.push_back(path.generic_string());
+			if (path == path.parent_path())
+				break;
+		}
+
+		std::shared_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		while (!pending.empty())
+		{
+			auto it = s_Instance->m_DependencyGraph.find(pending.front());
+			pending.pop_front();
+			if (it == s_Instance->m_DependencyGraph.end())
+				continue;
+
+			for (const std::string& dependent : it->second.Dependents)
+			{
+				if (!visited.insert(dependent).second)
+					continue;
+				dependents.push_back(s_Instance->m_DependencyGraph.at(dependent).Path);
+				pending.push_back(dependent);
+			}
+		}
+		return dependents;
+	}
+
+	void AssetManager::SetDependencyChangedCallback(DependencyChangedCallback callback)
+	{
+		if (!s_Instance)
+			return;
+
+		std::unique_lock<std::shared_mutex> lock(s_Instance->m_Mutex);
+		s_Instance->m_DependencyChangedCallback = std::move(callback);
+	}
+
 	void AssetManager::SaveAssetRegistry()
 	{
 		// TODO: Implement JSON serialization of asset registry
@@ -288,9 +1143,9 @@ namespace Nebula {
 
 	AssetHandle AssetManager::GenerateAssetHandle()
 	{
-		static std::random_device rd;
-		static std::mt19937_64 gen(rd());
-		static std::uniform_int_distribution<uint64_t> dis;
+		// One generator per thread, std::mt19937_64 isn't safe to share
+		static thread_local std::mt19937_64 gen(std::random_device{}());
+		static thread_local std::uniform_int_distribution<uint64_t> dis(1);
 
 		return AssetHandle(dis(gen));
 	}
@@ -2,13 +2,25 @@
 #pragma warning(disable: 4251)
 
 #include "Asset.h"
+#include "Nebula/Core/FileWatcher.h"
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <functional>
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace Nebula {
 
+	// Whatever an importer decoded off the main thread, see AssetImporter::LoadAssetData
+	struct NEBULA_API AssetImportData
+	{
+		virtual ~AssetImportData() = default;
+	};
+
 	// Asset importer interface
 	class NEBULA_API AssetImporter
 	{
@@ -16,9 +28,85 @@ namespace Nebula {
 		virtual ~AssetImporter() = default;
 		virtual std::shared_ptr<Asset> ImportAsset(AssetHandle handle, const AssetMetadata& metadata) = 0;
 		virtual bool CanImport(const std::string& extension) const = 0;
+
+		// Split import used by LoadAssetAsync. LoadAssetData runs on a worker thread (file reads,
+		// decoding, no GL calls) and FinalizeAsset on the main thread. Importers that don't
+		// override these do all the work in FinalizeAsset.
+		virtual std::unique_ptr<AssetImportData> LoadAssetData(const AssetMetadata& metadata) { return nullptr; }
+		virtual std::shared_ptr<Asset> FinalizeAsset(AssetHandle handle, const AssetMetadata& metadata, std::unique_ptr<AssetImportData> data)
+		{
+			return ImportAsset(handle, metadata);
+		}
+	};
+
+	enum class AssetLoadPriority : uint8_t
+	{
+		Low = 0,
+		Normal,
+		High
+	};
+
+	enum class AssetLoadState : uint8_t
+	{
+		Queued = 0,
+		Loading,   // Decoding on a worker or waiting for the main thread
+		Ready,
+		Failed
+	};
+
+	struct AssetLoadRequest;
+
+	// Returned by LoadAssetAsync, copies refer to the same load. Safe to use from any thread,
+	// callbacks always run on the main thread.
+	class NEBULA_API AssetLoadHandle
+	{
+	public:
+		using Callback = std::function<void(std::shared_ptr<Asset>)>;
+
+		AssetLoadHandle() = default;
+
+		bool IsValid() const { return m_Request != nullptr; }
+		AssetLoadState GetState() const;
+		bool IsReady() const { return GetState() == AssetLoadState::Ready; }
+		// Ready or failed
+		bool IsDone() const;
+
+		// Registered as soon as the load is requested, so it can be waited on by handle
+		AssetHandle GetHandle() const;
+		// nullptr until ready
+		std::shared_ptr<Asset> GetAsset() const;
+		template<typename T>
+		std::shared_ptr<T> Get() const { return std::static_pointer_cast<T>(GetAsset()); }
+
+		// Called on the main thread when the load finishes, with nullptr if it failed.
+		// Called right away if it already has.
+		void OnComplete(Callback callback) const;
+		// Decodes it here if no worker picked it up yet. The main thread then finishes it right
+		// away, other threads block until the main thread's Update() has.
+		std::shared_ptr<Asset> Wait() const;
+
+	private:
+		friend class AssetManager;
+		AssetLoadHandle(std::shared_ptr<AssetLoadRequest> request) : m_Request(std::move(request)) {}
+
+		std::shared_ptr<AssetLoadRequest> m_Request;
+	};
+
+	struct AsyncAssetLoadQueue;
+
+	// Resident assets of one type, or of all types
+	struct NEBULA_API AssetResidency
+	{
+		uint32_t Count = 0;
+		uint64_t CPUBytes = 0;
+		uint64_t GPUBytes = 0;
+
+		uint64_t TotalBytes() const { return CPUBytes + GPUBytes; }
 	};
 
-	// Asset manager - centralized asset loading and management
+	// Asset manager - centralized asset loading and management.
+	// Lookups and loads may come from any thread: hits only take a shared lock, and a load
+	// requested off the main thread waits for the main thread to finish it (GPU uploads).
 	class NEBULA_API AssetManager
 	{
 	public:
@@ -33,8 +121,31 @@ namespace Nebula {
 		static std::shared_ptr<T> LoadAsset(const std::string& filepath);
 
 		static std::shared_ptr<Asset> GetAssetByHandle(AssetHandle handle);
+		// Threads asking for the same asset at once share one load
 		static std::shared_ptr<Asset> LoadAssetFromPath(const std::string& filepath);
 
+		// Decodes on JobSystem workers, higher priority first, and finishes (GPU upload) in
+		// Update(). Asking again for a path that is in flight returns the same load.
+		static AssetLoadHandle LoadAssetAsync(const std::string& filepath, AssetLoadPriority priority = AssetLoadPriority::Normal);
+		// Main thread, once per frame: finishes decoded async loads until the budget is spent.
+		// At least one load is finished per call so a slow upload can't stall the queue.
+		static void Update();
+		static void SetAsyncUploadBudget(float milliseconds);
+		static float GetAsyncUploadBudget();
+		static uint32_t GetPendingAsyncLoadCount();
+		static void WaitForAsyncLoads();
+
+		// Residency. With a budget set (bytes, 0 = unlimited), Update() evicts the least recently
+		// used assets that nothing outside the manager holds until the total fits. Evicted assets
+		// stay registered and are reloaded by the next GetAsset / LoadAsset.
+		static void SetMemoryBudget(uint64_t bytes);
+		static uint64_t GetMemoryBudget();
+		static AssetResidency GetResidency(AssetType type);
+		static AssetResidency GetTotalResidency();
+		static uint64_t GetEvictionCount();
+		// Evicts unreferenced assets, oldest first, until at most targetBytes are resident. Returns how many.
+		static uint32_t EvictUnusedAssets(uint64_t targetBytes);
+
 		// Asset creation (runtime/memory assets)
 		template<typename T, typename... Args>
 		static std::shared_ptr<T> CreateAsset(Args&&... args);
@@ -44,19 +155,49 @@ namespace Nebula {
 		static void RegisterAsset(const AssetMetadata& metadata, std::shared_ptr<Asset> asset);
 		static void UnloadAsset(AssetHandle handle);
 
-		// Asset metadata
-		static AssetMetadata& GetMetadata(AssetHandle handle);
+		// Asset metadata, returned as copies so they can be read while other threads register assets
+		static AssetMetadata GetMetadata(AssetHandle handle);
 		static AssetMetadata GetMetadataFromPath(const std::string& filepath);
 		static AssetHandle GetAssetHandleFromPath(const std::string& filepath);
 		static bool IsAssetHandleValid(AssetHandle handle);
 		static bool IsAssetLoaded(AssetHandle handle);
 
-		// Importer registration
+		// Hot reload: re-imports loaded assets (and recompiles live shaders) whose source file
+		// changes under the given directory. Existing shared_ptrs keep the old asset.
+		static void EnableHotReload(const std::filesystem::path& directory);
+		static void DisableHotReload();
+		static bool ReloadAsset(AssetHandle handle);
+
+		// Importer registration, at startup before any loads
 		static void RegisterImporter(AssetType type, std::shared_ptr<AssetImporter> importer);
 
+		// Dependency graph, by file path: what a file needs when it loads (a scene's meshes,
+		// textures, shaders, clips and skybox folders). Recorded by whatever loads the file.
+		// Hot reload follows it to the dependents of a changed file, pack building to everything
+		// a game can reach.
+		using DependencyScanner = std::function<std::vector<std::string>(const std::string& filepath)>;
+		using DependencyChangedCallback = std::function<void(const std::string& dependent, const std::string& changedPath)>;
+
+		// Replaces what was recorded for filepath
+		static void SetDependencies(const std::string& filepath, const std::vector<std::string>& dependencies);
+		static std::vector<std::string> GetDependencies(const std::string& filepath);
+		// Direct dependents only
+		static std::vector<std::string> GetDependents(const std::string& filepath);
+		// Reads a file's dependencies without loading it, at startup like importers
+		static void RegisterDependencyScanner(AssetType type, DependencyScanner scanner);
+		// Every file reachable from the roots, roots first. Files with a scanner are rescanned.
+		static std::vector<std::string> CollectDependencies(const std::vector<std::string>& roots);
+		// Hot reload reloads loaded assets that depend on a changed file. Any other dependent
+		// (a scene open in the editor) is handed to this callback, on the main thread.
+		static void SetDependencyChangedCallback(DependencyChangedCallback callback);
+		// The form paths are compared in: relative to the working directory when below it,
+		// forward slashes, lowercase
+		static std::string NormalizeAssetPath(const std::string& filepath);
+
 		// Asset database operations
 		static void SaveAssetRegistry();
 		static void LoadAssetRegistry();
+		// Not synchronized, main thread only while no loads are running
 		static std::unordered_map<AssetHandle, AssetMetadata>& GetAssetRegistry() { return s_Instance->m_AssetRegistry; }
 
 		// Utility
@@ -64,11 +205,67 @@ namespace Nebula {
 		static AssetHandle GenerateAssetHandle();
 
 	private:
-		AssetManager() = default;
+		AssetManager();
+
+		static void FinishAsyncLoad(const std::shared_ptr<AssetLoadRequest>& request);
+
+		// The helpers below expect m_Mutex to be held, exclusively unless noted.
+		// Every change to the registry and m_LoadedAssets goes through them to keep the path
+		// index and the accounting right. Removed assets are returned so they can be destroyed
+		// after the lock is released.
+		static void SetMetadata(const AssetMetadata& metadata);
+		static void RemoveMetadata(AssetHandle handle);
+		static std::shared_ptr<Asset> SetLoadedAsset(AssetHandle handle, const std::shared_ptr<Asset>& asset);
+		static std::shared_ptr<Asset> RemoveLoadedAsset(AssetHandle handle);
+		// Shared lock is enough
+		static void TouchAsset(AssetHandle handle);
+		static AssetHandle FindHandle(const std::string& filepath);
+		// Transitive dependents of a file and of the folders it's in, nearest first
+		static std::vector<std::string> CollectDependents(const std::string& filepath);
+
+		// Guards everything below except the async queue, which has its own lock (taken after this one)
+		mutable std::shared_mutex m_Mutex;
+		std::thread::id m_MainThread;
 
 		std::unordered_map<AssetHandle, AssetMetadata> m_AssetRegistry;
+		// Keyed by NormalizeAssetPath(FilePath)
+		std::unordered_map<std::string, AssetHandle> m_PathToHandle;
 		std::unordered_map<AssetHandle, std::shared_ptr<Asset>> m_LoadedAssets;
 		std::unordered_map<AssetType, std::shared_ptr<AssetImporter>> m_Importers;
+		std::vector<FileWatchID> m_HotReloadWatches;
+
+		struct ResidentAsset
+		{
+			AssetType Type = AssetType::None;
+			AssetMemoryUsage Memory;
+			// Written under the shared lock by lookups, so eviction order costs readers nothing
+			std::atomic<uint64_t> LastUsed{ 0 };
+		};
+		std::unordered_map<AssetHandle, ResidentAsset> m_Residency;
+		std::atomic<uint64_t> m_UseCounter{ 0 };
+		std::unordered_map<AssetType, AssetResidency> m_TypeResidency;
+		AssetResidency m_TotalResidency;
+		uint64_t m_MemoryBudget = 0;
+		uint64_t m_EvictionCount = 0;
+
+		// Keyed by normalized path, Path keeps the spelling it was recorded with
+		struct DependencyNode
+		{
+			std::string Path;
+			std::vector<std::string> Dependencies;
+			std::unordered_set<std::string> Dependents;
+		};
+		std::unordered_map<std::string, DependencyNode> m_DependencyGraph;
+		std::unordered_map<AssetType, DependencyScanner> m_DependencyScanners;
+		DependencyChangedCallback m_DependencyChangedCallback;
+
+		// Shared with the worker jobs, which may outlive the manager
+		std::shared_ptr<AsyncAssetLoadQueue> m_AsyncQueue;
+		std::unordered_map<std::string, std::shared_ptr<AssetLoadRequest>> m_AsyncLoads; // Keyed by NormalizeAssetPath(FilePath)
+		float m_AsyncUploadBudget = 2.0f;
+		uint64_t m_AsyncSequence = 0;
+
+		friend class AssetLoadHandle;
 
 		static AssetManager* s_Instance;
 	};
@@ -100,8 +297,7 @@ namespace Nebula {
 		metadata.IsMemoryAsset = true;
 		metadata.IsLoaded = true;
 
-		s_Instance->m_AssetRegistry[handle] = metadata;
-		s_Instance->m_LoadedAssets[handle] = asset;
+		RegisterAsset(metadata, asset);
 
 		return asset;
 	}
@@ -4,10 +4,11 @@
 #include "AssetManager.h"
 #include "TextureImporter.h"
 #include "ShaderImporter.h"
+#include "Nebula/Scene/SceneSerializer.h"
 
 namespace Nebula {
 
-	// Helper class to register all asset importers
+	// Helper class to register all asset importers and dependency scanners
 	class AssetManagerRegistry
 	{
 	public:
@@ -16,6 +17,8 @@ namespace Nebula {
 			AssetManager::RegisterImporter(AssetType::Texture2D, std::make_shared<TextureImporter>());
 			AssetManager::RegisterImporter(AssetType::Shader, std::make_shared<ShaderImporter>());
 			// Add more importers as they're implemented
+
+			AssetManager::RegisterDependencyScanner(AssetType::Scene, &SceneSerializer::GetDependencies);
 		}
 	};
 
@@ -4,18 +4,56 @@
 
 namespace Nebula {
 
+	struct TextureImportData : public AssetImportData
+	{
+		Texture2D* Texture = nullptr;
+
+		~TextureImportData()
+		{
+			delete Texture;
+		}
+	};
+
 	std::shared_ptr<Asset> TextureImporter::ImportAsset(AssetHandle handle, const AssetMetadata& metadata)
 	{
 		NB_CORE_INFO("Importing texture: {0}", metadata.FilePath);
 
 		Texture2D* texture = Texture2D::Create(metadata.FilePath);
 		
-		if (!texture)
+		if (!texture || !texture->IsReady())
+		{
+			NB_CORE_ERROR("Failed to load texture: {0}", metadata.FilePath);
+			delete texture;
+			return nullptr;
+		}
+
+		return std::make_shared<TextureAsset>(handle, metadata.FilePath, texture);
+	}
+
+	std::unique_ptr<AssetImportData> TextureImporter::LoadAssetData(const AssetMetadata& metadata)
+	{
+		auto data = std::make_unique<TextureImportData>();
+		data->Texture = Texture2D::CreateDeferred(metadata.FilePath);
+		if (data->Texture)
+			data->Texture->Decode();
+		return data;
+	}
+
+	std::shared_ptr<Asset> TextureImporter::FinalizeAsset(AssetHandle handle, const AssetMetadata& metadata, std::unique_ptr<AssetImportData> data)
+	{
+		auto* textureData = static_cast<TextureImportData*>(data.get());
+		if (!textureData || !textureData->Texture)
+			return nullptr;
+
+		textureData->Texture->Upload();
+		if (!textureData->Texture->IsReady())
 		{
 			NB_CORE_ERROR("Failed to load texture: {0}", metadata.FilePath);
 			return nullptr;
 		}
 
+		Texture2D* texture = textureData->Texture;
+		textureData->Texture = nullptr;
 		return std::make_shared<TextureAsset>(handle, metadata.FilePath, texture);
 	}
 
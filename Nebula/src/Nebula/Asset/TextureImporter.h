@@ -11,6 +11,10 @@ namespace Nebula {
 	public:
 		virtual std::shared_ptr<Asset> ImportAsset(AssetHandle handle, const AssetMetadata& metadata) override;
 		virtual bool CanImport(const std::string& extension) const override;
+
+		// Image decode on the worker, GL upload in FinalizeAsset
+		virtual std::unique_ptr<AssetImportData> LoadAssetData(const AssetMetadata& metadata) override;
+		virtual std::shared_ptr<Asset> FinalizeAsset(AssetHandle handle, const AssetMetadata& metadata, std::unique_ptr<AssetImportData> data) override;
 	};
 
 	// Texture2D wrapper that inherits from Asset
@@ -32,6 +36,13 @@ namespace Nebula {
 		
 		uint32_t GetWidth() const { return m_Texture ? m_Texture->GetWidth() : 0; }
 		uint32_t GetHeight() const { return m_Texture ? m_Texture->GetHeight() : 0; }
+
+		virtual AssetMemoryUsage GetMemoryUsage() const override
+		{
+			AssetMemoryUsage usage;
+			usage.GPUBytes = m_Texture ? m_Texture->GetMemorySize() : 0;
+			return usage;
+		}
 		
 		void Bind(uint32_t slot = 0) const 
 		{ 
@@ -1,20 +1,61 @@
 #include "nbpch.h"
 #include "AudioClip.h"
+#include "Nebula/Core/VirtualFileSystem.h"
 
 #ifdef NB_PLATFORM_WINDOWS
 	#include "Platform/OpenAL/OpenALAudioClip.h"
+	#include "Platform/OpenAL/OpenALStreamingAudioClip.h"
 #endif
 
 namespace Nebula {
 
-	AudioClip* AudioClip::Create(const std::string& filepath)
+	// About two minutes of 128 kbps MP3 or ten seconds of 16-bit stereo WAV
+	static uint64_t s_StreamingThreshold = 2 * 1024 * 1024;
+
+	AudioClip* AudioClip::Create(const std::string& filepath, const AudioClipImportOptions& options)
+	{
+	#ifdef NB_PLATFORM_WINDOWS
+		AudioClip* clip = CreateDeferred(filepath, options);
+		clip->Decode();
+
+		if (clip->IsStreaming() && !static_cast<OpenALStreamingAudioClip*>(clip)->IsValid())
+		{
+			// Decoded up front instead
+			delete clip;
+			clip = new OpenALAudioClip(filepath, options);
+			clip->Decode();
+		}
+
+		clip->Upload();
+		return clip;
+	#else
+		NB_CORE_ASSERT(false, "Unknown platform!");
+		return nullptr;
+	#endif
+	}
+
+	AudioClip* AudioClip::CreateDeferred(const std::string& filepath, const AudioClipImportOptions& options)
 	{
 	#ifdef NB_PLATFORM_WINDOWS
-		return new OpenALAudioClip(filepath);
+		uint64_t fileSize = VirtualFileSystem::GetFileSize(filepath);
+		if (fileSize >= s_StreamingThreshold && OpenALStreamingAudioClip::IsSupported(filepath))
+			return new OpenALStreamingAudioClip(filepath, options);
+
+		return new OpenALAudioClip(filepath, options);
 	#else
 		NB_CORE_ASSERT(false, "Unknown platform!");
 		return nullptr;
 	#endif
 	}
 
+	void AudioClip::SetStreamingThreshold(uint64_t bytes)
+	{
+		s_StreamingThreshold = bytes;
+	}
+
+	uint64_t AudioClip::GetStreamingThreshold()
+	{
+		return s_StreamingThreshold;
+	}
+
 }
@@ -7,20 +7,47 @@
 
 namespace Nebula {
 
+	// Applied to the decoded samples before they're uploaded
+	struct AudioClipImportOptions
+	{
+		// Downmix stereo to mono. OpenAL only spatializes mono sources.
+		bool Mono = false;
+		// Resample to this rate, 0 keeps the file's rate. Not applied to streaming clips.
+		uint32_t SampleRate = 0;
+	};
+
 	// Abstract audio clip interface
 	class NEBULA_API AudioClip
 	{
 	public:
 		virtual ~AudioClip() = default;
 
-		// Load audio from file
-		static AudioClip* Create(const std::string& filepath);
+		// Load audio from file. Files at or above the streaming threshold are
+		// streamed from disk while playing instead of being decoded up front
+		static AudioClip* Create(const std::string& filepath, const AudioClipImportOptions& options = {});
+		// Same choice of clip type, but nothing is loaded yet. Call Decode() (any
+		// thread) and then Upload() (main thread) before using it.
+		static AudioClip* CreateDeferred(const std::string& filepath, const AudioClipImportOptions& options = {});
+
+		// File size in bytes from which clips are streamed, 0 streams everything
+		static void SetStreamingThreshold(uint64_t bytes);
+		static uint64_t GetStreamingThreshold();
+
+		// Reads and decodes the file, touches no audio API state
+		virtual void Decode() = 0;
+		// Hands the decoded data to the audio API and frees it
+		virtual void Upload() = 0;
+		// Properties below are valid once the clip is ready
+		virtual bool IsReady() const = 0;
 
 		// Get clip properties
 		virtual float GetDuration() const = 0;
 		virtual int GetSampleRate() const = 0;
 		virtual int GetChannels() const = 0;
 		virtual const std::string& GetFilePath() const = 0;
+		virtual bool IsStreaming() const { return false; }
+		// Size of the PCM data kept in memory, streaming clips keep none
+		virtual uint64_t GetDecodedSize() const = 0;
 
 		// Runtime data access (platform-specific)
 		virtual void* GetNativeHandle() const = 0;
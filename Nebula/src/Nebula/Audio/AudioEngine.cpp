@@ -1,8 +1,11 @@
 #include "nbpch.h"
 #include "AudioEngine.h"
+#include "AudioClip.h"
+#include "Nebula/Core/JobSystem.h"
 
 #ifdef NB_PLATFORM_WINDOWS
 	#include "Platform/OpenAL/OpenALAudioEngine.h"
+	#include "Platform/OpenAL/OpenALLoopbackAudioEngine.h"
 #endif
 
 namespace Nebula {
@@ -17,4 +20,113 @@ namespace Nebula {
 	#endif
 	}
 
+	AudioEngine* AudioEngine::CreateHeadless(uint32_t sampleRate, bool renderOnUpdate)
+	{
+	#ifdef NB_PLATFORM_WINDOWS
+		return new OpenALLoopbackAudioEngine(sampleRate, renderOnUpdate);
+	#else
+		NB_CORE_ASSERT(false, "Unknown platform!");
+		return nullptr;
+	#endif
+	}
+
+	std::shared_ptr<AudioClip> AudioEngine::LoadClip(const std::string& filepath, const AudioClipImportOptions& options)
+	{
+		AudioClipImportOptions importOptions = options;
+		if (m_ResampleClips && importOptions.SampleRate == 0)
+			importOptions.SampleRate = GetDeviceSampleRate();
+
+		std::string key = filepath;
+		if (importOptions.Mono)
+			key += "|mono";
+		if (importOptions.SampleRate != 0)
+			key += "|" + std::to_string(importOptions.SampleRate);
+
+		auto it = m_ClipCache.find(key);
+		if (it != m_ClipCache.end())
+		{
+			if (std::shared_ptr<AudioClip> clip = it->second.lock())
+				return clip;
+		}
+
+		std::shared_ptr<AudioClip> clip(AudioClip::CreateDeferred(filepath, importOptions));
+		if (!clip)
+			return nullptr;
+
+		// The job keeps the clip alive even if every user lets go before it finishes
+		PendingClipLoad load;
+		load.Clip = clip;
+		load.Decoded = JobSystem::Submit([clip]() { clip->Decode(); });
+		m_PendingClipLoads.push_back(std::move(load));
+
+		// Misses are rare, drop the entries of clips nobody uses anymore while we're here
+		for (auto entry = m_ClipCache.begin(); entry != m_ClipCache.end();)
+		{
+			if (entry->second.expired())
+				entry = m_ClipCache.erase(entry);
+			else
+				++entry;
+		}
+
+		m_ClipCache[key] = clip;
+		return clip;
+	}
+
+	void AudioEngine::FinishClipLoads()
+	{
+		size_t finished = 0;
+		for (size_t i = 0; i < m_PendingClipLoads.size();)
+		{
+			PendingClipLoad& load = m_PendingClipLoads[i];
+			if (load.Decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				i++;
+				continue;
+			}
+
+			load.Clip->Upload();
+			m_PendingClipLoads[i] = std::move(m_PendingClipLoads.back());
+			m_PendingClipLoads.pop_back();
+			finished++;
+		}
+
+		if (finished > 0)
+			OnClipsUploaded();
+	}
+
+	void AudioEngine::WaitForClipLoads()
+	{
+		for (PendingClipLoad& load : m_PendingClipLoads)
+		{
+			load.Decoded.wait();
+			load.Clip->Upload();
+		}
+
+		if (!m_PendingClipLoads.empty())
+			OnClipsUploaded();
+		m_PendingClipLoads.clear();
+	}
+
+	size_t AudioEngine::GetCachedClipCount() const
+	{
+		size_t count = 0;
+		for (const auto& pair : m_ClipCache)
+		{
+			if (!pair.second.expired())
+				count++;
+		}
+		return count;
+	}
+
+	uint64_t AudioEngine::GetCachedClipDecodedBytes() const
+	{
+		uint64_t bytes = 0;
+		for (const auto& pair : m_ClipCache)
+		{
+			if (std::shared_ptr<AudioClip> clip = pair.second.lock())
+				bytes += clip->GetDecodedSize();
+		}
+		return bytes;
+	}
+
 }
@@ -2,13 +2,16 @@
 #pragma warning(disable: 4251)
 
 #include "Nebula/Core.h"
+#include "AudioClip.h"
 #include <glm/glm.hpp>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <future>
 
 namespace Nebula {
 
-	class AudioClip;
-
 	// Abstract audio engine interface
 	class NEBULA_API AudioEngine
 	{
@@ -17,11 +20,36 @@ namespace Nebula {
 
 		// Factory method
 		static AudioEngine* Create();
+		// Engine that mixes without a sound card, for tests, benchmarks and
+		// dedicated servers. Pull the mix with Render(), or pass renderOnUpdate
+		// to have Update() mix and discard the elapsed time so playback advances.
+		static AudioEngine* CreateHeadless(uint32_t sampleRate = 48000, bool renderOnUpdate = false);
 
 		// Engine lifecycle
 		virtual bool Init() = 0;
 		virtual void Shutdown() = 0;
 
+		// Clips are shared by path between all sources of this engine, so a
+		// sound used by many emitters is decoded and uploaded once. The cache only
+		// holds weak references, a clip is freed with its last user.
+		// Decoding runs on the JobSystem; the clip is returned right away and is
+		// ready (IsReady()) once a later Update() has uploaded it. The same file
+		// loaded with different options is a different clip.
+		std::shared_ptr<AudioClip> LoadClip(const std::string& filepath, const AudioClipImportOptions& options = {});
+		// Uploads every clip that finished decoding, without waiting
+		void FinishClipLoads();
+		// Blocks until all requested clips are decoded and uploaded
+		void WaitForClipLoads();
+		bool HasPendingClipLoads() const { return !m_PendingClipLoads.empty(); }
+
+		// Resample loaded clips to the device rate so the mixer doesn't have to
+		void SetResampleClipsToDeviceRate(bool resample) { m_ResampleClips = resample; }
+		bool GetResampleClipsToDeviceRate() const { return m_ResampleClips; }
+		virtual uint32_t GetDeviceSampleRate() const = 0;
+		size_t GetCachedClipCount() const;
+		// PCM bytes held by the cached clips
+		uint64_t GetCachedClipDecodedBytes() const;
+
 		// Master volume control (0.0 to 1.0)
 		virtual void SetMasterVolume(float volume) = 0;
 		virtual float GetMasterVolume() const = 0;
@@ -43,13 +71,15 @@ namespace Nebula {
 		virtual bool IsSourcePlaying(uint32_t sourceID) const = 0;
 
 		// Source properties
-		virtual void SetSourceClip(uint32_t sourceID, AudioClip* clip) = 0;
+		virtual void SetSourceClip(uint32_t sourceID, const std::shared_ptr<AudioClip>& clip) = 0;
 		virtual void SetSourcePosition(uint32_t sourceID, const glm::vec3& position) = 0;
 		virtual void SetSourceVelocity(uint32_t sourceID, const glm::vec3& velocity) = 0;
 		virtual void SetSourceVolume(uint32_t sourceID, float volume) = 0;
 		virtual void SetSourcePitch(uint32_t sourceID, float pitch) = 0;
 		virtual void SetSourceLoop(uint32_t sourceID, bool loop) = 0;
 		virtual void SetSourceSpatial(uint32_t sourceID, bool spatial) = 0;
+		// 0 is the most important, 256 the least. Decides which sources get a real voice first.
+		virtual void SetSourcePriority(uint32_t sourceID, int priority) = 0;
 
 		// Source property getters
 		virtual float GetSourceVolume(uint32_t sourceID) const = 0;
@@ -61,8 +91,47 @@ namespace Nebula {
 		virtual void SetSourceReferenceDistance(uint32_t sourceID, float distance) = 0;
 		virtual void SetSourceMaxDistance(uint32_t sourceID, float distance) = 0;
 
+		// Voice pool. Only this many sources are mixed at once, the rest play virtually.
+		virtual void SetMaxRealVoices(uint32_t count) = 0;
+		virtual uint32_t GetMaxRealVoices() const = 0;
+		virtual uint32_t GetRealVoiceCount() const = 0;
+
+		// Playing sources quieter than this gain (after distance attenuation) are
+		// culled: they play virtually and resume at the right offset when they get
+		// loud enough again. Spatial sources beyond their MaxDistance are always culled.
+		virtual void SetAudibilityThreshold(float gain) = 0;
+		virtual float GetAudibilityThreshold() const = 0;
+
+		// How often Update() checks which sources finished and reassigns real
+		// voices, in seconds. 0 checks every update. Property changes are sent
+		// every update regardless.
+		virtual void SetStatePollInterval(float seconds) = 0;
+		virtual float GetStatePollInterval() const = 0;
+
 		// Update (called per frame if needed)
 		virtual void Update() = 0;
+
+		// Headless engines only. Mixes frameCount frames of interleaved 16-bit
+		// stereo into samples at GetDeviceSampleRate(). Call Update() in between
+		// so streams keep up. Returns false when the engine plays to a device.
+		virtual bool IsHeadless() const { return false; }
+		virtual bool Render(int16_t* samples, uint32_t frameCount) { return false; }
+
+	protected:
+		// Called after FinishClipLoads() or WaitForClipLoads() made clips ready
+		virtual void OnClipsUploaded() {}
+
+	private:
+		// Clip buffers belong to this engine's device, so the cache is per engine
+		std::unordered_map<std::string, std::weak_ptr<AudioClip>> m_ClipCache;
+		bool m_ResampleClips = false;
+
+		struct PendingClipLoad
+		{
+			std::shared_ptr<AudioClip> Clip;
+			std::future<void> Decoded;
+		};
+		std::vector<PendingClipLoad> m_PendingClipLoads;
 	};
 
 }
@@ -0,0 +1,138 @@
+#include "nbpch.h"
+#include "PCMConversion.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+	#define NB_PCM_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+	#define NB_PCM_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace Nebula {
+
+	void PCMConversion::FloatToInt16(const float* in, int16_t* out, size_t sampleCount)
+	{
+		size_t i = 0;
+
+		// Writing in place is safe, each block is loaded before it's stored and
+		// the output never runs ahead of the input
+	#if defined(NB_PCM_SSE2)
+		const __m128 minimum = _mm_set1_ps(-1.0f);
+		const __m128 maximum = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(32767.0f);
+		for (; i + 8 <= sampleCount; i += 8)
+		{
+			__m128 a = _mm_loadu_ps(in + i);
+			__m128 b = _mm_loadu_ps(in + i + 4);
+			a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, minimum), maximum), scale);
+			b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, minimum), maximum), scale);
+			__m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+		}
+	#elif defined(NB_PCM_NEON)
+		const float32x4_t minimum = vdupq_n_f32(-1.0f);
+		const float32x4_t maximum = vdupq_n_f32(1.0f);
+		for (; i + 8 <= sampleCount; i += 8)
+		{
+			float32x4_t a = vld1q_f32(in + i);
+			float32x4_t b = vld1q_f32(in + i + 4);
+			a = vmulq_n_f32(vminq_f32(vmaxq_f32(a, minimum), maximum), 32767.0f);
+			b = vmulq_n_f32(vminq_f32(vmaxq_f32(b, minimum), maximum), 32767.0f);
+			int16x8_t packed = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+			vst1q_s16(out + i, packed);
+		}
+	#endif
+
+		for (; i < sampleCount; i++)
+		{
+			float sample = in[i];
+			sample = (sample < -1.0f) ? -1.0f : (sample > 1.0f) ? 1.0f : sample;
+			out[i] = static_cast<int16_t>(sample * 32767.0f);
+		}
+	}
+
+	void PCMConversion::UInt8ToInt16(const uint8_t* in, int16_t* out, size_t sampleCount)
+	{
+		size_t i = 0;
+
+		// (x - 128) << 8 is x with its top bit flipped, placed in the high byte
+	#if defined(NB_PCM_SSE2)
+		const __m128i signBit = _mm_set1_epi8((char)0x80);
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= sampleCount; i += 16)
+		{
+			__m128i bytes = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), signBit);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(zero, bytes));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(zero, bytes));
+		}
+	#elif defined(NB_PCM_NEON)
+		const uint8x16_t signBit = vdupq_n_u8(0x80);
+		for (; i + 16 <= sampleCount; i += 16)
+		{
+			int8x16_t bytes = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(in + i), signBit));
+			vst1q_s16(out + i, vshlq_n_s16(vmovl_s8(vget_low_s8(bytes)), 8));
+			vst1q_s16(out + i + 8, vshlq_n_s16(vmovl_s8(vget_high_s8(bytes)), 8));
+		}
+	#endif
+
+		for (; i < sampleCount; i++)
+			out[i] = static_cast<int16_t>((static_cast<int>(in[i]) - 128) * 256);
+	}
+
+	void PCMConversion::DownmixStereoToMono(const int16_t* in, int16_t* out, size_t frameCount)
+	{
+		size_t i = 0;
+
+		// (L + R) >> 1 in 32 bits, can't overflow
+	#if defined(NB_PCM_SSE2)
+		const __m128i ones = _mm_set1_epi16(1);
+		for (; i + 8 <= frameCount; i += 8)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2 + 8));
+			__m128i sumA = _mm_srai_epi32(_mm_madd_epi16(a, ones), 1);
+			__m128i sumB = _mm_srai_epi32(_mm_madd_epi16(b, ones), 1);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(sumA, sumB));
+		}
+	#elif defined(NB_PCM_NEON)
+		for (; i + 8 <= frameCount; i += 8)
+		{
+			int16x8x2_t frames = vld2q_s16(in + i * 2);
+			vst1q_s16(out + i, vhaddq_s16(frames.val[0], frames.val[1]));
+		}
+	#endif
+
+		for (; i < frameCount; i++)
+			out[i] = static_cast<int16_t>((static_cast<int>(in[i * 2]) + static_cast<int>(in[i * 2 + 1])) >> 1);
+	}
+
+	void PCMConversion::Resample(const int16_t* in, size_t frameCount, int channels, uint32_t inRate, uint32_t outRate, std::vector<int16_t>& out)
+	{
+		if (frameCount == 0 || inRate == 0 || outRate == 0)
+		{
+			out.clear();
+			return;
+		}
+
+		size_t outFrames = (size_t)((uint64_t)frameCount * outRate / inRate);
+		out.resize(outFrames * channels);
+
+		double step = (double)inRate / (double)outRate;
+		for (size_t frame = 0; frame < outFrames; frame++)
+		{
+			double position = frame * step;
+			size_t index = (size_t)position;
+			float t = (float)(position - (double)index);
+			size_t next = index + 1 < frameCount ? index + 1 : index;
+
+			for (int channel = 0; channel < channels; channel++)
+			{
+				float a = in[index * channels + channel];
+				float b = in[next * channels + channel];
+				out[frame * channels + channel] = static_cast<int16_t>(a + (b - a) * t);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Nebula {
+
+	// Sample format kernels used when importing audio. SSE2 on x86/x64, NEON on
+	// ARM, scalar elsewhere; all paths give the same results.
+	class NEBULA_API PCMConversion
+	{
+	public:
+		// Clamps to [-1, 1] and truncates like a static_cast. out may alias in.
+		static void FloatToInt16(const float* in, int16_t* out, size_t sampleCount);
+		// Unsigned 8-bit WAV samples to signed 16-bit
+		static void UInt8ToInt16(const uint8_t* in, int16_t* out, size_t sampleCount);
+		// Averages left and right. out may alias in.
+		static void DownmixStereoToMono(const int16_t* in, int16_t* out, size_t frameCount);
+		// Linear interpolation, enough for matching the device rate
+		static void Resample(const int16_t* in, size_t frameCount, int channels, uint32_t inRate, uint32_t outRate, std::vector<int16_t>& out);
+	};
+
+}
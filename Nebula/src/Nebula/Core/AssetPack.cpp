@@ -0,0 +1,355 @@
+#include "nbpch.h"
+#include "AssetPack.h"
+#include "LZ4.h"
+#include "Nebula/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#ifndef NB_PLATFORM_WINDOWS
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Nebula {
+
+	// Read-only mapping of a whole file
+	class MappedFile
+	{
+	public:
+		~MappedFile()
+		{
+		#ifdef NB_PLATFORM_WINDOWS
+			if (m_Data)
+				UnmapViewOfFile(m_Data);
+			if (m_Mapping)
+				CloseHandle(m_Mapping);
+			if (m_File != INVALID_HANDLE_VALUE)
+				CloseHandle(m_File);
+		#else
+			if (m_Data)
+				munmap(m_Data, m_Size);
+		#endif
+		}
+
+		bool Open(const std::filesystem::path& filepath)
+		{
+		#ifdef NB_PLATFORM_WINDOWS
+			m_File = CreateFileW(filepath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_File == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+				return false;
+			m_Size = (size_t)size.QuadPart;
+
+			m_Mapping = CreateFileMappingW(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!m_Mapping)
+				return false;
+
+			m_Data = MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+			return m_Data != nullptr;
+		#else
+			int fd = open(filepath.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat info;
+			if (fstat(fd, &info) != 0 || info.st_size == 0)
+			{
+				close(fd);
+				return false;
+			}
+			m_Size = (size_t)info.st_size;
+
+			// The mapping stays valid after the descriptor is closed
+			void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (data == MAP_FAILED)
+				return false;
+			m_Data = data;
+			return true;
+		#endif
+		}
+
+		const uint8_t* GetData() const { return static_cast<const uint8_t*>(m_Data); }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_Data = nullptr;
+		size_t m_Size = 0;
+	#ifdef NB_PLATFORM_WINDOWS
+		HANDLE m_File = INVALID_HANDLE_VALUE;
+		HANDLE m_Mapping = nullptr;
+	#endif
+	};
+
+	AssetPack::~AssetPack() = default;
+
+	std::shared_ptr<AssetPack> AssetPack::Open(const std::filesystem::path& filepath)
+	{
+		auto file = std::make_unique<MappedFile>();
+		if (!file->Open(filepath))
+		{
+			NB_CORE_ERROR("Failed to map asset pack: {0}", filepath.string());
+			return nullptr;
+		}
+
+		const uint8_t* base = file->GetData();
+		size_t size = file->GetSize();
+
+		AssetPackHeader header;
+		if (size < sizeof(header))
+		{
+			NB_CORE_ERROR("Asset pack is truncated: {0}", filepath.string());
+			return nullptr;
+		}
+		std::memcpy(&header, base, sizeof(header));
+
+		if (std::memcmp(header.Magic, "NBPK", 4) != 0 || header.Version != 1)
+		{
+			NB_CORE_ERROR("Not a supported asset pack: {0}", filepath.string());
+			return nullptr;
+		}
+
+		// Compared by subtraction, offset + size could wrap around
+		uint64_t tocSize = (uint64_t)header.EntryCount * sizeof(AssetPackEntry);
+		if (header.TocOffset % alignof(AssetPackEntry) != 0 ||
+			header.TocOffset > size || tocSize > size - header.TocOffset ||
+			header.StringsOffset > size || header.StringsSize > size - header.StringsOffset)
+		{
+			NB_CORE_ERROR("Asset pack has a corrupt table of contents: {0}", filepath.string());
+			return nullptr;
+		}
+
+		std::shared_ptr<AssetPack> pack(new AssetPack());
+		pack->m_FilePath = filepath;
+		pack->m_Header = header;
+		pack->m_Base = base;
+		pack->m_Entries = reinterpret_cast<const AssetPackEntry*>(base + header.TocOffset);
+		pack->m_Strings = reinterpret_cast<const char*>(base + header.StringsOffset);
+
+		for (uint32_t i = 0; i < header.EntryCount; i++)
+		{
+			const AssetPackEntry& entry = pack->m_Entries[i];
+			if (entry.Offset > size || entry.StoredSize > size - entry.Offset ||
+				entry.PathOffset > header.StringsSize || entry.PathLength > header.StringsSize - entry.PathOffset)
+			{
+				NB_CORE_ERROR("Asset pack entry {0} is out of bounds: {1}", i, filepath.string());
+				return nullptr;
+			}
+
+			// ReadFile allocates Size up front. Stored entries are handed out as is, and LZ4
+			// can't expand more than 255x, so a bigger Size is a corrupt TOC.
+			bool sizeValid = false;
+			if (entry.Compression == AssetPackCompression::None)
+				sizeValid = entry.Size == entry.StoredSize;
+			else if (entry.Compression == AssetPackCompression::LZ4)
+				sizeValid = entry.Size / 255 + (entry.Size % 255 != 0) <= entry.StoredSize;
+			if (!sizeValid)
+			{
+				NB_CORE_ERROR("Asset pack entry {0} has an invalid size: {1}", i, filepath.string());
+				return nullptr;
+			}
+		}
+
+		pack->m_File = std::move(file);
+		NB_CORE_INFO("Mounted asset pack: {0} ({1} files)", filepath.string(), header.EntryCount);
+		return pack;
+	}
+
+	const AssetPackEntry* AssetPack::FindEntry(const std::string& path) const
+	{
+		uint64_t hash = HashPath(path);
+		const AssetPackEntry* begin = m_Entries;
+		const AssetPackEntry* end = m_Entries + m_Header.EntryCount;
+
+		const AssetPackEntry* it = std::lower_bound(begin, end, hash,
+			[](const AssetPackEntry& entry, uint64_t value) { return entry.PathHash < value; });
+
+		// Compare the names too, two paths may share a hash
+		for (; it != end && it->PathHash == hash; ++it)
+		{
+			if (it->PathLength == path.size() && std::memcmp(m_Strings + it->PathOffset, path.data(), path.size()) == 0)
+				return it;
+		}
+		return nullptr;
+	}
+
+	std::string AssetPack::GetEntryPath(const AssetPackEntry& entry) const
+	{
+		return std::string(m_Strings + entry.PathOffset, entry.PathLength);
+	}
+
+	std::string AssetPack::NormalizePath(const std::string& path)
+	{
+		std::string result = path;
+		for (char& c : result)
+		{
+			if (c == '\\')
+				c = '/';
+			else if (c >= 'A' && c <= 'Z')
+				c = (char)(c - 'A' + 'a');
+		}
+
+		while (result.compare(0, 2, "./") == 0)
+			result.erase(0, 2);
+		return result;
+	}
+
+	uint64_t AssetPack::HashPath(const std::string& normalizedPath)
+	{
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : normalizedPath)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// Audio streams read their file for every source that plays it. Stored as is, each stream
+	// reads straight from the mapping instead of decompressing a copy of the whole clip.
+	static bool IsStreamedAudio(const std::string& normalizedPath)
+	{
+		std::string extension = std::filesystem::path(normalizedPath).extension().string();
+		return extension == ".wav" || extension == ".mp3" || extension == ".ogg";
+	}
+
+	void AssetPackBuilder::AddFile(const std::filesystem::path& diskPath, const std::string& virtualPath)
+	{
+		m_Files.push_back({ diskPath, virtualPath });
+	}
+
+	void AssetPackBuilder::AddDirectory(const std::filesystem::path& directory, const std::string& virtualRoot)
+	{
+		std::error_code error;
+		for (auto it = std::filesystem::recursive_directory_iterator(directory, error); it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+		{
+			if (error)
+				break;
+			if (!it->is_regular_file())
+				continue;
+
+			std::filesystem::path relative = std::filesystem::relative(it->path(), directory, error);
+			std::string virtualPath = virtualRoot.empty() ? relative.generic_string() : virtualRoot + "/" + relative.generic_string();
+			AddFile(it->path(), virtualPath);
+		}
+	}
+
+	bool AssetPackBuilder::Write(const std::filesystem::path& filepath)
+	{
+		std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			NB_CORE_ERROR("Failed to create asset pack: {0}", filepath.string());
+			return false;
+		}
+
+		uint32_t alignment = std::max<uint32_t>(m_Alignment, 1);
+		auto pad = [&out](uint64_t boundary)
+		{
+			static const char zeros[64] = {};
+			uint64_t position = (uint64_t)out.tellp();
+			uint64_t padding = (boundary - position % boundary) % boundary;
+			while (padding > 0)
+			{
+				uint64_t count = std::min<uint64_t>(padding, sizeof(zeros));
+				out.write(zeros, (std::streamsize)count);
+				padding -= count;
+			}
+		};
+
+		AssetPackHeader header;
+		header.Alignment = alignment;
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		std::vector<AssetPackEntry> entries;
+		std::string strings;
+		std::unordered_set<std::string> written;
+		std::vector<char> data;
+		std::vector<uint8_t> compressed;
+		uint64_t totalSize = 0, totalStored = 0;
+
+		for (const PendingFile& file : m_Files)
+		{
+			std::string path = AssetPack::NormalizePath(file.VirtualPath);
+			if (!written.insert(path).second)
+			{
+				NB_CORE_WARN("Asset pack already contains {0}, skipping {1}", path, file.DiskPath.string());
+				continue;
+			}
+
+			std::ifstream in(file.DiskPath, std::ios::binary | std::ios::ate);
+			if (!in)
+			{
+				NB_CORE_ERROR("Failed to read file for asset pack: {0}", file.DiskPath.string());
+				return false;
+			}
+			data.resize((size_t)in.tellg());
+			in.seekg(0);
+			in.read(data.data(), (std::streamsize)data.size());
+
+			AssetPackEntry entry;
+			entry.PathHash = AssetPack::HashPath(path);
+			entry.Size = data.size();
+			entry.PathOffset = (uint32_t)strings.size();
+			entry.PathLength = (uint32_t)path.size();
+			strings += path;
+
+			const char* stored = data.data();
+			entry.StoredSize = data.size();
+
+			// Already compressed formats (png, mp3...) don't shrink and stay mappable
+			if (m_CompressionThreshold > 0.0f && !data.empty() && !IsStreamedAudio(path))
+			{
+				compressed.resize(LZ4::CompressBound(data.size()));
+				size_t compressedSize = LZ4::Compress(reinterpret_cast<const uint8_t*>(data.data()), data.size(), compressed.data());
+				if ((float)compressedSize <= (float)data.size() * (1.0f - m_CompressionThreshold))
+				{
+					stored = reinterpret_cast<const char*>(compressed.data());
+					entry.StoredSize = compressedSize;
+					entry.Compression = AssetPackCompression::LZ4;
+				}
+			}
+
+			pad(alignment);
+			entry.Offset = (uint64_t)out.tellp();
+			out.write(stored, (std::streamsize)entry.StoredSize);
+			entries.push_back(entry);
+
+			totalSize += entry.Size;
+			totalStored += entry.StoredSize;
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const AssetPackEntry& a, const AssetPackEntry& b) { return a.PathHash < b.PathHash; });
+
+		pad(alignof(AssetPackEntry));
+		header.EntryCount = (uint32_t)entries.size();
+		header.TocOffset = (uint64_t)out.tellp();
+		out.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(AssetPackEntry)));
+
+		header.StringsOffset = (uint64_t)out.tellp();
+		header.StringsSize = strings.size();
+		out.write(strings.data(), (std::streamsize)strings.size());
+
+		out.seekp(0);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		if (!out)
+		{
+			NB_CORE_ERROR("Failed to write asset pack: {0}", filepath.string());
+			return false;
+		}
+
+		NB_CORE_INFO("Wrote asset pack: {0} ({1} files, {2} KB stored of {3} KB)", filepath.string(), entries.size(), totalStored / 1024, totalSize / 1024);
+		return true;
+	}
+
+}
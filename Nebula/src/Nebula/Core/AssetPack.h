@@ -0,0 +1,110 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nebula {
+
+	// .nbpak layout, little endian:
+	//   AssetPackHeader
+	//   entry data, each entry aligned to the header's Alignment
+	//   AssetPackEntry[EntryCount], sorted by PathHash
+	//   path strings (normalized, not null terminated)
+	struct AssetPackHeader
+	{
+		char Magic[4] = { 'N', 'B', 'P', 'K' };
+		uint32_t Version = 1;
+		uint32_t EntryCount = 0;
+		uint32_t Alignment = 16;
+		uint64_t TocOffset = 0;
+		uint64_t StringsOffset = 0;
+		uint64_t StringsSize = 0;
+	};
+
+	enum class AssetPackCompression : uint32_t
+	{
+		None = 0,
+		LZ4 = 1
+	};
+
+	struct AssetPackEntry
+	{
+		uint64_t PathHash = 0;
+		uint64_t Offset = 0;
+		uint64_t StoredSize = 0; // Bytes in the pack
+		uint64_t Size = 0;       // Bytes once decompressed
+		uint32_t PathOffset = 0; // Into the string table
+		uint32_t PathLength = 0;
+		AssetPackCompression Compression = AssetPackCompression::None;
+		uint32_t Reserved = 0;
+	};
+
+	class MappedFile;
+
+	// A mounted pack. The whole file is memory mapped, uncompressed entries are
+	// handed out as pointers into the mapping.
+	class NEBULA_API AssetPack
+	{
+	public:
+		~AssetPack();
+
+		static std::shared_ptr<AssetPack> Open(const std::filesystem::path& filepath);
+
+		// path must already be normalized (see NormalizePath)
+		const AssetPackEntry* FindEntry(const std::string& path) const;
+		const uint8_t* GetStoredData(const AssetPackEntry& entry) const { return m_Base + entry.Offset; }
+		std::string GetEntryPath(const AssetPackEntry& entry) const;
+
+		const std::filesystem::path& GetFilePath() const { return m_FilePath; }
+		uint32_t GetEntryCount() const { return m_Header.EntryCount; }
+
+		// Forward slashes, lowercase, no leading "./". Packs are looked up case-insensitively like the Windows file system.
+		static std::string NormalizePath(const std::string& path);
+		static uint64_t HashPath(const std::string& normalizedPath);
+
+	private:
+		AssetPack() = default;
+
+	private:
+		std::filesystem::path m_FilePath;
+		std::unique_ptr<MappedFile> m_File;
+		const uint8_t* m_Base = nullptr;
+		AssetPackHeader m_Header;
+		const AssetPackEntry* m_Entries = nullptr;
+		const char* m_Strings = nullptr;
+	};
+
+	// Writes .nbpak files
+	class NEBULA_API AssetPackBuilder
+	{
+	public:
+		// Entries are compressed with LZ4 when that saves at least this fraction, set 0 to never compress
+		void SetCompressionThreshold(float savedFraction) { m_CompressionThreshold = savedFraction; }
+		void SetAlignment(uint32_t alignment) { m_Alignment = alignment; }
+
+		// virtualPath is what the game asks for, e.g. "Assets/Textures/Grass.png"
+		void AddFile(const std::filesystem::path& diskPath, const std::string& virtualPath);
+		// Every file under directory, named virtualRoot + its relative path
+		void AddDirectory(const std::filesystem::path& directory, const std::string& virtualRoot);
+
+		bool Write(const std::filesystem::path& filepath);
+
+		size_t GetFileCount() const { return m_Files.size(); }
+
+	private:
+		struct PendingFile
+		{
+			std::filesystem::path DiskPath;
+			std::string VirtualPath;
+		};
+
+		std::vector<PendingFile> m_Files;
+		float m_CompressionThreshold = 0.1f;
+		uint32_t m_Alignment = 16;
+	};
+
+}
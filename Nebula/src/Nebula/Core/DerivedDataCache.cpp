@@ -0,0 +1,426 @@
+#include "nbpch.h"
+#include "DerivedDataCache.h"
+#include "LZ4.h"
+#include "VirtualFileSystem.h"
+#include "Nebula/Log.h"
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Nebula {
+
+	// Entry file layout: DerivedDataHeader, then the payload (LZ4 block or raw)
+	struct DerivedDataHeader
+	{
+		char Magic[4] = { 'N', 'B', 'D', 'D' };
+		uint32_t Version = 1;
+		uint32_t Compression = 0; // 0 = none, 1 = LZ4
+		uint32_t Reserved = 0;
+		uint64_t Size = 0;
+		uint64_t StoredSize = 0;
+		uint64_t Checksum = 0; // Of the uncompressed payload, catches torn or stale files
+	};
+
+	// Size and write time a content hash was computed for
+	struct SourceStamp
+	{
+		uint64_t Size = 0;
+		int64_t WriteTime = 0;
+		uint64_t Hash = 0;
+	};
+
+	static std::mutex s_Mutex;
+	static std::filesystem::path s_Directory; // Empty = disabled
+	static std::unordered_map<std::string, SourceStamp> s_Index;
+	static bool s_IndexDirty = false;
+	static std::atomic<uint64_t> s_Hits{ 0 };
+	static std::atomic<uint64_t> s_Misses{ 0 };
+
+	static uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// 64-bit words at a time, source files can be large. Not cryptographic, only has to
+	// tell edits apart.
+	class ContentHasher
+	{
+	public:
+		explicit ContentHasher(uint64_t seed = 0) : m_Hash(seed ^ 0x9E3779B97F4A7C15ull) {}
+
+		// Splitting the same bytes into different chunks only hashes the same when every
+		// chunk but the last is a multiple of 8 bytes
+		void Update(const uint8_t* data, size_t size)
+		{
+			m_Length += size;
+			size_t words = size / 8;
+			for (size_t i = 0; i < words; i++)
+			{
+				uint64_t word;
+				memcpy(&word, data + i * 8, 8);
+				Mix(word);
+			}
+
+			uint64_t tail = 0;
+			for (size_t i = words * 8; i < size; i++)
+				tail = (tail << 8) | data[i];
+			if (size % 8)
+				Mix(tail);
+		}
+
+		void Update(const std::string& text) { Update(reinterpret_cast<const uint8_t*>(text.data()), text.size() + 1); }
+
+		uint64_t Finish() const
+		{
+			uint64_t hash = m_Hash ^ m_Length;
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+			hash *= 0xC4CEB9FE1A85EC53ull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+	private:
+		void Mix(uint64_t word)
+		{
+			word *= 0x87C37B91114253D5ull;
+			word = RotateLeft(word, 31);
+			word *= 0x4CF5AD432745937Full;
+			m_Hash ^= word;
+			m_Hash = RotateLeft(m_Hash, 27) * 5 + 0x52DCE729;
+		}
+
+		uint64_t m_Hash;
+		uint64_t m_Length = 0;
+	};
+
+	static bool HashFile(const std::filesystem::path& path, uint64_t& hash)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+			return false;
+
+		ContentHasher hasher;
+		std::vector<uint8_t> chunk(1 << 20);
+		while (in)
+		{
+			in.read(reinterpret_cast<char*>(chunk.data()), chunk.size());
+			std::streamsize read = in.gcount();
+			if (read > 0)
+				hasher.Update(chunk.data(), (size_t)read);
+		}
+		hash = hasher.Finish();
+		return true;
+	}
+
+	static std::filesystem::path GetDirectory()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return s_Directory;
+	}
+
+	// Two levels so no single directory ends up with every entry
+	static std::filesystem::path GetEntryPath(const std::filesystem::path& directory, const std::string& key)
+	{
+		return directory / key.substr(0, 2) / (key + ".nbdd");
+	}
+
+	// Concurrent writers of the same key each finish their own file, the last rename wins
+	static bool WriteFileAtomic(const std::filesystem::path& path, const void* header, size_t headerSize, const void* data, size_t size)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		std::filesystem::path temp = path;
+		temp += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+		{
+			std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+			if (!out)
+				return false;
+			if (header)
+				out.write(static_cast<const char*>(header), headerSize);
+			out.write(static_cast<const char*>(data), size);
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(temp, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temp, path, error);
+		if (error)
+		{
+			std::filesystem::remove(temp, error);
+			return false;
+		}
+		return true;
+	}
+
+	static void LoadIndex(const std::filesystem::path& directory)
+	{
+		std::ifstream in(directory / "index.json");
+		if (!in)
+			return;
+
+		nlohmann::json index = nlohmann::json::parse(in, nullptr, false);
+		if (index.is_discarded() || !index.contains("Files") || !index["Files"].is_object())
+		{
+			NB_CORE_WARN("Derived data index is corrupt, source files will be rehashed");
+			return;
+		}
+
+		for (auto& [path, entry] : index["Files"].items())
+		{
+			SourceStamp stamp;
+			stamp.Size = entry.value("Size", (uint64_t)0);
+			stamp.WriteTime = entry.value("WriteTime", (int64_t)0);
+			stamp.Hash = entry.value("Hash", (uint64_t)0);
+			s_Index[path] = stamp;
+		}
+	}
+
+	// Expects s_Mutex to be held
+	static void SaveIndex()
+	{
+		if (s_Directory.empty() || !s_IndexDirty)
+			return;
+
+		nlohmann::json files = nlohmann::json::object();
+		for (auto& [path, stamp] : s_Index)
+			files[path] = { { "Size", stamp.Size }, { "WriteTime", stamp.WriteTime }, { "Hash", stamp.Hash } };
+
+		nlohmann::json index;
+		index["Files"] = std::move(files);
+		std::string text = index.dump();
+		if (WriteFileAtomic(s_Directory / "index.json", nullptr, 0, text.data(), text.size()))
+			s_IndexDirty = false;
+		else
+			NB_CORE_WARN("Failed to write derived data index: {0}", (s_Directory / "index.json").string());
+	}
+
+	void DerivedDataCache::Init(const std::filesystem::path& directory)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (s_Directory == directory)
+			return;
+
+		SaveIndex();
+		s_Index.clear();
+		s_IndexDirty = false;
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error)
+		{
+			NB_CORE_ERROR("Failed to create derived data cache at {0}: {1}", directory.string(), error.message());
+			s_Directory.clear();
+			return;
+		}
+
+		s_Directory = directory;
+		LoadIndex(directory);
+		NB_CORE_INFO("Derived data cache: {0} ({1} known source files)", directory.string(), s_Index.size());
+	}
+
+	void DerivedDataCache::Shutdown()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		SaveIndex();
+		s_Index.clear();
+		s_Directory.clear();
+	}
+
+	bool DerivedDataCache::IsEnabled()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return !s_Directory.empty();
+	}
+
+	std::string DerivedDataCache::GetKey(const std::string& sourcePath, const char* format, uint32_t version, const std::string& settings)
+	{
+		// With packs mounted the loose file may not be what actually gets read
+		if (!IsEnabled() || VirtualFileSystem::HasMountedPacks())
+			return "";
+
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(sourcePath, error);
+		if (error)
+			return "";
+		int64_t writeTime = (int64_t)std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+		if (error)
+			return "";
+
+		uint64_t contentHash = 0;
+		bool known = false;
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			auto it = s_Index.find(sourcePath);
+			if (it != s_Index.end() && it->second.Size == size && it->second.WriteTime == writeTime)
+			{
+				contentHash = it->second.Hash;
+				known = true;
+			}
+		}
+
+		// New or touched since it was last hashed. A touched file with the same content
+		// still hashes the same, so its entries stay valid.
+		if (!known)
+		{
+			if (!HashFile(sourcePath, contentHash))
+				return "";
+
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_Index[sourcePath] = { size, writeTime, contentHash };
+			s_IndexDirty = true;
+		}
+
+		ContentHasher keyHasher(contentHash);
+		keyHasher.Update(format);
+		keyHasher.Update(std::to_string(version));
+		keyHasher.Update(settings);
+
+		char key[17];
+		snprintf(key, sizeof(key), "%016llx", (unsigned long long)keyHasher.Finish());
+		return key;
+	}
+
+	bool DerivedDataCache::Load(const std::string& key, std::vector<uint8_t>& data)
+	{
+		std::filesystem::path directory = GetDirectory();
+		if (key.empty() || directory.empty())
+			return false;
+
+		std::filesystem::path path = GetEntryPath(directory, key);
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+		{
+			s_Misses++;
+			return false;
+		}
+
+		DerivedDataHeader expected;
+		DerivedDataHeader header;
+		in.read(reinterpret_cast<char*>(&header), sizeof(header));
+		bool valid = in && memcmp(header.Magic, expected.Magic, 4) == 0 && header.Version == expected.Version &&
+			header.Compression <= 1 && (header.Compression == 1 || header.StoredSize == header.Size);
+
+		// Check the sizes before allocating anything, a torn or garbage file can claim gigabytes.
+		// The payload is the rest of the file, and an LZ4 block never expands more than 255 times.
+		if (valid)
+		{
+			std::error_code error;
+			uint64_t fileSize = std::filesystem::file_size(path, error);
+			valid = !error && fileSize >= sizeof(header) && header.StoredSize == fileSize - sizeof(header);
+		}
+		if (valid && header.Compression == 1)
+			valid = header.StoredSize < header.Size && header.Size / 255 <= header.StoredSize;
+
+		std::vector<uint8_t> stored;
+		if (valid)
+		{
+			stored.resize((size_t)header.StoredSize);
+			in.read(reinterpret_cast<char*>(stored.data()), stored.size());
+			valid = (bool)in;
+		}
+
+		if (valid && header.Compression == 1)
+		{
+			data.resize((size_t)header.Size);
+			valid = LZ4::Decompress(stored.data(), stored.size(), data.data(), data.size());
+		}
+		else if (valid)
+		{
+			data = std::move(stored);
+		}
+
+		if (valid)
+		{
+			ContentHasher hasher;
+			hasher.Update(data.data(), data.size());
+			valid = hasher.Finish() == header.Checksum;
+		}
+
+		if (!valid)
+		{
+			NB_CORE_WARN("Discarding corrupt derived data entry: {0}", path.string());
+			in.close();
+			std::error_code error;
+			std::filesystem::remove(path, error);
+			data.clear();
+			s_Misses++;
+			return false;
+		}
+
+		s_Hits++;
+		return true;
+	}
+
+	void DerivedDataCache::Store(const std::string& key, const void* data, size_t size)
+	{
+		std::filesystem::path directory = GetDirectory();
+		if (key.empty() || directory.empty())
+			return;
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		DerivedDataHeader header;
+		header.Size = size;
+
+		ContentHasher hasher;
+		hasher.Update(bytes, size);
+		header.Checksum = hasher.Finish();
+
+		// Same rule as asset packs: only keep the compressed form when it saves at least 10%
+		std::vector<uint8_t> compressed(LZ4::CompressBound(size));
+		size_t compressedSize = LZ4::Compress(bytes, size, compressed.data());
+		if (compressedSize < size - size / 10)
+		{
+			header.Compression = 1;
+			bytes = compressed.data();
+			size = compressedSize;
+		}
+		header.StoredSize = size;
+
+		std::filesystem::path path = GetEntryPath(directory, key);
+		if (!WriteFileAtomic(path, &header, sizeof(header), bytes, size))
+			NB_CORE_WARN("Failed to write derived data entry: {0}", path.string());
+	}
+
+	void DerivedDataCache::Clear()
+	{
+		std::filesystem::path directory = GetDirectory();
+		if (directory.empty())
+			return;
+
+		// Entries only, the content hash index is still right
+		std::error_code error;
+		for (auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			if (entry.is_directory(error))
+				std::filesystem::remove_all(entry.path(), error);
+		}
+		NB_CORE_INFO("Cleared derived data cache: {0}", directory.string());
+	}
+
+	void DerivedDataCache::Flush()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		SaveIndex();
+	}
+
+	uint64_t DerivedDataCache::GetHitCount()
+	{
+		return s_Hits;
+	}
+
+	uint64_t DerivedDataCache::GetMissCount()
+	{
+		return s_Misses;
+	}
+
+}
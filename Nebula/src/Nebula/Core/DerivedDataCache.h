@@ -0,0 +1,42 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Nebula {
+
+	// On-disk cache of processed asset data (decoded textures, parsed meshes, linked
+	// shader binaries). Entries are keyed by the source file's content hash plus the
+	// producer's format name, version and settings, so anything whose inputs didn't
+	// change is loaded straight from the cache. Content hashes are remembered by file
+	// size and write time, so unchanged files aren't even read to build a key.
+	//
+	// Disabled until Init(). Safe to use from any thread.
+	class NEBULA_API DerivedDataCache
+	{
+	public:
+		// Switching directories saves the previous one's index first
+		static void Init(const std::filesystem::path& directory);
+		static void Shutdown();
+		static bool IsEnabled();
+
+		// Empty when the cache is disabled or the source isn't a loose file (packed games
+		// ship already processed data). Bump version whenever the producer's output changes.
+		static std::string GetKey(const std::string& sourcePath, const char* format, uint32_t version, const std::string& settings = "");
+
+		static bool Load(const std::string& key, std::vector<uint8_t>& data);
+		static void Store(const std::string& key, const void* data, size_t size);
+
+		// Deletes every entry
+		static void Clear();
+		// Writes the content hash index, also done by Shutdown()
+		static void Flush();
+
+		static uint64_t GetHitCount();
+		static uint64_t GetMissCount();
+	};
+
+}
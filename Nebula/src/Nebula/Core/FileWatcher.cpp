@@ -0,0 +1,546 @@
+#include "nbpch.h"
+#include "FileWatcher.h"
+#include "Nebula/Log.h"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace Nebula {
+
+	using WatchClock = std::chrono::steady_clock;
+
+	struct SnapshotEntry
+	{
+		std::filesystem::file_time_type WriteTime;
+		bool IsDirectory = false;
+	};
+
+	// One subscriber
+	struct WatchEntry
+	{
+		std::filesystem::path Directory; // As passed to Watch(), reported paths start with it
+		std::filesystem::path Canonical;
+		FileWatchCallback Callback;
+		std::vector<std::string> Extensions;
+		bool Recursive = true;
+		std::string Root;
+	};
+
+	// One OS watch (or scan) shared by every subscriber at or below its directory
+	struct WatchRoot
+	{
+		std::filesystem::path Directory; // Canonical
+		bool Recursive = true;
+		std::vector<FileWatchID> Subscribers;
+
+		// Only used when the directory can't be watched by the OS
+		bool Polling = true;
+		std::unordered_map<std::string, SnapshotEntry> Snapshot;
+
+#ifdef NB_PLATFORM_WINDOWS
+		HANDLE Handle = INVALID_HANDLE_VALUE;
+		OVERLAPPED Overlapped = {};
+		std::vector<DWORD> Buffer; // DWORD aligned, as ReadDirectoryChangesW requires
+#endif
+	};
+
+	struct PendingChange
+	{
+		FileWatchChange Change;
+		WatchClock::time_point LastSeen;
+	};
+
+	struct FileWatcherData
+	{
+		std::mutex Mutex;
+		std::unordered_map<FileWatchID, WatchEntry> Watches;
+		// Keyed by canonical directory. Pointers stay put, the OS writes into OVERLAPPED while they live.
+		std::unordered_map<std::string, std::unique_ptr<WatchRoot>> Roots;
+		std::unordered_map<FileWatchID, std::unordered_map<std::string, PendingChange>> Pending;
+		FileWatchID NextID = 1;
+
+		float DebounceTime = 0.2f;
+		float PollInterval = 0.5f;
+
+		std::thread Thread;
+		std::atomic<bool> Running = false;
+	};
+
+	static FileWatcherData* s_WatcherData = nullptr;
+
+	static constexpr auto s_EventPollInterval = std::chrono::milliseconds(50);
+
+	static bool MatchesFilter(const WatchEntry& watch, const std::filesystem::path& path, bool isDirectory)
+	{
+		if (watch.Extensions.empty())
+			return true;
+		if (isDirectory)
+			return false;
+
+		std::string extension = path.extension().string();
+		return std::find(watch.Extensions.begin(), watch.Extensions.end(), extension) != watch.Extensions.end();
+	}
+
+	// Caller holds the mutex. Collapses repeated events on the same path so a
+	// create followed by several writes is reported once as Added.
+	static void QueueChange(FileWatchID id, const std::filesystem::path& path, FileWatchEvent event, bool isDirectory)
+	{
+		auto& pending = s_WatcherData->Pending[id];
+		std::string key = path.string();
+
+		auto it = pending.find(key);
+		if (it == pending.end())
+		{
+			pending[key] = { { path, event, isDirectory }, WatchClock::now() };
+			return;
+		}
+
+		FileWatchEvent previous = it->second.Change.Event;
+		if (previous == FileWatchEvent::Added && event == FileWatchEvent::Removed)
+		{
+			pending.erase(it);
+			return;
+		}
+
+		if (previous == FileWatchEvent::Added && event == FileWatchEvent::Modified)
+			event = FileWatchEvent::Added;
+		else if (previous == FileWatchEvent::Removed && event == FileWatchEvent::Added)
+			event = FileWatchEvent::Modified;
+
+		it->second.Change.Event = event;
+		it->second.Change.IsDirectory = isDirectory;
+		it->second.LastSeen = WatchClock::now();
+	}
+
+	static std::unordered_map<std::string, SnapshotEntry> ScanDirectory(const std::filesystem::path& directory, bool recursive)
+	{
+		std::unordered_map<std::string, SnapshotEntry> snapshot;
+		std::error_code ec;
+
+		auto record = [&](const std::filesystem::directory_entry& entry)
+		{
+			std::error_code entryEc;
+			SnapshotEntry snap;
+			snap.IsDirectory = entry.is_directory(entryEc);
+			snap.WriteTime = entry.last_write_time(entryEc);
+			snapshot[entry.path().string()] = snap;
+		};
+
+		if (recursive)
+		{
+			for (auto it = std::filesystem::recursive_directory_iterator(directory, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+				record(*it);
+		}
+		else
+		{
+			for (auto it = std::filesystem::directory_iterator(directory, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+				record(*it);
+		}
+
+		return snapshot;
+	}
+
+	// Caller holds the mutex. Hands a change under a root to the subscribers that cover it.
+	static void DispatchChange(const WatchRoot& root, const std::filesystem::path& path, FileWatchEvent event, bool isDirectory)
+	{
+		for (FileWatchID id : root.Subscribers)
+		{
+			auto watchIt = s_WatcherData->Watches.find(id);
+			if (watchIt == s_WatcherData->Watches.end())
+				continue;
+
+			const WatchEntry& watch = watchIt->second;
+			std::filesystem::path relative = path.lexically_relative(watch.Canonical);
+			if (relative.empty() || relative == "." || *relative.begin() == "..")
+				continue;
+			if (!watch.Recursive && std::next(relative.begin()) != relative.end())
+				continue;
+
+			std::filesystem::path reported = watch.Directory / relative;
+			if (MatchesFilter(watch, reported, isDirectory))
+				QueueChange(id, reported, event, isDirectory);
+		}
+	}
+
+	static void StartPolling(WatchRoot& root)
+	{
+		root.Polling = true;
+		root.Snapshot = ScanDirectory(root.Directory, root.Recursive);
+	}
+
+#ifdef NB_PLATFORM_WINDOWS
+	static bool ArmRoot(WatchRoot& root)
+	{
+		DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_CREATION;
+		return ReadDirectoryChangesW(root.Handle, root.Buffer.data(), (DWORD)(root.Buffer.size() * sizeof(DWORD)),
+			root.Recursive ? TRUE : FALSE, filter, nullptr, &root.Overlapped, nullptr) != 0;
+	}
+
+	static void CloseRoot(WatchRoot& root)
+	{
+		if (root.Handle == INVALID_HANDLE_VALUE)
+			return;
+
+		// The read still owns the buffer until the cancellation completes
+		DWORD bytes = 0;
+		CancelIoEx(root.Handle, &root.Overlapped);
+		GetOverlappedResult(root.Handle, &root.Overlapped, &bytes, TRUE);
+		CloseHandle(root.Handle);
+		root.Handle = INVALID_HANDLE_VALUE;
+	}
+
+	static void OpenRoot(WatchRoot& root)
+	{
+		root.Handle = CreateFileW(root.Directory.wstring().c_str(), FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (root.Handle != INVALID_HANDLE_VALUE)
+		{
+			// 64 KB is the most ReadDirectoryChangesW takes on network shares
+			root.Buffer.resize(64 * 1024 / sizeof(DWORD));
+			if (ArmRoot(root))
+			{
+				root.Polling = false;
+				return;
+			}
+			CloseHandle(root.Handle);
+			root.Handle = INVALID_HANDLE_VALUE;
+		}
+
+		NB_CORE_WARN("FileWatcher: can't watch {0} for changes, scanning it instead", root.Directory.string());
+		StartPolling(root);
+	}
+
+	// Caller holds the mutex
+	static void ReadRootChanges(WatchRoot& root)
+	{
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(root.Handle, &root.Overlapped, &bytes, FALSE))
+		{
+			if (GetLastError() == ERROR_IO_INCOMPLETE)
+				return;
+
+			// The directory went away or the handle broke, scan whatever is left from now on
+			CloseRoot(root);
+			StartPolling(root);
+			return;
+		}
+
+		if (bytes == 0)
+			NB_CORE_WARN("FileWatcher: too many changes at once under {0}, some were missed", root.Directory.string());
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(root.Buffer.data());
+		for (DWORD offset = 0; bytes > 0;)
+		{
+			const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data + offset);
+			std::filesystem::path path = root.Directory / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR));
+
+			FileWatchEvent event = FileWatchEvent::Modified;
+			if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+				event = FileWatchEvent::Added;
+			else if (info->Action == FILE_ACTION_REMOVED || info->Action == FILE_ACTION_RENAMED_OLD_NAME)
+				event = FileWatchEvent::Removed;
+
+			// Removed paths can't be looked at anymore, they are reported as files
+			std::error_code error;
+			bool isDirectory = event != FileWatchEvent::Removed && std::filesystem::is_directory(path, error);
+
+			// A directory is "modified" whenever something inside it changes, that is reported on its own
+			if (!(isDirectory && event == FileWatchEvent::Modified))
+				DispatchChange(root, path, event, isDirectory);
+
+			if (info->NextEntryOffset == 0)
+				break;
+			offset += info->NextEntryOffset;
+		}
+
+		if (!ArmRoot(root))
+		{
+			CloseRoot(root);
+			StartPolling(root);
+		}
+	}
+#else
+	static void OpenRoot(WatchRoot& root)
+	{
+		StartPolling(root);
+	}
+
+	static void CloseRoot(WatchRoot&)
+	{
+	}
+#endif
+
+	// Scans the roots that have no OS watch and reports the differences to the last scan
+	static void PollRoots()
+	{
+		std::vector<std::pair<std::string, bool>> targets;
+		{
+			std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+			for (auto& [key, root] : s_WatcherData->Roots)
+			{
+				if (root->Polling)
+					targets.push_back({ key, root->Recursive });
+			}
+		}
+
+		// The scan itself runs without holding the lock
+		for (const auto& [key, recursive] : targets)
+		{
+			auto snapshot = ScanDirectory(key, recursive);
+
+			std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+			auto rootIt = s_WatcherData->Roots.find(key);
+			if (rootIt == s_WatcherData->Roots.end() || !rootIt->second->Polling || rootIt->second->Recursive != recursive)
+				continue;
+
+			WatchRoot& root = *rootIt->second;
+			for (const auto& [path, entry] : snapshot)
+			{
+				auto oldIt = root.Snapshot.find(path);
+				if (oldIt == root.Snapshot.end())
+					DispatchChange(root, path, FileWatchEvent::Added, entry.IsDirectory);
+				else if (!entry.IsDirectory && oldIt->second.WriteTime != entry.WriteTime)
+					DispatchChange(root, path, FileWatchEvent::Modified, false);
+			}
+			for (const auto& [path, entry] : root.Snapshot)
+			{
+				if (snapshot.find(path) == snapshot.end())
+					DispatchChange(root, path, FileWatchEvent::Removed, entry.IsDirectory);
+			}
+
+			root.Snapshot = std::move(snapshot);
+		}
+	}
+
+	static void WatcherThread()
+	{
+		auto nextScan = WatchClock::now();
+
+		while (s_WatcherData->Running)
+		{
+			std::this_thread::sleep_for(s_EventPollInterval);
+
+#ifdef NB_PLATFORM_WINDOWS
+			{
+				std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+				for (auto& [key, root] : s_WatcherData->Roots)
+				{
+					if (!root->Polling)
+						ReadRootChanges(*root);
+				}
+			}
+#endif
+
+			if (WatchClock::now() < nextScan)
+				continue;
+
+			{
+				std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+				nextScan = WatchClock::now() + std::chrono::milliseconds((int)(s_WatcherData->PollInterval * 1000.0f));
+			}
+			PollRoots();
+		}
+	}
+
+	// Caller holds the mutex. Finds the root that already covers a directory, or
+	// opens one and moves every subscriber it now covers over to it.
+	static WatchRoot& AcquireRoot(const std::filesystem::path& directory, bool recursive)
+	{
+		for (auto& [key, root] : s_WatcherData->Roots)
+		{
+			if (root->Directory == directory && (root->Recursive || !recursive))
+				return *root;
+
+			std::filesystem::path relative = directory.lexically_relative(root->Directory);
+			if (root->Recursive && !relative.empty() && *relative.begin() != "..")
+				return *root;
+		}
+
+		auto newRoot = std::make_unique<WatchRoot>();
+		newRoot->Directory = directory;
+		newRoot->Recursive = recursive;
+		OpenRoot(*newRoot);
+		WatchRoot& root = *newRoot;
+
+		for (auto it = s_WatcherData->Roots.begin(); it != s_WatcherData->Roots.end();)
+		{
+			WatchRoot& other = *it->second;
+			std::filesystem::path relative = other.Directory.lexically_relative(directory);
+			bool covered = other.Directory == directory || (recursive && !relative.empty() && *relative.begin() != "..");
+			if (!covered)
+			{
+				++it;
+				continue;
+			}
+
+			for (FileWatchID id : other.Subscribers)
+			{
+				root.Subscribers.push_back(id);
+				s_WatcherData->Watches[id].Root = directory.string();
+			}
+			CloseRoot(other);
+			it = s_WatcherData->Roots.erase(it);
+		}
+
+		s_WatcherData->Roots[directory.string()] = std::move(newRoot);
+		return root;
+	}
+
+	void FileWatcher::Init()
+	{
+		if (s_WatcherData)
+			return;
+
+		s_WatcherData = new FileWatcherData();
+		s_WatcherData->Running = true;
+		s_WatcherData->Thread = std::thread(WatcherThread);
+		NB_CORE_INFO("FileWatcher initialized");
+	}
+
+	void FileWatcher::Shutdown()
+	{
+		if (!s_WatcherData)
+			return;
+
+		s_WatcherData->Running = false;
+		if (s_WatcherData->Thread.joinable())
+			s_WatcherData->Thread.join();
+
+		for (auto& [key, root] : s_WatcherData->Roots)
+			CloseRoot(*root);
+
+		delete s_WatcherData;
+		s_WatcherData = nullptr;
+	}
+
+	FileWatchID FileWatcher::Watch(const std::filesystem::path& directory, FileWatchCallback callback,
+		const std::vector<std::string>& extensions, bool recursive)
+	{
+		if (!s_WatcherData)
+		{
+			NB_CORE_ERROR("FileWatcher not initialized!");
+			return 0;
+		}
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			NB_CORE_WARN("FileWatcher: {0} is not a directory", directory.string());
+			return 0;
+		}
+
+		WatchEntry watch;
+		watch.Directory = directory;
+		watch.Canonical = std::filesystem::weakly_canonical(directory, error);
+		if (error)
+			watch.Canonical = std::filesystem::absolute(directory).lexically_normal();
+		watch.Callback = callback;
+		watch.Extensions = extensions;
+		watch.Recursive = recursive;
+
+		std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+		FileWatchID id = s_WatcherData->NextID++;
+		s_WatcherData->Watches[id] = std::move(watch);
+
+		WatchRoot& root = AcquireRoot(s_WatcherData->Watches[id].Canonical, recursive);
+		root.Subscribers.push_back(id);
+		s_WatcherData->Watches[id].Root = root.Directory.string();
+		return id;
+	}
+
+	void FileWatcher::Unwatch(FileWatchID id)
+	{
+		if (!s_WatcherData || id == 0)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+		auto watchIt = s_WatcherData->Watches.find(id);
+		if (watchIt == s_WatcherData->Watches.end())
+			return;
+
+		// The last subscriber closes the root, a wider root stays wide until then
+		auto rootIt = s_WatcherData->Roots.find(watchIt->second.Root);
+		if (rootIt != s_WatcherData->Roots.end())
+		{
+			auto& subscribers = rootIt->second->Subscribers;
+			subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), id), subscribers.end());
+			if (subscribers.empty())
+			{
+				CloseRoot(*rootIt->second);
+				s_WatcherData->Roots.erase(rootIt);
+			}
+		}
+
+		s_WatcherData->Watches.erase(watchIt);
+		s_WatcherData->Pending.erase(id);
+	}
+
+	void FileWatcher::Update()
+	{
+		if (!s_WatcherData)
+			return;
+
+		std::vector<std::pair<FileWatchCallback, std::vector<FileWatchChange>>> batches;
+		{
+			std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+			if (s_WatcherData->Pending.empty())
+				return;
+
+			auto now = WatchClock::now();
+			auto debounce = std::chrono::duration<float>(s_WatcherData->DebounceTime);
+
+			for (auto it = s_WatcherData->Pending.begin(); it != s_WatcherData->Pending.end();)
+			{
+				std::vector<FileWatchChange> ready;
+				auto& pending = it->second;
+				for (auto changeIt = pending.begin(); changeIt != pending.end();)
+				{
+					if (now - changeIt->second.LastSeen >= debounce)
+					{
+						ready.push_back(changeIt->second.Change);
+						changeIt = pending.erase(changeIt);
+					}
+					else
+					{
+						++changeIt;
+					}
+				}
+
+				auto watchIt = s_WatcherData->Watches.find(it->first);
+				if (!ready.empty() && watchIt != s_WatcherData->Watches.end() && watchIt->second.Callback)
+					batches.push_back({ watchIt->second.Callback, std::move(ready) });
+
+				if (pending.empty())
+					it = s_WatcherData->Pending.erase(it);
+				else
+					++it;
+			}
+		}
+
+		// Callbacks run unlocked so they are free to Watch/Unwatch
+		for (auto& [callback, changes] : batches)
+			callback(changes);
+	}
+
+	void FileWatcher::SetDebounceTime(float seconds)
+	{
+		if (!s_WatcherData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+		s_WatcherData->DebounceTime = seconds;
+	}
+
+	void FileWatcher::SetPollInterval(float seconds)
+	{
+		if (!s_WatcherData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_WatcherData->Mutex);
+		s_WatcherData->PollInterval = seconds;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <filesystem>
+
+namespace Nebula {
+
+	enum class FileWatchEvent
+	{
+		Added = 0,
+		Modified,
+		Removed
+	};
+
+	struct FileWatchChange
+	{
+		std::filesystem::path Path;
+		FileWatchEvent Event = FileWatchEvent::Modified;
+		bool IsDirectory = false;
+	};
+
+	using FileWatchID = uint32_t;
+	using FileWatchCallback = std::function<void(const std::vector<FileWatchChange>&)>;
+
+	// Watches directories on a background thread (ReadDirectoryChangesW on Windows,
+	// a timed directory scan where that isn't available) and hands debounced batches
+	// of changes to subscribers from Update(), which runs on the main thread.
+	// Subscriptions at or below a recursively watched directory share its watch.
+	class NEBULA_API FileWatcher
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// Subscribe to changes under a directory. An empty extension list means every file
+		// (and directory) is reported; otherwise only files with a matching extension are.
+		static FileWatchID Watch(const std::filesystem::path& directory, FileWatchCallback callback,
+			const std::vector<std::string>& extensions = {}, bool recursive = true);
+		static void Unwatch(FileWatchID id);
+
+		// Delivers every change that has been quiet for at least the debounce time
+		static void Update();
+
+		// How long a path must stay unchanged before it is reported (editors often save in several steps)
+		static void SetDebounceTime(float seconds);
+		// How often directories without an OS watch are scanned
+		static void SetPollInterval(float seconds);
+	};
+
+}
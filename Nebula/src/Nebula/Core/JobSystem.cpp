@@ -0,0 +1,105 @@
+#include "nbpch.h"
+#include "JobSystem.h"
+#include "Nebula/Log.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace Nebula {
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Threads;
+		std::deque<std::packaged_task<void()>> Queue;
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		bool Running = false;
+	};
+
+	static JobSystemData* s_JobData = nullptr;
+
+	static void WorkerThread()
+	{
+		while (true)
+		{
+			std::packaged_task<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(s_JobData->Mutex);
+				s_JobData->Condition.wait(lock, []() { return !s_JobData->Running || !s_JobData->Queue.empty(); });
+
+				// Queued jobs still run on shutdown, someone may be waiting on their future
+				if (s_JobData->Queue.empty())
+					return;
+
+				task = std::move(s_JobData->Queue.front());
+				s_JobData->Queue.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	void JobSystem::Init(uint32_t threadCount)
+	{
+		if (s_JobData)
+			return;
+
+		if (threadCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_JobData = new JobSystemData();
+		s_JobData->Running = true;
+		for (uint32_t i = 0; i < threadCount; i++)
+			s_JobData->Threads.emplace_back(WorkerThread);
+
+		NB_CORE_INFO("JobSystem initialized with {0} worker threads", threadCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_JobData)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(s_JobData->Mutex);
+			s_JobData->Running = false;
+		}
+		s_JobData->Condition.notify_all();
+
+		for (std::thread& thread : s_JobData->Threads)
+			thread.join();
+
+		delete s_JobData;
+		s_JobData = nullptr;
+	}
+
+	std::future<void> JobSystem::Submit(Job job)
+	{
+		std::packaged_task<void()> task(std::move(job));
+		std::future<void> future = task.get_future();
+
+		if (!s_JobData)
+		{
+			task();
+			return future;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_JobData->Mutex);
+			s_JobData->Queue.push_back(std::move(task));
+		}
+		s_JobData->Condition.notify_one();
+		return future;
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return s_JobData ? (uint32_t)s_JobData->Threads.size() : 0;
+	}
+
+}
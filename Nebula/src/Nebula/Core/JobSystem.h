@@ -0,0 +1,29 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+
+#include <functional>
+#include <future>
+
+namespace Nebula {
+
+	using Job = std::function<void()>;
+
+	// Small pool of worker threads for loading work (file reads, decoding) that
+	// would otherwise stall a frame. Jobs must not touch GL or AL state; hand the
+	// result back and finish it on the main thread.
+	class NEBULA_API JobSystem
+	{
+	public:
+		// 0 threads = one per hardware thread, minus the main thread
+		static void Init(uint32_t threadCount = 0);
+		static void Shutdown();
+
+		// Runs the job on a worker. Without workers (not initialized) it runs right here.
+		static std::future<void> Submit(Job job);
+
+		static uint32_t GetThreadCount();
+	};
+
+}
@@ -0,0 +1,178 @@
+#include "nbpch.h"
+#include "LZ4.h"
+
+#include <cstring>
+#include <vector>
+
+namespace Nebula {
+
+	// Format limits: the last match starts at least 12 bytes before the end and
+	// the last 5 bytes are always literals
+	static constexpr size_t s_MinMatch = 4;
+	static constexpr size_t s_MatchFindLimit = 12;
+	static constexpr size_t s_LastLiterals = 5;
+	static constexpr size_t s_MaxOffset = 65535;
+	static constexpr uint32_t s_HashBits = 12;
+
+	static uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static uint32_t Hash(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - s_HashBits);
+	}
+
+	static uint8_t* WriteLength(uint8_t* op, size_t length)
+	{
+		while (length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = (uint8_t)length;
+		return op;
+	}
+
+	static uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		uint8_t* token = op++;
+		*token = (uint8_t)((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (literalLength >= 15)
+			op = WriteLength(op, literalLength - 15);
+
+		if (literalLength > 0)
+			std::memcpy(op, literals, literalLength);
+		op += literalLength;
+
+		// The final sequence is literals only
+		if (matchLength == 0)
+			return op;
+
+		*op++ = (uint8_t)(offset & 0xFF);
+		*op++ = (uint8_t)(offset >> 8);
+
+		size_t length = matchLength - s_MinMatch;
+		*token |= (uint8_t)(length >= 15 ? 15 : length);
+		if (length >= 15)
+			op = WriteLength(op, length - 15);
+		return op;
+	}
+
+	size_t LZ4::CompressBound(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	size_t LZ4::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst)
+	{
+		uint8_t* op = dst;
+		size_t anchor = 0;
+
+		if (srcSize > s_MatchFindLimit)
+		{
+			std::vector<int64_t> table((size_t)1 << s_HashBits, -1);
+			size_t matchLimit = srcSize - s_LastLiterals;
+			size_t ip = 0;
+
+			while (ip < srcSize - s_MatchFindLimit)
+			{
+				uint32_t sequence = Read32(src + ip);
+				uint32_t hash = Hash(sequence);
+				int64_t candidate = table[hash];
+				table[hash] = (int64_t)ip;
+
+				if (candidate < 0 || ip - (size_t)candidate > s_MaxOffset || Read32(src + candidate) != sequence)
+				{
+					ip++;
+					continue;
+				}
+
+				size_t match = (size_t)candidate;
+				size_t length = s_MinMatch;
+				while (ip + length < matchLimit && src[match + length] == src[ip + length])
+					length++;
+
+				op = WriteSequence(op, src + anchor, ip - anchor, ip - match, length);
+				ip += length;
+				anchor = ip;
+			}
+		}
+
+		op = WriteSequence(op, src + anchor, srcSize - anchor, 0, 0);
+		return (size_t)(op - dst);
+	}
+
+	bool LZ4::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+	{
+		const uint8_t* ip = src;
+		const uint8_t* inputEnd = src + srcSize;
+		uint8_t* op = dst;
+		uint8_t* outputEnd = dst + dstSize;
+
+		while (ip < inputEnd)
+		{
+			uint8_t token = *ip++;
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15)
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip >= inputEnd)
+						return false;
+					byte = *ip++;
+					literalLength += byte;
+				} while (byte == 255);
+			}
+
+			if ((size_t)(inputEnd - ip) < literalLength || (size_t)(outputEnd - op) < literalLength)
+				return false;
+			if (literalLength > 0)
+				std::memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// Last sequence
+			if (ip == inputEnd)
+				break;
+
+			if (inputEnd - ip < 2)
+				return false;
+			size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > (size_t)(op - dst))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15)
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip >= inputEnd)
+						return false;
+					byte = *ip++;
+					matchLength += byte;
+				} while (byte == 255);
+			}
+			matchLength += s_MinMatch;
+
+			if ((size_t)(outputEnd - op) < matchLength)
+				return false;
+
+			// Byte by byte, the match may overlap what it's writing
+			const uint8_t* match = op - offset;
+			for (size_t i = 0; i < matchLength; i++)
+				op[i] = match[i];
+			op += matchLength;
+		}
+
+		return op == outputEnd;
+	}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace Nebula {
+
+	// LZ4 block format (no frame header). Compatible with lz4's
+	// LZ4_decompress_safe / LZ4_compress_default, kept in tree for asset packs.
+	class NEBULA_API LZ4
+	{
+	public:
+		// Worst case compressed size for incompressible input
+		static size_t CompressBound(size_t size);
+		// Greedy single-pass compressor. dst needs CompressBound(srcSize) bytes. Returns the compressed size.
+		static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst);
+		// Fails on corrupt input instead of reading or writing out of bounds
+		static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+	};
+
+}
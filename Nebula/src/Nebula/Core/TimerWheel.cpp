@@ -0,0 +1,253 @@
+#include "nbpch.h"
+#include "TimerWheel.h"
+
+#include <cmath>
+
+namespace Nebula {
+
+	TimerWheel::TimerWheel(float tickSeconds)
+		: m_TickSeconds(tickSeconds > 0.0f ? tickSeconds : 0.001f)
+	{
+		std::fill(&m_Slots[0][0], &m_Slots[0][0] + s_LevelCount * s_SlotCount, s_InvalidNode);
+	}
+
+	TimerHandle TimerWheel::Schedule(float delaySeconds, TimerCallback callback, float intervalSeconds)
+	{
+		uint32_t index;
+		if (!m_FreeNodes.empty())
+		{
+			index = m_FreeNodes.back();
+			m_FreeNodes.pop_back();
+		}
+		else
+		{
+			index = (uint32_t)m_Nodes.size();
+			m_Nodes.emplace_back();
+		}
+
+		Node& node = m_Nodes[index];
+		node.Callback = std::move(callback);
+		node.Expires = m_CurrentTick + ToTicks(delaySeconds);
+		node.IntervalTicks = intervalSeconds > 0.0f ? std::max<uint64_t>(ToTicks(intervalSeconds), 1) : 0;
+		Insert(index);
+		m_PendingCount++;
+
+		return ((TimerHandle)node.Generation << 32) | index;
+	}
+
+	bool TimerWheel::Cancel(TimerHandle handle)
+	{
+		Node* node = Resolve(handle);
+		if (!node || !node->Slot)
+			return false;
+
+		uint32_t index = (uint32_t)(handle & 0xFFFFFFFF);
+		Unlink(index);
+		m_PendingCount--;
+
+		// Cancelling a repeating timer from its own callback, release once the callback returns
+		if (index == m_FiringNode)
+			m_ReleaseFiringNode = true;
+		else
+			Release(index);
+
+		return true;
+	}
+
+	bool TimerWheel::IsPending(TimerHandle handle) const
+	{
+		const Node* node = Resolve(handle);
+		return node && node->Slot;
+	}
+
+	void TimerWheel::Advance(float deltaSeconds)
+	{
+		if (deltaSeconds <= 0.0f)
+			return;
+
+		m_Accumulator += deltaSeconds;
+		uint64_t ticks = (uint64_t)(m_Accumulator / m_TickSeconds);
+		m_Accumulator -= (double)ticks * m_TickSeconds;
+
+		while (ticks > 0)
+		{
+			// Nothing scheduled, the slots are empty so the wheel can jump ahead
+			if (m_PendingCount == 0)
+			{
+				m_CurrentTick += ticks;
+				break;
+			}
+
+			ProcessTick();
+			ticks--;
+		}
+	}
+
+	void TimerWheel::Clear()
+	{
+		std::fill(&m_Slots[0][0], &m_Slots[0][0] + s_LevelCount * s_SlotCount, s_InvalidNode);
+		m_Expired = s_InvalidNode;
+
+		for (uint32_t i = 0; i < (uint32_t)m_Nodes.size(); i++)
+		{
+			if (m_Nodes[i].Slot)
+				Release(i);
+		}
+
+		m_PendingCount = 0;
+		m_Accumulator = 0.0;
+	}
+
+	uint64_t TimerWheel::ToTicks(float seconds) const
+	{
+		if (seconds <= 0.0f)
+			return 0;
+		return (uint64_t)std::ceil((double)seconds / m_TickSeconds);
+	}
+
+	void TimerWheel::Insert(uint32_t index)
+	{
+		Node& node = m_Nodes[index];
+
+		uint64_t maxDelta = ((uint64_t)1 << (s_SlotBits * s_LevelCount)) - 1;
+		if (node.Expires < m_CurrentTick)
+			node.Expires = m_CurrentTick;
+		if (node.Expires - m_CurrentTick > maxDelta)
+			node.Expires = m_CurrentTick + maxDelta;
+
+		// Pick the finest level whose span covers the delay
+		uint64_t delta = node.Expires - m_CurrentTick;
+		uint32_t level = 0;
+		while (level < s_LevelCount - 1 && delta >= ((uint64_t)1 << (s_SlotBits * (level + 1))))
+			level++;
+
+		uint32_t slot = (uint32_t)(node.Expires >> (s_SlotBits * level)) & s_SlotMask;
+		uint32_t* head = &m_Slots[level][slot];
+
+		node.Prev = s_InvalidNode;
+		node.Next = *head;
+		if (*head != s_InvalidNode)
+			m_Nodes[*head].Prev = index;
+		*head = index;
+		node.Slot = head;
+	}
+
+	void TimerWheel::Unlink(uint32_t index)
+	{
+		Node& node = m_Nodes[index];
+
+		if (node.Prev != s_InvalidNode)
+			m_Nodes[node.Prev].Next = node.Next;
+		else
+			*node.Slot = node.Next;
+
+		if (node.Next != s_InvalidNode)
+			m_Nodes[node.Next].Prev = node.Prev;
+
+		node.Prev = s_InvalidNode;
+		node.Next = s_InvalidNode;
+		node.Slot = nullptr;
+	}
+
+	void TimerWheel::Release(uint32_t index)
+	{
+		Node& node = m_Nodes[index];
+		node.Callback = nullptr;
+		node.Slot = nullptr;
+		node.Prev = s_InvalidNode;
+		node.Next = s_InvalidNode;
+
+		// Invalidates outstanding handles to this node
+		if (++node.Generation == 0)
+			node.Generation = 1;
+
+		m_FreeNodes.push_back(index);
+	}
+
+	void TimerWheel::Cascade(uint32_t level, uint32_t slot)
+	{
+		uint32_t index = m_Slots[level][slot];
+		m_Slots[level][slot] = s_InvalidNode;
+
+		while (index != s_InvalidNode)
+		{
+			uint32_t next = m_Nodes[index].Next;
+			Insert(index);
+			index = next;
+		}
+	}
+
+	void TimerWheel::ProcessTick()
+	{
+		uint64_t tick = m_CurrentTick;
+		uint32_t index = (uint32_t)tick & s_SlotMask;
+
+		// Level 0 wrapped, pull the next block of timers down from the coarser levels
+		if (index == 0)
+		{
+			for (uint32_t level = 1; level < s_LevelCount; level++)
+			{
+				uint32_t slot = (uint32_t)(tick >> (s_SlotBits * level)) & s_SlotMask;
+				Cascade(level, slot);
+				if (slot != 0)
+					break;
+			}
+		}
+
+		if (m_Slots[0][index] == s_InvalidNode)
+		{
+			m_CurrentTick++;
+			return;
+		}
+
+		m_Expired = m_Slots[0][index];
+		m_Slots[0][index] = s_InvalidNode;
+		for (uint32_t i = m_Expired; i != s_InvalidNode; i = m_Nodes[i].Next)
+			m_Nodes[i].Slot = &m_Expired;
+
+		m_CurrentTick++;
+
+		while (m_Expired != s_InvalidNode)
+		{
+			uint32_t nodeIndex = m_Expired;
+			Unlink(nodeIndex);
+
+			Node& node = m_Nodes[nodeIndex];
+			m_FiringNode = nodeIndex;
+			m_ReleaseFiringNode = false;
+
+			if (node.IntervalTicks > 0)
+			{
+				node.Expires = tick + node.IntervalTicks;
+				Insert(nodeIndex);
+			}
+			else
+			{
+				m_PendingCount--;
+				m_ReleaseFiringNode = true;
+			}
+
+			node.Callback();
+
+			m_FiringNode = s_InvalidNode;
+			if (m_ReleaseFiringNode)
+				Release(nodeIndex);
+		}
+	}
+
+	TimerWheel::Node* TimerWheel::Resolve(TimerHandle handle)
+	{
+		return const_cast<Node*>(static_cast<const TimerWheel*>(this)->Resolve(handle));
+	}
+
+	const TimerWheel::Node* TimerWheel::Resolve(TimerHandle handle) const
+	{
+		uint32_t index = (uint32_t)(handle & 0xFFFFFFFF);
+		uint32_t generation = (uint32_t)(handle >> 32);
+
+		if (index >= m_Nodes.size() || m_Nodes[index].Generation != generation)
+			return nullptr;
+		return &m_Nodes[index];
+	}
+
+}
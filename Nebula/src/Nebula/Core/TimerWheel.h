@@ -0,0 +1,85 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <cstdint>
+#include <functional>
+#include <deque>
+#include <vector>
+
+namespace Nebula {
+
+	// 0 is never a valid handle
+	using TimerHandle = uint64_t;
+	using TimerCallback = std::function<void()>;
+
+	// Hierarchical timing wheel (four levels of 256 slots).
+	// Schedule and Cancel are O(1). Advance only visits the slot for each elapsed
+	// tick, so the cost of a frame doesn't depend on how many timers are pending,
+	// only on how many actually fire. Timers further out than one level's span
+	// sit in a coarser level and are cascaded down when their slot comes up.
+	class NEBULA_API TimerWheel
+	{
+	public:
+		explicit TimerWheel(float tickSeconds = 0.001f);
+
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel& operator=(const TimerWheel&) = delete;
+
+		// Fires callback after delaySeconds, then every intervalSeconds if that is > 0.
+		// Callbacks run inside Advance and may schedule or cancel other timers.
+		TimerHandle Schedule(float delaySeconds, TimerCallback callback, float intervalSeconds = 0.0f);
+		// Returns false if the timer already fired (and doesn't repeat) or was cancelled
+		bool Cancel(TimerHandle handle);
+		bool IsPending(TimerHandle handle) const;
+
+		void Advance(float deltaSeconds);
+		// Drops every pending timer without firing it. Not callable from inside a callback.
+		void Clear();
+
+		uint32_t GetPendingCount() const { return m_PendingCount; }
+		float GetTickSeconds() const { return m_TickSeconds; }
+
+	private:
+		static constexpr uint32_t s_LevelCount = 4;
+		static constexpr uint32_t s_SlotBits = 8;
+		static constexpr uint32_t s_SlotCount = 1 << s_SlotBits;
+		static constexpr uint32_t s_SlotMask = s_SlotCount - 1;
+		static constexpr uint32_t s_InvalidNode = 0xFFFFFFFF;
+
+		struct Node
+		{
+			TimerCallback Callback;
+			uint64_t Expires = 0;
+			uint64_t IntervalTicks = 0;
+			uint32_t Generation = 1;
+			uint32_t Prev = s_InvalidNode;
+			uint32_t Next = s_InvalidNode;
+			uint32_t* Slot = nullptr; // Head of the list the node is linked into, null when not scheduled
+		};
+
+		uint64_t ToTicks(float seconds) const;
+		void Insert(uint32_t index);
+		void Unlink(uint32_t index);
+		void Release(uint32_t index);
+		void Cascade(uint32_t level, uint32_t slot);
+		void ProcessTick();
+		Node* Resolve(TimerHandle handle);
+		const Node* Resolve(TimerHandle handle) const;
+
+	private:
+		float m_TickSeconds;
+		double m_Accumulator = 0.0;
+		uint64_t m_CurrentTick = 0; // Next tick to be processed
+
+		uint32_t m_Slots[s_LevelCount][s_SlotCount]; // List heads into m_Nodes
+		uint32_t m_Expired = s_InvalidNode; // Slot being fired, detached so callbacks can't append to it
+		std::deque<Node> m_Nodes; // Deque so a running callback isn't moved when another timer is scheduled
+		std::vector<uint32_t> m_FreeNodes;
+		uint32_t m_PendingCount = 0;
+
+		uint32_t m_FiringNode = s_InvalidNode;
+		bool m_ReleaseFiringNode = false;
+	};
+
+}
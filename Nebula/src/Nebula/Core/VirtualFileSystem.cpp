@@ -0,0 +1,185 @@
+#include "nbpch.h"
+#include "VirtualFileSystem.h"
+#include "AssetPack.h"
+#include "LZ4.h"
+#include "Nebula/Log.h"
+
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Nebula {
+
+	// Most recently mounted last, searched back to front
+	static std::vector<std::shared_ptr<AssetPack>> s_Packs;
+	static std::shared_mutex s_PacksMutex;
+
+	// Pack entries are relative to the working directory, absolute paths below it map onto them
+	static std::string ToPackPath(const std::string& path)
+	{
+		std::filesystem::path fsPath(path);
+		if (fsPath.is_absolute())
+		{
+			std::error_code error;
+			std::filesystem::path relative = std::filesystem::relative(fsPath, std::filesystem::current_path(error), error);
+			if (!error && !relative.empty() && relative.native()[0] != '.')
+				return AssetPack::NormalizePath(relative.generic_string());
+		}
+		return AssetPack::NormalizePath(path);
+	}
+
+	static std::shared_ptr<AssetPack> FindInPacks(const std::string& path, const AssetPackEntry*& entry)
+	{
+		std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+		if (s_Packs.empty())
+			return nullptr;
+
+		std::string packPath = ToPackPath(path);
+		for (auto it = s_Packs.rbegin(); it != s_Packs.rend(); ++it)
+		{
+			entry = (*it)->FindEntry(packPath);
+			if (entry)
+				return *it;
+		}
+		return nullptr;
+	}
+
+	VirtualFileStream::VirtualFileStream(VirtualFile file)
+		: std::istream(nullptr), m_File(std::move(file))
+	{
+		m_Buffer.Set(m_File.GetData(), m_File.GetSize());
+		rdbuf(&m_Buffer);
+		if (!m_File)
+			setstate(std::ios::failbit);
+	}
+
+	void VirtualFileStream::Buffer::Set(const uint8_t* data, size_t size)
+	{
+		// Never written through, std::streambuf just has no const get area
+		char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+		setg(begin, begin, begin + size);
+	}
+
+	VirtualFileStream::Buffer::pos_type VirtualFileStream::Buffer::seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which)
+	{
+		if (!(which & std::ios_base::in))
+			return pos_type(off_type(-1));
+
+		off_type base = 0;
+		if (dir == std::ios_base::cur)
+			base = gptr() - eback();
+		else if (dir == std::ios_base::end)
+			base = egptr() - eback();
+
+		off_type position = base + offset;
+		if (position < 0 || position > egptr() - eback())
+			return pos_type(off_type(-1));
+
+		setg(eback(), eback() + position, egptr());
+		return pos_type(position);
+	}
+
+	VirtualFileStream::Buffer::pos_type VirtualFileStream::Buffer::seekpos(pos_type position, std::ios_base::openmode which)
+	{
+		return seekoff(off_type(position), std::ios_base::beg, which);
+	}
+
+	bool VirtualFileSystem::Mount(const std::filesystem::path& packPath)
+	{
+		std::shared_ptr<AssetPack> pack = AssetPack::Open(packPath);
+		if (!pack)
+			return false;
+
+		std::unique_lock<std::shared_mutex> lock(s_PacksMutex);
+		s_Packs.push_back(pack);
+		return true;
+	}
+
+	void VirtualFileSystem::UnmountAll()
+	{
+		// Files already handed out keep their pack alive
+		std::unique_lock<std::shared_mutex> lock(s_PacksMutex);
+		s_Packs.clear();
+	}
+
+	bool VirtualFileSystem::HasMountedPacks()
+	{
+		std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+		return !s_Packs.empty();
+	}
+
+	VirtualFile VirtualFileSystem::ReadFile(const std::string& path)
+	{
+		VirtualFile file;
+
+		const AssetPackEntry* entry = nullptr;
+		if (std::shared_ptr<AssetPack> pack = FindInPacks(path, entry))
+		{
+			const uint8_t* stored = pack->GetStoredData(*entry);
+			if (entry->Compression == AssetPackCompression::None)
+			{
+				file.m_Pack = pack;
+				file.m_Data = stored;
+				file.m_Size = (size_t)entry->Size;
+				file.m_Valid = true;
+				return file;
+			}
+
+			// AssetPack::Open() already bounded Size by the LZ4 ratio
+			file.m_Buffer.resize((size_t)entry->Size);
+			if (!LZ4::Decompress(stored, (size_t)entry->StoredSize, file.m_Buffer.data(), file.m_Buffer.size()))
+			{
+				NB_CORE_ERROR("Corrupt entry {0} in asset pack {1}", path, pack->GetFilePath().string());
+				return VirtualFile();
+			}
+			file.m_Data = file.m_Buffer.data();
+			file.m_Size = file.m_Buffer.size();
+			file.m_Valid = true;
+			return file;
+		}
+
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if (!in)
+			return file;
+
+		std::streamoff size = in.tellg();
+		if (size < 0)
+			return file;
+		file.m_Buffer.resize((size_t)size);
+		in.seekg(0);
+		in.read(reinterpret_cast<char*>(file.m_Buffer.data()), size);
+
+		file.m_Data = file.m_Buffer.data();
+		file.m_Size = file.m_Buffer.size();
+		file.m_Valid = true;
+		return file;
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& path)
+	{
+		const AssetPackEntry* entry = nullptr;
+		if (FindInPacks(path, entry))
+			return true;
+
+		std::error_code error;
+		return std::filesystem::is_regular_file(path, error);
+	}
+
+	uint64_t VirtualFileSystem::GetFileSize(const std::string& path)
+	{
+		const AssetPackEntry* entry = nullptr;
+		if (FindInPacks(path, entry))
+			return entry->Size;
+
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(path, error);
+		return error ? 0 : size;
+	}
+
+	bool VirtualFileSystem::IsPacked(const std::string& path)
+	{
+		const AssetPackEntry* entry = nullptr;
+		return FindInPacks(path, entry) != nullptr;
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nebula {
+
+	class AssetPack;
+
+	// Contents of a file read through the VirtualFileSystem. Uncompressed pack
+	// entries point straight into the mapped pack, everything else owns a buffer.
+	class NEBULA_API VirtualFile
+	{
+	public:
+		VirtualFile() = default;
+		VirtualFile(VirtualFile&&) = default;
+		VirtualFile& operator=(VirtualFile&&) = default;
+		// m_Data may point into m_Buffer, so copies aren't allowed
+		VirtualFile(const VirtualFile&) = delete;
+		VirtualFile& operator=(const VirtualFile&) = delete;
+
+		bool IsValid() const { return m_Valid; }
+		explicit operator bool() const { return m_Valid; }
+
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+		std::string ToString() const { return std::string(reinterpret_cast<const char*>(m_Data), m_Size); }
+
+		// True when the data is a view of a mounted pack rather than a copy
+		bool IsMapped() const { return m_Pack != nullptr; }
+
+	private:
+		friend class VirtualFileSystem;
+
+		std::shared_ptr<AssetPack> m_Pack; // Keeps the mapping alive
+		std::vector<uint8_t> m_Buffer;
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		bool m_Valid = false;
+	};
+
+	// std::istream over a VirtualFile, for readers written against streams
+	class NEBULA_API VirtualFileStream : public std::istream
+	{
+	public:
+		explicit VirtualFileStream(VirtualFile file);
+
+	private:
+		class Buffer : public std::streambuf
+		{
+		public:
+			void Set(const uint8_t* data, size_t size);
+
+		protected:
+			virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+			virtual pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+		};
+
+		VirtualFile m_File;
+		Buffer m_Buffer;
+	};
+
+	// Reads game files from mounted .nbpak packs, falling back to the disk.
+	// Packs mounted later win. Safe to read from any thread.
+	class NEBULA_API VirtualFileSystem
+	{
+	public:
+		static bool Mount(const std::filesystem::path& packPath);
+		static void UnmountAll();
+		static bool HasMountedPacks();
+
+		static VirtualFile ReadFile(const std::string& path);
+		static bool Exists(const std::string& path);
+		// Uncompressed size, 0 if the file doesn't exist
+		static uint64_t GetFileSize(const std::string& path);
+		// True when the file comes from a mounted pack instead of the disk
+		static bool IsPacked(const std::string& path);
+	};
+
+}
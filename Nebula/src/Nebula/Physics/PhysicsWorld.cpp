@@ -240,7 +240,7 @@ namespace Nebula {
 		glm::vec3 finalSize = collider.Size * worldScale;
 		collider.LastScale = worldScale; // Track current world scale
 		collider.LastSize = collider.Size; // Track current size
-		NB_INFO("Creating BoxCollider - Size: ({0}, {1}, {2}), WorldScale: ({3}, {4}, {5}), Final: ({6}, {7}, {8})",
+		NB_CORE_TRACE("Creating BoxCollider - Size: ({0}, {1}, {2}), WorldScale: ({3}, {4}, {5}), Final: ({6}, {7}, {8})",
 			collider.Size.x, collider.Size.y, collider.Size.z,
 			worldScale.x, worldScale.y, worldScale.z,
 			finalSize.x, finalSize.y, finalSize.z);
@@ -331,7 +331,7 @@ namespace Nebula {
 		glm::vec3 worldPosition = scene->GetWorldPosition(entity);
 		glm::quat worldRotation = scene->GetWorldRotation(entity);
 
-		NB_INFO("Creating RigidBody at position ({0}, {1}, {2})", 
+		NB_CORE_TRACE("Creating RigidBody at position ({0}, {1}, {2})", 
 			worldPosition.x, worldPosition.y, worldPosition.z);
 
 		// Calculate mass and inertia
@@ -421,7 +421,7 @@ namespace Nebula {
 			else if (rb.Type == RigidBodyComponent::BodyType::Dynamic) typeStr = "Dynamic";
 			else if (rb.Type == RigidBodyComponent::BodyType::Kinematic) typeStr = "Kinematic";
 			
-			NB_INFO("Added {0} RigidBody (mass: {1}) to physics world", typeStr, rb.Mass);
+			NB_CORE_TRACE("Added {0} RigidBody (mass: {1}) to physics world", typeStr, rb.Mass);
 		}
 	}
 
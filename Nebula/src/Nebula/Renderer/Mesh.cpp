@@ -1,7 +1,10 @@
 #include "nbpch.h"
 #include "Mesh.h"
 #include "Buffer.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Core/DerivedDataCache.h"
 #include <glm/gtc/constants.hpp>
+#include <cstring>
 
 namespace Nebula {
 
@@ -10,22 +13,68 @@ namespace Nebula {
 	std::unordered_map<std::string, MeshID> Mesh::s_PathToID;
 	MeshID Mesh::s_NextID = 1; // Start at 1, 0 is invalid
 
-	std::shared_ptr<Mesh> Mesh::LoadOBJ(const std::string& path)
+	// Cached parse result: CookedMeshHeader, the vertices, then the indices
+	struct CookedMeshHeader
+	{
+		uint32_t VertexCount = 0;
+		uint32_t IndexCount = 0;
+		uint32_t VertexSize = sizeof(Vertex);
+		uint32_t Reserved = 0;
+	};
+
+	// Bump when the parser's output changes
+	static constexpr uint32_t s_CookedMeshVersion = 1;
+
+	static bool LoadCookedMesh(const std::string& cacheKey, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		std::vector<uint8_t> cooked;
+		if (!DerivedDataCache::Load(cacheKey, cooked) || cooked.size() < sizeof(CookedMeshHeader))
+			return false;
+
+		CookedMeshHeader header;
+		memcpy(&header, cooked.data(), sizeof(header));
+		size_t vertexBytes = (size_t)header.VertexCount * sizeof(Vertex);
+		size_t indexBytes = (size_t)header.IndexCount * sizeof(uint32_t);
+		if (header.VertexSize != sizeof(Vertex) || cooked.size() != sizeof(header) + vertexBytes + indexBytes)
+			return false;
+
+		vertices.assign(header.VertexCount, Vertex(glm::vec3(0.0f)));
+		indices.resize(header.IndexCount);
+		memcpy(vertices.data(), cooked.data() + sizeof(header), vertexBytes);
+		memcpy(indices.data(), cooked.data() + sizeof(header) + vertexBytes, indexBytes);
+		return true;
+	}
+
+	static void StoreCookedMesh(const std::string& cacheKey, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		CookedMeshHeader header;
+		header.VertexCount = (uint32_t)vertices.size();
+		header.IndexCount = (uint32_t)indices.size();
+
+		size_t vertexBytes = vertices.size() * sizeof(Vertex);
+		size_t indexBytes = indices.size() * sizeof(uint32_t);
+		std::vector<uint8_t> cooked(sizeof(header) + vertexBytes + indexBytes);
+		memcpy(cooked.data(), &header, sizeof(header));
+		memcpy(cooked.data() + sizeof(header), vertices.data(), vertexBytes);
+		memcpy(cooked.data() + sizeof(header) + vertexBytes, indices.data(), indexBytes);
+		DerivedDataCache::Store(cacheKey, cooked.data(), cooked.size());
+	}
+
+	static bool ParseOBJ(const std::string& path, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
 	{
-		std::vector<Vertex> vertices;
-		std::vector<uint32_t> indices;
 		std::vector<glm::vec3> positions;
 		std::vector<glm::vec2> texCoords;
 		std::vector<glm::vec3> normals;
 		std::vector<uint32_t> vertexIndices;
 
-		std::ifstream file(path);
-		if (!file.is_open())
+		VirtualFile source = VirtualFileSystem::ReadFile(path);
+		if (!source)
 		{
 			NB_CORE_ERROR("Failed to load OBJ file: {0}", path);
 			NB_CORE_ERROR("Check if the file exists and the path is correct");
-			return nullptr;
+			return false;
 		}
+		std::istringstream file(source.ToString());
 		
 		NB_CORE_INFO("Loading OBJ file: {0}", path);
 
@@ -78,7 +127,22 @@ namespace Nebula {
 				}
 			}
 		}
-		file.close();
+		return true;
+	}
+
+	std::shared_ptr<Mesh> Mesh::LoadOBJ(const std::string& path)
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+
+		std::string cacheKey = DerivedDataCache::GetKey(path, "Mesh.OBJ", s_CookedMeshVersion);
+		if (!LoadCookedMesh(cacheKey, vertices, indices))
+		{
+			if (!ParseOBJ(path, vertices, indices))
+				return nullptr;
+			if (!cacheKey.empty())
+				StoreCookedMesh(cacheKey, vertices, indices);
+		}
 		
 		auto mesh = std::make_shared<Mesh>(vertices, indices);
 		mesh->SetSourcePath(path);
@@ -34,4 +34,17 @@ namespace Nebula {
 		NEB_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
-}
\ No newline at end of file
+
+	uint32_t Shader::ReloadFromFile(const std::string& filepath)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			return 0;
+		case RendererAPI::API::OpenGL:
+			return OpenGLShader::ReloadFromFile(filepath);
+		}
+
+		return 0;
+	}
+}
@@ -21,7 +21,13 @@ namespace Nebula {
 	virtual void SetMat3(const std::string& name, const glm::mat3& matrix) = 0;
 	virtual void SetMat4(const std::string& name, const glm::mat4& matrix) = 0;
 
+	// Recompiles from the source file, keeping the current program if the new one fails
+	virtual bool Reload() { return false; }
+
 	static Shader* Create(const std::string& filepath);
 		static Shader* Create(const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		// Reloads every live shader that was created from this file, returns how many were reloaded
+		static uint32_t ReloadFromFile(const std::string& filepath);
 	};
 }
\ No newline at end of file
@@ -7,6 +7,17 @@
 namespace Nebula {
 
 	Texture2D* Texture2D::Create(const std::string& path, bool useNearest, bool repeat)
+	{
+		Texture2D* texture = CreateDeferred(path, useNearest, repeat);
+		if (texture)
+		{
+			texture->Decode();
+			texture->Upload();
+		}
+		return texture;
+	}
+
+	Texture2D* Texture2D::CreateDeferred(const std::string& path, bool useNearest, bool repeat)
 	{
 		switch (Renderer::GetAPI())
 		{
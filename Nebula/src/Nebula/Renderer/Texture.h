@@ -14,6 +14,8 @@ namespace Nebula {
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 		virtual uint32_t GetRendererID() const = 0;
+		// Bytes of GPU memory, 0 until uploaded
+		virtual uint64_t GetMemorySize() const = 0;
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
 	};
@@ -22,6 +24,15 @@ namespace Nebula {
 	{
 	public:
 		static Texture2D* Create(const std::string& path, bool useNearest = false, bool repeat = true);
+		// Nothing is loaded yet. Call Decode() (any thread) and then Upload() (main thread) before using it.
+		static Texture2D* CreateDeferred(const std::string& path, bool useNearest = false, bool repeat = true);
+
+		// Reads and decodes the image, no GL calls
+		virtual void Decode() = 0;
+		// Creates the GL texture from the decoded image
+		virtual void Upload() = 0;
+		// False until Upload() succeeded
+		virtual bool IsReady() const = 0;
 	};
 
 }
@@ -2,6 +2,7 @@
 #pragma warning(disable: 4251)
 
 #include "Nebula/Core.h"
+#include "Nebula/Scripting/ScriptFieldStorage.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -122,37 +123,13 @@ namespace Nebula {
 		CameraComponent(const CameraComponent&) = default;
 	};
 
-	// Script Variable for editor exposure
-	struct NEBULA_API ScriptVariable
-	{
-		enum class Type { Float, Int, Bool, String, Vec3 };
-		
-		std::string Name;
-		Type VarType;
-		
-		// Union-like storage (only one is used based on VarType)
-		float FloatValue = 0.0f;
-		int IntValue = 0;
-		bool BoolValue = false;
-		std::string StringValue;
-		glm::vec3 Vec3Value = glm::vec3(0.0f);
-		
-		ScriptVariable() = default;
-		ScriptVariable(const std::string& name, float value)
-			: Name(name), VarType(Type::Float), FloatValue(value) {}
-		ScriptVariable(const std::string& name, int value)
-			: Name(name), VarType(Type::Int), IntValue(value) {}
-		ScriptVariable(const std::string& name, bool value)
-			: Name(name), VarType(Type::Bool), BoolValue(value) {}
-	};
-
 	// Script Component - C# script support
 	struct NEBULA_API ScriptComponent
 	{
 		std::string ClassName; // Fully qualified C# class name (e.g., "MyScripts.PlayerController")
 		
 		// Storage for field values in editor mode (before instantiation)
-		std::unordered_map<std::string, ScriptVariable> FieldValues;
+		ScriptFieldStorage FieldValues;
 
 		ScriptComponent() = default;
 		ScriptComponent(const ScriptComponent&) = default;
@@ -260,6 +237,7 @@ namespace Nebula {
 		bool Loop = false;
 		bool PlayOnAwake = false;
 		bool Spatial = true; // 3D spatial audio vs 2D audio
+		int Priority = 128; // 0 = most important, 256 = least. Decides who keeps a real voice in busy scenes
 
 		// Spatial audio parameters
 		float RolloffFactor = 1.0f;
@@ -0,0 +1,95 @@
+#include "nbpch.h"
+#include "EntityQuery.h"
+
+namespace Nebula {
+
+	EntityQuery::EntityQuery(entt::registry& registry)
+		: m_Registry(registry)
+	{
+	}
+
+	EntityQuery::~EntityQuery()
+	{
+		for (const auto& requirement : m_Requirements)
+			requirement.Disconnect(m_Registry, *this);
+	}
+
+	void EntityQuery::Build()
+	{
+		m_Entities.clear();
+		m_Indices.clear();
+
+		if (m_Requirements.empty())
+			return;
+
+		// Every match has the first component, so its storage is a complete candidate set
+		std::vector<entt::entity> candidates;
+		m_Requirements.front().Collect(m_Registry, candidates);
+
+		for (auto entity : candidates)
+		{
+			if (Matches(entity))
+				Add((uint32_t)entity);
+		}
+
+		m_Version++;
+	}
+
+	uint32_t EntityQuery::CopyTo(uint32_t* out, uint32_t capacity) const
+	{
+		uint32_t count = GetCount();
+		if (out && capacity > 0)
+			std::copy_n(m_Entities.begin(), std::min(count, capacity), out);
+		return count;
+	}
+
+	void EntityQuery::OnComponentAdded(entt::registry& registry, entt::entity entity)
+	{
+		uint32_t id = (uint32_t)entity;
+		if (m_Indices.find(id) == m_Indices.end() && Matches(entity))
+		{
+			Add(id);
+			m_Version++;
+		}
+	}
+
+	void EntityQuery::OnComponentRemoved(entt::registry& registry, entt::entity entity)
+	{
+		// Fired before the component is gone, the entity can't match afterwards either way
+		uint32_t id = (uint32_t)entity;
+		if (m_Indices.find(id) != m_Indices.end())
+		{
+			Remove(id);
+			m_Version++;
+		}
+	}
+
+	bool EntityQuery::Matches(entt::entity entity) const
+	{
+		for (const auto& requirement : m_Requirements)
+		{
+			if (!requirement.Has(m_Registry, entity))
+				return false;
+		}
+		return true;
+	}
+
+	void EntityQuery::Add(uint32_t id)
+	{
+		m_Indices[id] = (uint32_t)m_Entities.size();
+		m_Entities.push_back(id);
+	}
+
+	void EntityQuery::Remove(uint32_t id)
+	{
+		auto it = m_Indices.find(id);
+		uint32_t index = it->second;
+		uint32_t last = m_Entities.back();
+
+		m_Entities[index] = last;
+		m_Indices[last] = index;
+		m_Entities.pop_back();
+		m_Indices.erase(id);
+	}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <entt/entt.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Nebula {
+
+	// A cached list of entities that have all of a set of components.
+	// Kept up to date incrementally through the registry's construct/destroy
+	// signals, so reading it never walks a view.
+	class NEBULA_API EntityQuery
+	{
+	public:
+		explicit EntityQuery(entt::registry& registry);
+		~EntityQuery();
+
+		EntityQuery(const EntityQuery&) = delete;
+		EntityQuery& operator=(const EntityQuery&) = delete;
+
+		// Add a required component. Call for every component before Build().
+		template<typename Component>
+		void Require()
+		{
+			m_Requirements.push_back({
+				[](const entt::registry& registry, entt::entity entity) { return registry.any_of<Component>(entity); },
+				[](entt::registry& registry, std::vector<entt::entity>& out)
+				{
+					for (auto entity : registry.view<Component>())
+						out.push_back(entity);
+				},
+				[](entt::registry& registry, EntityQuery& query)
+				{
+					registry.on_construct<Component>().template disconnect<&EntityQuery::OnComponentAdded>(query);
+					registry.on_destroy<Component>().template disconnect<&EntityQuery::OnComponentRemoved>(query);
+				}
+			});
+
+			m_Registry.on_construct<Component>().template connect<&EntityQuery::OnComponentAdded>(*this);
+			m_Registry.on_destroy<Component>().template connect<&EntityQuery::OnComponentRemoved>(*this);
+		}
+
+		// Fills the initial match list from the current registry contents
+		void Build();
+
+		const std::vector<uint32_t>& GetEntities() const { return m_Entities; }
+		uint32_t GetCount() const { return (uint32_t)m_Entities.size(); }
+
+		// Bumped on every membership change, lets callers skip copying an unchanged list
+		uint32_t GetVersion() const { return m_Version; }
+
+		// Copies up to capacity entity IDs and returns the total number of matches
+		uint32_t CopyTo(uint32_t* out, uint32_t capacity) const;
+
+	private:
+		void OnComponentAdded(entt::registry& registry, entt::entity entity);
+		void OnComponentRemoved(entt::registry& registry, entt::entity entity);
+		bool Matches(entt::entity entity) const;
+		void Add(uint32_t id);
+		void Remove(uint32_t id);
+
+	private:
+		struct Requirement
+		{
+			bool (*Has)(const entt::registry&, entt::entity);
+			void (*Collect)(entt::registry&, std::vector<entt::entity>&);
+			void (*Disconnect)(entt::registry&, EntityQuery&);
+		};
+
+		entt::registry& m_Registry;
+		std::vector<Requirement> m_Requirements;
+
+		// Dense list plus index so removal is a swap-and-pop
+		std::vector<uint32_t> m_Entities;
+		std::unordered_map<uint32_t, uint32_t> m_Indices;
+		uint32_t m_Version = 0;
+	};
+
+}
@@ -1,6 +1,8 @@
 #include "nbpch.h"
 #include "Scene.h"
 #include "Components.h"
+#include "EntityQuery.h"
+#include "TagIndex.h"
 #include "Nebula/Renderer/Renderer.h"
 #include "Nebula/Renderer/Material.h"
 #include "Nebula/Renderer/Framebuffer.h"
@@ -9,9 +11,13 @@
 #include "Nebula/Renderer/Mesh.h"
 #include "Nebula/Renderer/Skybox.h"
 #include "Platform/OpenGL/OpenGLSkybox.h"
+#include "Platform/OpenGL/OpenGLTexture.h"
+#include "Nebula/Asset/AssetManager.h"
 #include "Nebula/Application.h"
 #include "Nebula/Scripting/ScriptEngine.h"
 #include "Nebula/Scripting/ScriptGlue.h"
+#include "Nebula/Scripting/ScriptProfiler.h"
+#include "Nebula/Scripting/ScriptScheduler.h"
 #include "Nebula/Physics/PhysicsWorld.h"
 #include "Nebula/Physics/PhysicsDebugDraw.h"
 #include "Nebula/Audio/AudioEngine.h"
@@ -23,6 +29,8 @@ namespace Nebula {
 	Scene::Scene(const std::string& name)
 		: m_Name(name), m_GlobalIllumination(0.1f, 0.1f, 0.1f)
 	{
+		m_TagIndex = std::make_unique<TagIndex>(m_Registry);
+
 		// Initialize physics
 		m_PhysicsWorld = std::make_unique<PhysicsWorld>();
 		m_PhysicsWorld->Init();
@@ -33,8 +41,14 @@ namespace Nebula {
 		{
 			if (!m_AudioEngine->Init())
 			{
-				NB_CORE_ERROR("Failed to initialize audio engine");
-				m_AudioEngine.reset();
+				// No sound card (CI, servers): keep sources running on a mixer nobody hears
+				NB_CORE_WARN("Failed to initialize audio device, using headless audio");
+				m_AudioEngine.reset(AudioEngine::CreateHeadless(48000, true));
+				if (!m_AudioEngine || !m_AudioEngine->Init())
+				{
+					NB_CORE_ERROR("Failed to initialize audio engine");
+					m_AudioEngine.reset();
+				}
 			}
 		}
 
@@ -100,9 +114,151 @@ namespace Nebula {
 		auto it = std::find(m_EntityOrder.begin(), m_EntityOrder.end(), entity.m_EntityHandle);
 		if (it != m_EntityOrder.end())
 			m_EntityOrder.erase(it);
+
+		// Its voice would otherwise keep playing (and holding the clip) with nobody to stop it
+		if (m_AudioEngine)
+		{
+			if (auto* audioSource = m_Registry.try_get<AudioSourceComponent>(entity))
+			{
+				if (audioSource->RuntimeSourceID != 0)
+					m_AudioEngine->DestroySource(audioSource->RuntimeSourceID);
+			}
+		}
+
 		m_Registry.destroy(entity);
 	}
 
+	// Components copied by InstantiateEntities. Tag and hierarchy are rebuilt for the clones.
+	using CloneableComponents = ComponentGroup<TransformComponent, MeshRendererComponent, CameraComponent, ScriptComponent,
+		BoxColliderComponent, SphereColliderComponent, RigidBodyComponent, LineRendererComponent, SkyboxComponent,
+		AudioSourceComponent, AudioListenerComponent, PointLightComponent, DirectionalLightComponent>;
+
+	// Runtime handles belong to the source entity, clones create their own
+	template<typename Component>
+	static void ResetRuntimeState(Component&) {}
+
+	static void ResetRuntimeState(RigidBodyComponent& rb) { rb.RuntimeBody = nullptr; }
+	static void ResetRuntimeState(BoxColliderComponent& bc) { bc.RuntimeShape = nullptr; }
+	static void ResetRuntimeState(SphereColliderComponent& sc) { sc.RuntimeShape = nullptr; }
+
+	static void ResetRuntimeState(AudioSourceComponent& as)
+	{
+		as.RuntimeSourceID = 0;
+		as.IsPlaying = false;
+	}
+
+	// One bulk insert per component type the source has
+	template<typename... Component>
+	static void CloneComponents(ComponentGroup<Component...>, entt::registry& registry, entt::entity source,
+		const entt::entity* first, const entt::entity* last)
+	{
+		([&]()
+		{
+			if (const Component* component = registry.try_get<Component>(source))
+			{
+				Component copy = *component;
+				ResetRuntimeState(copy);
+				registry.insert<Component>(first, last, copy);
+			}
+		}(), ...);
+	}
+
+	void Scene::InstantiateEntities(Entity prefab, uint32_t count, std::vector<entt::entity>& outEntities,
+		const glm::vec3* positions, const glm::vec3* rotations)
+	{
+		outEntities.clear();
+		if (!prefab || count == 0)
+			return;
+
+		outEntities.resize(count);
+		m_Registry.create(outEntities.begin(), outEntities.end());
+
+		std::string name = prefab.HasComponent<TagComponent>() ? prefab.GetComponent<TagComponent>().Tag + " (Clone)" : "Clone";
+		std::vector<entt::entity> created;
+		CloneHierarchy(prefab, outEntities.data(), count, &name, created);
+
+		if (positions || rotations)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				auto& transform = m_Registry.get<TransformComponent>(outEntities[i]);
+				if (positions)
+					transform.Position = positions[i];
+				if (rotations)
+					transform.Rotation = rotations[i];
+			}
+		}
+
+		// Bodies first so scripts can use them from OnCreate
+		if (m_PhysicsWorld)
+		{
+			for (entt::entity entity : created)
+			{
+				if (m_Registry.all_of<RigidBodyComponent>(entity))
+					m_PhysicsWorld->AddRigidBody({ entity, this }, this);
+			}
+		}
+
+		if (m_IsRuntimeActive)
+		{
+			for (entt::entity entity : created)
+			{
+				if (m_Registry.all_of<ScriptComponent>(entity))
+					ScriptEngine::OnCreateEntity({ entity, this });
+			}
+		}
+	}
+
+	Entity Scene::InstantiateEntity(Entity prefab)
+	{
+		std::vector<entt::entity> clones;
+		InstantiateEntities(prefab, 1, clones);
+		return clones.empty() ? Entity{} : Entity{ clones.front(), this };
+	}
+
+	void Scene::CloneHierarchy(entt::entity source, const entt::entity* clones, uint32_t count,
+		const std::string* rootName, std::vector<entt::entity>& created)
+	{
+		created.insert(created.end(), clones, clones + count);
+		m_EntityOrder.insert(m_EntityOrder.end(), clones, clones + count);
+
+		const TagComponent* sourceTag = m_Registry.try_get<TagComponent>(source);
+		TagComponent tag(rootName ? *rootName : (sourceTag ? sourceTag->Tag : "Entity"));
+		m_Registry.insert<TagComponent>(clones, clones + count, tag);
+		CloneComponents(CloneableComponents{}, m_Registry, source, clones, clones + count);
+
+		const HierarchyComponent* hierarchy = m_Registry.try_get<HierarchyComponent>(source);
+		if (!hierarchy || hierarchy->Children.empty())
+			return;
+
+		// Copied, cloning grows the hierarchy storage
+		std::vector<uint32_t> children = hierarchy->Children;
+		m_Registry.insert<HierarchyComponent>(clones, clones + count);
+
+		// Each child is cloned count times and the i-th copy goes under the i-th clone
+		std::vector<entt::entity> childClones(count);
+		for (uint32_t childID : children)
+		{
+			entt::entity child = (entt::entity)childID;
+			if (!m_Registry.valid(child))
+				continue;
+
+			m_Registry.create(childClones.begin(), childClones.end());
+			CloneHierarchy(child, childClones.data(), count, nullptr, created);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				m_Registry.get_or_emplace<HierarchyComponent>(childClones[i]).Parent = (uint32_t)clones[i];
+				m_Registry.get<HierarchyComponent>(clones[i]).Children.push_back((uint32_t)childClones[i]);
+			}
+		}
+	}
+
+	void Scene::SetEntityTag(Entity entity, const std::string& tag)
+	{
+		m_Registry.patch<TagComponent>(entity, [&](TagComponent& tc) { tc.Tag = tag; });
+	}
+
 	void Scene::Clear()
 	{
 		m_Registry.clear();
@@ -124,6 +280,21 @@ namespace Nebula {
 	{
 		m_IsRuntimeActive = true;
 		
+		// Start decoding every clip now rather than on the first frame a source is updated
+		if (m_AudioEngine)
+		{
+			auto audioView = m_Registry.view<AudioSourceComponent>();
+			for (auto entity : audioView)
+			{
+				auto& audioSource = audioView.get<AudioSourceComponent>(entity);
+				if (!audioSource.Clip && !audioSource.AudioClipPath.empty())
+					audioSource.Clip = m_AudioEngine->LoadClip(audioSource.AudioClipPath, { audioSource.Spatial });
+			}
+
+			if (m_WaitForAudioPreload)
+				m_AudioEngine->WaitForClipLoads();
+		}
+
 		// Initialize script engine with this scene
 		ScriptEngine::OnRuntimeStart(this);
 
@@ -175,6 +346,28 @@ namespace Nebula {
 
 	// Shutdown script engine runtime
 	ScriptEngine::OnRuntimeStop();
+
+	// Queries and timers were created by scripts, nothing references them anymore
+	m_EntityQueries.clear();
+	m_TimerWheel.Clear();
+}
+
+uint32_t Scene::AddEntityQuery(std::unique_ptr<EntityQuery> query)
+{
+	uint32_t id = m_NextEntityQueryID++;
+	m_EntityQueries[id] = std::move(query);
+	return id;
+}
+
+EntityQuery* Scene::GetEntityQuery(uint32_t queryID)
+{
+	auto it = m_EntityQueries.find(queryID);
+	return it != m_EntityQueries.end() ? it->second.get() : nullptr;
+}
+
+void Scene::RemoveEntityQuery(uint32_t queryID)
+{
+	m_EntityQueries.erase(queryID);
 }
 
 void Scene::OnUpdate(float deltaTime)
@@ -205,19 +398,21 @@ void Scene::OnUpdate(float deltaTime)
 					m_PhysicsWorld->SyncTransformFromPhysics(entity);
 				}
 			}
+
+			// Coroutines yielding WaitForFixedUpdate resume once the step's transforms are synced
+			ScriptScheduler::OnPhysicsStep();
 		}
 
 		// Update C# scripts
 		{
-			ScriptGlue::Update(deltaTime); // Update delayed destroys and other systems
+			m_TimerWheel.Advance(deltaTime); // Delayed destroys, Invoke and coroutine waits
 			ScriptGlue::UpdateMouseState(); // Update mouse delta
-			
-			auto view = m_Registry.view<ScriptComponent>();
-			for (auto entity : view)
-			{
-				Entity ent = { entity, this };
-				ScriptEngine::OnUpdateEntity(ent, deltaTime);
-			}
+
+			// Only scripts that override OnUpdate are in the update set
+			ScriptEngine::OnUpdate(deltaTime);
+			ScriptScheduler::OnFrame();
+
+			ScriptProfiler::EndFrame();
 		}
 
 		// Update audio listener (find active camera with listener component)
@@ -252,10 +447,10 @@ void Scene::OnUpdate(float deltaTime)
 					auto& audioSource = audioView.get<AudioSourceComponent>(entityID);
 					auto& transform = audioView.get<TransformComponent>(entityID);
 
-				// Load audio clip if not already loaded
+				// Load audio clip if not already loaded, sources with the same path share one
 				if (!audioSource.Clip && !audioSource.AudioClipPath.empty())
 				{
-					audioSource.Clip = std::shared_ptr<AudioClip>(AudioClip::Create(audioSource.AudioClipPath));
+					audioSource.Clip = m_AudioEngine->LoadClip(audioSource.AudioClipPath, { audioSource.Spatial });
 				}
 
 				// Create audio source if needed
@@ -270,6 +465,7 @@ void Scene::OnUpdate(float deltaTime)
 						m_AudioEngine->SetSourcePitch(audioSource.RuntimeSourceID, audioSource.Pitch);
 						m_AudioEngine->SetSourceLoop(audioSource.RuntimeSourceID, audioSource.Loop);
 						m_AudioEngine->SetSourceSpatial(audioSource.RuntimeSourceID, audioSource.Spatial);
+						m_AudioEngine->SetSourcePriority(audioSource.RuntimeSourceID, audioSource.Priority);
 						m_AudioEngine->SetSourceRolloffFactor(audioSource.RuntimeSourceID, audioSource.RolloffFactor);
 						m_AudioEngine->SetSourceReferenceDistance(audioSource.RuntimeSourceID, audioSource.ReferenceDistance);
 						m_AudioEngine->SetSourceMaxDistance(audioSource.RuntimeSourceID, audioSource.MaxDistance);
@@ -277,7 +473,7 @@ void Scene::OnUpdate(float deltaTime)
 						// Attach clip
 						if (audioSource.Clip)
 						{
-							m_AudioEngine->SetSourceClip(audioSource.RuntimeSourceID, audioSource.Clip.get());
+							m_AudioEngine->SetSourceClip(audioSource.RuntimeSourceID, audioSource.Clip);
 						}
 
 					// Play on awake (only in runtime mode)
@@ -716,6 +912,68 @@ void Scene::SetPhysicsDebugDraw(bool enabled)
 		NB_CORE_INFO("Cleared initialization for {0} entity(ies) using script: {1}", keysToRemove.size(), scriptPath);
 	}
 
+	uint32_t Scene::ReloadAssetReferences(const std::string& filepath)
+	{
+		std::string changed = AssetManager::NormalizeAssetPath(filepath);
+		std::string changedFolder = std::filesystem::path(changed).parent_path().generic_string();
+		uint32_t updated = 0;
+
+		// One new mesh shared by every renderer that used the old one
+		std::shared_ptr<Mesh> reloadedMesh;
+		auto meshView = m_Registry.view<MeshRendererComponent>();
+		for (auto entity : meshView)
+		{
+			auto& meshRenderer = meshView.get<MeshRendererComponent>(entity);
+			if (!meshRenderer.MeshSource.empty() && AssetManager::NormalizeAssetPath(meshRenderer.MeshSource) == changed)
+			{
+				if (!reloadedMesh)
+					reloadedMesh = Mesh::LoadOBJ(meshRenderer.MeshSource);
+				if (reloadedMesh)
+				{
+					meshRenderer.Mesh = reloadedMesh;
+					updated++;
+				}
+			}
+
+			if (!meshRenderer.Material)
+				continue;
+
+			// Filtering and wrapping live on the texture, so keep them
+			auto* texture = dynamic_cast<OpenGLTexture2D*>(meshRenderer.Material->GetTexture("u_Texture").get());
+			if (texture && AssetManager::NormalizeAssetPath(texture->GetPath()) == changed)
+			{
+				std::shared_ptr<Texture2D> reloaded(Texture2D::Create(texture->GetPath(), texture->GetUseNearest(), texture->GetRepeat()));
+				if (reloaded && reloaded->IsReady())
+				{
+					meshRenderer.Material->SetTexture("u_Texture", reloaded);
+					updated++;
+				}
+			}
+		}
+
+		auto skyboxView = m_Registry.view<SkyboxComponent>();
+		for (auto entity : skyboxView)
+		{
+			auto& skybox = skyboxView.get<SkyboxComponent>(entity);
+			if (skybox.DirectoryPath.empty() || AssetManager::NormalizeAssetPath(skybox.DirectoryPath) != changedFolder)
+				continue;
+
+			try
+			{
+				skybox.SkyboxInstance = Skybox::Create(skybox.DirectoryPath);
+				updated++;
+			}
+			catch (const std::exception& e)
+			{
+				NB_CORE_ERROR("Failed to reload skybox {0}: {1}", skybox.DirectoryPath, e.what());
+			}
+		}
+
+		if (updated > 0)
+			NB_CORE_INFO("Reloaded {0} component(s) in scene {1} using: {2}", updated, m_Name, filepath);
+		return updated;
+	}
+
 	glm::mat4 Scene::GetWorldTransform(Entity entity) const
 	{
 		if (!entity.HasComponent<TransformComponent>())
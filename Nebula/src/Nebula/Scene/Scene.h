@@ -3,6 +3,7 @@
 
 #include "Nebula/Core.h"
 #include "Entity.h"
+#include "Nebula/Core/TimerWheel.h"
 #include <entt/entt.hpp>
 #include <string>
 #include <unordered_map>
@@ -24,6 +25,8 @@ namespace Nebula {
 	class Shader;
 	class PhysicsWorld;
 	class AudioEngine;
+	class EntityQuery;
+	class TagIndex;
 
 	class NEBULA_API Scene
 	{
@@ -33,6 +36,13 @@ namespace Nebula {
 
 		Entity CreateEntity(const std::string& name = "Entity");
 		void DestroyEntity(Entity entity);
+
+		// Copies every component of prefab, children included, onto count new entities in one pass.
+		// positions/rotations are optional per-clone overrides with count entries each.
+		// The root clones are written to outEntities.
+		void InstantiateEntities(Entity prefab, uint32_t count, std::vector<entt::entity>& outEntities,
+			const glm::vec3* positions = nullptr, const glm::vec3* rotations = nullptr);
+		Entity InstantiateEntity(Entity prefab);
 	void OnRuntimeStart();
 	void OnRuntimeStop();
 		void OnUpdate(float deltaTime);
@@ -54,12 +64,23 @@ namespace Nebula {
 	const std::string& GetName() const { return m_Name; }
 	entt::registry& GetRegistry() { return m_Registry; }
 
+	// Delayed destroys and script timers, advanced once per runtime frame
+	TimerWheel& GetTimerWheel() { return m_TimerWheel; }
+
+	// Tag/name lookup. Rename through SetEntityTag so the index sees the change.
+	TagIndex& GetTagIndex() { return *m_TagIndex; }
+	void SetEntityTag(Entity entity, const std::string& tag);
+
 	// Physics access
 	PhysicsWorld* GetPhysicsWorld() { return m_PhysicsWorld.get(); }
 	void SetPhysicsDebugDraw(bool enabled);
 
 	// Audio access
 	AudioEngine* GetAudioEngine() { return m_AudioEngine.get(); }
+	// Audio clips start decoding when the runtime starts. With this set the
+	// first frame waits for them instead of starting sounds as they arrive.
+	void SetWaitForAudioPreload(bool wait) { m_WaitForAudioPreload = wait; }
+	bool GetWaitForAudioPreload() const { return m_WaitForAudioPreload; }
 
 	// Script validation
 	bool ValidateAllScripts(std::string& errorMessage);
@@ -67,9 +88,24 @@ namespace Nebula {
 		// Script hot-reloading support
 		void ClearScriptInitialization(const std::string& scriptPath);
 
+		// Asset hot reload: replaces the meshes, material textures and skyboxes loaded from
+		// filepath (or from the folder it's in), leaving the rest of the scene alone.
+		// Returns how many components were updated.
+		uint32_t ReloadAssetReferences(const std::string& filepath);
+
+		// Cached entity queries (owned by the scene, cleared when the runtime stops)
+		uint32_t AddEntityQuery(std::unique_ptr<EntityQuery> query);
+		EntityQuery* GetEntityQuery(uint32_t queryID);
+		void RemoveEntityQuery(uint32_t queryID);
+
+	private:
+		void CloneHierarchy(entt::entity source, const entt::entity* clones, uint32_t count,
+			const std::string* rootName, std::vector<entt::entity>& created);
+
 	private:
 		std::string m_Name;
 		entt::registry m_Registry;
+		std::unique_ptr<TagIndex> m_TagIndex; // After m_Registry so it disconnects first
 		std::vector<entt::entity> m_EntityOrder;
 		std::unordered_map<std::pair<entt::entity, std::string>, bool, PairHash> m_LuaScriptInitialized;
 
@@ -100,11 +136,18 @@ namespace Nebula {
 
 		// Audio
 		std::unique_ptr<AudioEngine> m_AudioEngine;
+		bool m_WaitForAudioPreload = false;
 
 		// Physics
 		std::unique_ptr<PhysicsWorld> m_PhysicsWorld;
 	// Runtime state
 	bool m_IsRuntimeActive = false;
+
+	// Declared after m_Registry so queries disconnect before the registry is destroyed
+	std::unordered_map<uint32_t, std::unique_ptr<EntityQuery>> m_EntityQueries;
+	uint32_t m_NextEntityQueryID = 1;
+
+	TimerWheel m_TimerWheel;
 		friend class Entity;
 		friend class SceneHierarchyPanel;
 		friend class SceneSerializer;
@@ -4,6 +4,8 @@
 #include "Components.h"
 #include "Nebula/Audio/AudioEngine.h"
 #include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Asset/AssetManager.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 
@@ -123,6 +125,7 @@ namespace Nebula {
 
 		file << j.dump(4); // Pretty print with 4 space indentation
 		file.close();
+		AssetManager::SetDependencies(filepath, m_SceneList);
 
 		NB_INFO("SceneManager: Saved scene list to {0}", filepath);
 		return true;
@@ -130,8 +133,8 @@ namespace Nebula {
 
 	bool SceneManager::LoadSceneList(const std::string& filepath)
 	{
-		std::ifstream file(filepath);
-		if (!file.is_open())
+		VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+		if (!file)
 		{
 			NB_WARN("SceneManager: Scene list file not found: {0}", filepath);
 			return false;
@@ -139,9 +142,7 @@ namespace Nebula {
 
 		try
 		{
-			nlohmann::json j;
-			file >> j;
-			file.close();
+			nlohmann::json j = nlohmann::json::parse(file.GetData(), file.GetData() + file.GetSize());
 
 			m_SceneList.clear();
 			if (j.contains("scenes") && j["scenes"].is_array())
@@ -155,6 +156,7 @@ namespace Nebula {
 				}
 			}
 
+			AssetManager::SetDependencies(filepath, m_SceneList);
 			NB_INFO("SceneManager: Loaded scene list from {0} ({1} scenes)", filepath, m_SceneList.size());
 			return true;
 		}
@@ -3,6 +3,8 @@
 #include "Entity.h"
 #include "Components.h"
 #include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Asset/AssetManager.h"
 #include "Nebula/Renderer/Material.h"
 #include "Nebula/Renderer/Mesh.h"
 #include "Nebula/Renderer/Shader.h"
@@ -47,6 +49,52 @@ namespace Nebula {
 		return glm::vec4(j[0], j[1], j[2], j[3]);
 	}
 
+	// Every material is built on this shader for now
+	static const char* s_MaterialShaderPath = "Library/shaders/Basic.glsl";
+
+	// The files DeserializeEntity loads for the entities in sceneJson
+	static std::vector<std::string> CollectSceneDependencies(const json& sceneJson)
+	{
+		std::vector<std::string> dependencies;
+		if (!sceneJson.contains("Entities") || !sceneJson["Entities"].is_array())
+			return dependencies;
+
+		auto addString = [&dependencies](const json& object, const char* key, const std::string& prefix = "")
+		{
+			if (object.contains(key) && object[key].is_string() && !object[key].get<std::string>().empty())
+				dependencies.push_back(prefix + object[key].get<std::string>());
+		};
+
+		for (const auto& entityJson : sceneJson["Entities"])
+		{
+			if (entityJson.contains("MeshRendererComponent"))
+			{
+				const auto& meshRendererJson = entityJson["MeshRendererComponent"];
+				if (meshRendererJson.value("HasMesh", false))
+				{
+					if (meshRendererJson.contains("MeshSource"))
+						addString(meshRendererJson, "MeshSource");
+					else
+						addString(meshRendererJson, "MeshFile", "Library/models/");
+				}
+
+				if (meshRendererJson.value("HasMaterial", false) && meshRendererJson.contains("Material"))
+				{
+					dependencies.push_back(s_MaterialShaderPath);
+					addString(meshRendererJson["Material"], "TexturePath");
+				}
+			}
+
+			// The whole folder, the faces are found by name
+			if (entityJson.contains("SkyboxComponent"))
+				addString(entityJson["SkyboxComponent"], "DirectoryPath");
+
+			if (entityJson.contains("AudioSourceComponent"))
+				addString(entityJson["AudioSourceComponent"], "AudioClipPath");
+		}
+		return dependencies;
+	}
+
 	static void SerializeEntity(json& entityJson, Entity entity)
 	{
 		// Point Light Component
@@ -241,6 +289,7 @@ namespace Nebula {
 			audioJson["Loop"] = audioSource.Loop;
 			audioJson["PlayOnAwake"] = audioSource.PlayOnAwake;
 			audioJson["Spatial"] = audioSource.Spatial;
+			audioJson["Priority"] = audioSource.Priority;
 			audioJson["RolloffFactor"] = audioSource.RolloffFactor;
 			audioJson["ReferenceDistance"] = audioSource.ReferenceDistance;
 			audioJson["MaxDistance"] = audioSource.MaxDistance;
@@ -350,7 +399,7 @@ namespace Nebula {
 			if (hasMaterial && meshRendererJson.contains("Material"))
 			{
 				// Create a basic shader (this should come from asset system in the future)
-				Shader* shader = Shader::Create("Library/shaders/Basic.glsl");
+				Shader* shader = Shader::Create(s_MaterialShaderPath);
 				auto material = std::make_shared<Material>(std::shared_ptr<Shader>(shader));
 				
 				const auto& matJson = meshRendererJson["Material"];
@@ -569,6 +618,8 @@ namespace Nebula {
 				audioSource.PlayOnAwake = audioJson["PlayOnAwake"];
 			if (audioJson.contains("Spatial"))
 				audioSource.Spatial = audioJson["Spatial"];
+			if (audioJson.contains("Priority"))
+				audioSource.Priority = audioJson["Priority"];
 			if (audioJson.contains("RolloffFactor"))
 				audioSource.RolloffFactor = audioJson["RolloffFactor"];
 			if (audioJson.contains("ReferenceDistance"))
@@ -595,6 +646,7 @@ namespace Nebula {
 		// Scene metadata
 		sceneJson["Scene"]["Name"] = m_Scene->GetName();
 		sceneJson["Scene"]["Version"] = "1.0";
+		sceneJson["Scene"]["WaitForAudioPreload"] = m_Scene->GetWaitForAudioPreload();
 		
 		// Serialize all entities
 		json entitiesJson = json::array();
@@ -630,6 +682,8 @@ namespace Nebula {
 		// Write with pretty formatting (4 spaces indent)
 		file << sceneJson.dump(4);
 		file.close();
+
+		AssetManager::SetDependencies(filepath, CollectSceneDependencies(sceneJson));
 		
 		NB_CORE_INFO("Scene serialized to: {0}", filepath);
 		return true;
@@ -637,8 +691,8 @@ namespace Nebula {
 
 	bool SceneSerializer::Deserialize(const std::string& filepath)
 	{
-		std::ifstream file(filepath);
-		if (!file.is_open())
+		VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+		if (!file)
 		{
 			NB_CORE_ERROR("Failed to open scene file: {0}", filepath);
 			return false;
@@ -647,7 +701,7 @@ namespace Nebula {
 		json sceneJson;
 		try
 		{
-			file >> sceneJson;
+			sceneJson = json::parse(file.GetData(), file.GetData() + file.GetSize());
 		}
 		catch (json::parse_error& e)
 		{
@@ -655,8 +709,8 @@ namespace Nebula {
 			return false;
 		}
 		
-		file.close();
-		
+		AssetManager::SetDependencies(filepath, CollectSceneDependencies(sceneJson));
+
 		// Clear existing scene
 		m_Scene->Clear();
 		
@@ -665,6 +719,7 @@ namespace Nebula {
 		{
 			std::string sceneName = sceneJson["Scene"].value("Name", "Untitled");
 			m_Scene->SetName(sceneName);
+			m_Scene->SetWaitForAudioPreload(sceneJson["Scene"].value("WaitForAudioPreload", false));
 		}
 		
 		// Deserialize entities
@@ -729,12 +784,28 @@ namespace Nebula {
 	return true;
 }
 
+	std::vector<std::string> SceneSerializer::GetDependencies(const std::string& filepath)
+	{
+		VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+		if (!file)
+			return {};
+
+		json sceneJson = json::parse(file.GetData(), file.GetData() + file.GetSize(), nullptr, false);
+		if (sceneJson.is_discarded())
+		{
+			NB_CORE_ERROR("Failed to parse scene JSON: {0}", filepath);
+			return {};
+		}
+		return CollectSceneDependencies(sceneJson);
+	}
+
 	std::string SceneSerializer::SerializeToString()
 	{
 		json sceneJson;
 		
 		sceneJson["Scene"]["Name"] = m_Scene->GetName();
 		sceneJson["Scene"]["Version"] = "1.0";
+		sceneJson["Scene"]["WaitForAudioPreload"] = m_Scene->GetWaitForAudioPreload();
 		
 		json entitiesJson = json::array();
 		
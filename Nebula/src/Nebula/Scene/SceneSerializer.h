@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include <string>
+#include <vector>
 
 namespace Nebula {
 
@@ -20,6 +21,10 @@ namespace Nebula {
 		// Serialize to JSON string (for debugging/copying)
 		std::string SerializeToString();
 
+		// Files the scene loads (meshes, textures, shaders, clips, skybox folders), read
+		// without loading it. Registered as the AssetManager's dependency scanner for scenes.
+		static std::vector<std::string> GetDependencies(const std::string& filepath);
+
 	private:
 		Scene* m_Scene;
 	};
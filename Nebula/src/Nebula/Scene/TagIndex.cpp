@@ -0,0 +1,129 @@
+#include "nbpch.h"
+#include "TagIndex.h"
+#include "Components.h"
+
+namespace Nebula {
+
+	static const std::vector<uint32_t> s_EmptyEntities;
+
+	TagIndex::TagIndex(entt::registry& registry)
+		: m_Registry(registry)
+	{
+		m_Registry.on_construct<TagComponent>().connect<&TagIndex::OnTagConstructed>(*this);
+		m_Registry.on_update<TagComponent>().connect<&TagIndex::OnTagUpdated>(*this);
+		m_Registry.on_destroy<TagComponent>().connect<&TagIndex::OnTagDestroyed>(*this);
+	}
+
+	TagIndex::~TagIndex()
+	{
+		m_Registry.on_construct<TagComponent>().disconnect<&TagIndex::OnTagConstructed>(*this);
+		m_Registry.on_update<TagComponent>().disconnect<&TagIndex::OnTagUpdated>(*this);
+		m_Registry.on_destroy<TagComponent>().disconnect<&TagIndex::OnTagDestroyed>(*this);
+	}
+
+	// Versions skip 0, which GetVersion keeps for stale IDs
+	static void BumpVersion(uint32_t& version)
+	{
+		if (++version == 0)
+			version = 1;
+	}
+
+	uint32_t TagIndex::Intern(const std::string& tag)
+	{
+		auto it = m_Interned.find(tag);
+		if (it != m_Interned.end())
+			return it->second;
+
+		uint32_t id = m_NextID++;
+		if (m_NextID == InvalidID)
+			m_NextID = 1;
+
+		m_Buckets[id].Tag = tag;
+		m_Interned.emplace(tag, id);
+		BumpVersion(m_TagSetVersion);
+		return id;
+	}
+
+	const TagIndex::Bucket* TagIndex::FindBucket(uint32_t tagID) const
+	{
+		auto it = m_Buckets.find(tagID);
+		return it != m_Buckets.end() ? &it->second : nullptr;
+	}
+
+	uint32_t TagIndex::FindID(const std::string& tag) const
+	{
+		auto it = m_Interned.find(tag);
+		return it != m_Interned.end() ? it->second : InvalidID;
+	}
+
+	const std::vector<uint32_t>& TagIndex::GetEntities(uint32_t tagID) const
+	{
+		const Bucket* bucket = FindBucket(tagID);
+		return bucket ? bucket->Entities : s_EmptyEntities;
+	}
+
+	uint32_t TagIndex::GetVersion(uint32_t tagID) const
+	{
+		const Bucket* bucket = FindBucket(tagID);
+		return bucket ? bucket->Version : 0;
+	}
+
+	void TagIndex::OnTagConstructed(entt::registry& registry, entt::entity entity)
+	{
+		Insert((uint32_t)entity, registry.get<TagComponent>(entity).Tag);
+	}
+
+	void TagIndex::OnTagUpdated(entt::registry& registry, entt::entity entity)
+	{
+		const std::string& tag = registry.get<TagComponent>(entity).Tag;
+
+		auto it = m_Entries.find((uint32_t)entity);
+		if (it != m_Entries.end() && it->second.TagID == FindID(tag))
+			return;
+
+		Erase((uint32_t)entity);
+		Insert((uint32_t)entity, tag);
+	}
+
+	void TagIndex::OnTagDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		Erase((uint32_t)entity);
+	}
+
+	void TagIndex::Insert(uint32_t entityID, const std::string& tag)
+	{
+		uint32_t tagID = Intern(tag);
+		Bucket& bucket = m_Buckets[tagID];
+
+		m_Entries[entityID] = { tagID, (uint32_t)bucket.Entities.size() };
+		bucket.Entities.push_back(entityID);
+		BumpVersion(bucket.Version);
+	}
+
+	void TagIndex::Erase(uint32_t entityID)
+	{
+		auto it = m_Entries.find(entityID);
+		if (it == m_Entries.end())
+			return;
+
+		uint32_t tagID = it->second.TagID;
+		Bucket& bucket = m_Buckets[tagID];
+		uint32_t index = it->second.Index;
+		uint32_t last = bucket.Entities.back();
+
+		bucket.Entities[index] = last;
+		m_Entries[last].Index = index;
+		bucket.Entities.pop_back();
+		BumpVersion(bucket.Version);
+
+		m_Entries.erase(entityID);
+
+		// Drop the tag with its last entity, which leaves its ID stale
+		if (bucket.Entities.empty())
+		{
+			m_Interned.erase(bucket.Tag);
+			m_Buckets.erase(tagID);
+		}
+	}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <entt/entt.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Nebula {
+
+	// Maps TagComponent strings to the entities that carry them.
+	// Strings are interned to small IDs so repeated lookups can skip hashing
+	// the string entirely. Only tags some entity carries are interned: a tag's
+	// bucket goes away with its last entity and its ID goes stale, so the index
+	// stays as big as the scene instead of growing with every name ever asked about.
+	// Kept up to date through the registry's construct/update/destroy signals,
+	// so tag writes must go through registry.patch<TagComponent>()
+	// (see Scene::SetEntityTag) to be seen.
+	class NEBULA_API TagIndex
+	{
+	public:
+		static constexpr uint32_t InvalidID = 0;
+
+		explicit TagIndex(entt::registry& registry);
+		~TagIndex();
+
+		TagIndex(const TagIndex&) = delete;
+		TagIndex& operator=(const TagIndex&) = delete;
+
+		// Returns InvalidID if no entity has the tag. Never interns.
+		uint32_t FindID(const std::string& tag) const;
+
+		// Entities with the tag, empty for a stale ID. Removing an entity moves the
+		// last one into its place, so the front only changes when the front entity
+		// itself loses the tag.
+		const std::vector<uint32_t>& GetEntities(uint32_t tagID) const;
+		const std::vector<uint32_t>& GetEntities(const std::string& tag) const { return GetEntities(FindID(tag)); }
+
+		// Bumped whenever an entity gains or loses the tag. Never 0 for a live ID,
+		// 0 once the ID is stale and the tag has to be looked up again.
+		uint32_t GetVersion(uint32_t tagID) const;
+		// Bumped whenever a tag no entity had before shows up, so a failed
+		// FindID only needs retrying once this changes
+		uint32_t GetTagSetVersion() const { return m_TagSetVersion; }
+
+	private:
+		void OnTagConstructed(entt::registry& registry, entt::entity entity);
+		void OnTagUpdated(entt::registry& registry, entt::entity entity);
+		void OnTagDestroyed(entt::registry& registry, entt::entity entity);
+
+		void Insert(uint32_t entityID, const std::string& tag);
+		void Erase(uint32_t entityID);
+
+	private:
+		struct Bucket
+		{
+			std::vector<uint32_t> Entities;
+			uint32_t Version = 0;
+			std::string Tag; // Key in m_Interned, so the bucket can drop it when it empties
+		};
+
+		uint32_t Intern(const std::string& tag);
+		// nullptr for InvalidID or a stale ID
+		const Bucket* FindBucket(uint32_t tagID) const;
+
+		struct EntityEntry
+		{
+			uint32_t TagID;
+			uint32_t Index; // Position in the bucket so removal is a swap-and-pop
+		};
+
+		entt::registry& m_Registry;
+		std::unordered_map<std::string, uint32_t> m_Interned;
+		// Keyed by tag ID. IDs aren't reused, so one kept past its bucket's removal
+		// can't alias a later tag.
+		std::unordered_map<uint32_t, Bucket> m_Buckets;
+		uint32_t m_NextID = 1;
+		uint32_t m_TagSetVersion = 0;
+		std::unordered_map<uint32_t, EntityEntry> m_Entries;
+	};
+
+}
@@ -5,12 +5,73 @@
 #include "Nebula/Project/Project.h"
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
 #include <windows.h>
 
 namespace Nebula {
 
 	static std::string s_LastBuildError = "";
 
+	// Background build state. The worker only ever touches the message queue and
+	// the result; the assembly itself is swapped on the main thread in PollBuild().
+	static std::thread s_BuildThread;
+	static std::mutex s_BuildMutex;
+	static std::vector<ScriptBuildMessage> s_PendingMessages;
+	static std::atomic<bool> s_BuildRunning = false;
+	static std::atomic<bool> s_BuildFinished = false;
+	static ScriptBuildStatus s_BuildResult = ScriptBuildStatus::Idle;
+	static std::filesystem::path s_BuildProjectPath;
+	static bool s_RebuildQueued = false;
+
+	static constexpr uint64_t s_FNVOffsetBasis = 14695981039346656037ull;
+	static constexpr uint64_t s_FNVPrime = 1099511628211ull;
+
+	static void HashBytes(uint64_t& hash, const char* data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<uint8_t>(data[i]);
+			hash *= s_FNVPrime;
+		}
+	}
+
+	static bool HashFile(uint64_t& hash, const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		char buffer[4096];
+		while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+			HashBytes(hash, buffer, static_cast<size_t>(file.gcount()));
+
+		return true;
+	}
+
+	static std::filesystem::path GetBuildHashPath(const std::filesystem::path& projectPath)
+	{
+		return projectPath / "Assets" / "Scripts" / "bin" / "Debug" / "Scripts.buildhash";
+	}
+
+	static LogLevel ClassifyBuildLine(const std::string& line)
+	{
+		if (line.find(": error ") != std::string::npos || line.find("Build FAILED") != std::string::npos)
+			return LogLevel::LOG_ERROR;
+		if (line.find(": warning ") != std::string::npos)
+			return LogLevel::LOG_WARN;
+		if (line.find(" -> ") != std::string::npos || line.find("Build succeeded") != std::string::npos)
+			return LogLevel::LOG_INFO;
+		return LogLevel::LOG_TRACE;
+	}
+
+	static void PushBuildMessage(const std::string& message, LogLevel level)
+	{
+		std::lock_guard<std::mutex> lock(s_BuildMutex);
+		s_PendingMessages.push_back({ message, level });
+	}
+
 	bool ScriptBuilder::BuildProjectScripts(const std::filesystem::path& projectPath)
 	{
 		std::filesystem::path scriptDir = projectPath / "Assets" / "Scripts";
@@ -47,8 +108,7 @@ namespace Nebula {
 				return false;
 		}
 
-		// Run MSBuild
-		return RunMSBuild(csprojPath);
+		return BuildIfChanged(projectPath) != ScriptBuildStatus::Failed;
 	}
 
 	bool ScriptBuilder::GenerateProjectFile(const std::filesystem::path& projectPath)
@@ -95,7 +155,7 @@ namespace Nebula {
 		return true;
 	}
 
-	bool ScriptBuilder::RunMSBuild(const std::filesystem::path& csprojPath)
+	bool ScriptBuilder::RunMSBuild(const std::filesystem::path& csprojPath, const std::function<void(const std::string&)>& onOutputLine)
 	{
 		// Build the command - capture output for error reporting
 		std::string command = "dotnet build \"" + csprojPath.string() + "\" -c Debug --nologo 2>&1";
@@ -107,21 +167,35 @@ namespace Nebula {
 		FILE* pipe = _popen(command.c_str(), "r");
 		if (!pipe)
 		{
+			std::lock_guard<std::mutex> lock(s_BuildMutex);
 			s_LastBuildError = "Failed to execute build command";
 			NB_CORE_ERROR(s_LastBuildError);
 			return false;
 		}
 
-		// Read output
+		// Read output, forwarding complete lines as they arrive
 		char buffer[256];
 		std::stringstream output;
+		std::string line;
 		while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
 		{
 			output << buffer;
+			line += buffer;
+			if (!line.empty() && line.back() == '\n')
+			{
+				while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+					line.pop_back();
+				if (onOutputLine && !line.empty())
+					onOutputLine(line);
+				line.clear();
+			}
 		}
+		if (onOutputLine && !line.empty())
+			onOutputLine(line);
 
 		int result = _pclose(pipe);
-		
+
+		std::lock_guard<std::mutex> lock(s_BuildMutex);
 		if (result == 0)
 		{
 			NB_CORE_INFO("Scripts built successfully!");
@@ -137,6 +211,73 @@ namespace Nebula {
 		}
 	}
 
+	uint64_t ScriptBuilder::ComputeSourceHash(const std::filesystem::path& projectPath)
+	{
+		std::filesystem::path scriptDir = projectPath / "Assets" / "Scripts";
+
+		// Sort so the hash doesn't depend on directory enumeration order
+		std::vector<std::filesystem::path> sources;
+		std::error_code ec;
+		for (auto it = std::filesystem::recursive_directory_iterator(scriptDir, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		{
+			const auto& path = it->path();
+			if (it->is_directory() && (path.filename() == "bin" || path.filename() == "obj"))
+			{
+				it.disable_recursion_pending();
+				continue;
+			}
+			if (it->is_regular_file() && path.extension() == ".cs")
+				sources.push_back(path);
+		}
+		std::sort(sources.begin(), sources.end());
+
+		uint64_t hash = s_FNVOffsetBasis;
+		for (const auto& source : sources)
+		{
+			std::string relative = std::filesystem::relative(source, scriptDir).generic_string();
+			HashBytes(hash, relative.c_str(), relative.size() + 1);
+			HashFile(hash, source);
+		}
+
+		HashFile(hash, scriptDir / "Scripts.csproj");
+		HashFile(hash, projectPath / "Library" / "NebulaScriptCore.dll");
+		return hash;
+	}
+
+	ScriptBuildStatus ScriptBuilder::BuildIfChanged(const std::filesystem::path& projectPath, const std::function<void(const std::string&)>& onOutputLine)
+	{
+		std::filesystem::path scriptDir = projectPath / "Assets" / "Scripts";
+		std::filesystem::path csprojPath = scriptDir / "Scripts.csproj";
+		std::filesystem::path scriptAssembly = scriptDir / "bin" / "Debug" / "Scripts.dll";
+		std::filesystem::path hashPath = GetBuildHashPath(projectPath);
+
+		uint64_t hash = ComputeSourceHash(projectPath);
+
+		if (std::filesystem::exists(scriptAssembly))
+		{
+			std::ifstream hashFile(hashPath);
+			uint64_t cachedHash = 0;
+			if (hashFile >> std::hex >> cachedHash && cachedHash == hash)
+			{
+				NB_CORE_INFO("Scripts are up to date, skipping build");
+				return ScriptBuildStatus::UpToDate;
+			}
+		}
+
+		if (!RunMSBuild(csprojPath, onOutputLine))
+		{
+			std::error_code ec;
+			std::filesystem::remove(hashPath, ec);
+			return ScriptBuildStatus::Failed;
+		}
+
+		std::ofstream hashFile(hashPath);
+		if (hashFile.is_open())
+			hashFile << std::hex << hash;
+
+		return ScriptBuildStatus::Succeeded;
+	}
+
 	bool ScriptBuilder::RebuildScripts(const std::filesystem::path& projectPath)
 	{
 		std::filesystem::path scriptDir = projectPath / "Assets" / "Scripts";
@@ -148,8 +289,7 @@ namespace Nebula {
 			return false;
 		}
 
-		// Run MSBuild
-		if (!RunMSBuild(csprojPath))
+		if (BuildIfChanged(projectPath) == ScriptBuildStatus::Failed)
 			return false;
 
 		// Reload assembly
@@ -164,8 +304,116 @@ namespace Nebula {
 		return false;
 	}
 
+	void ScriptBuilder::RebuildScriptsAsync(const std::filesystem::path& projectPath)
+	{
+		{
+			// A finished build that hasn't been polled yet still has to be loaded by PollBuild,
+			// so queue behind it instead of throwing its result away
+			std::lock_guard<std::mutex> lock(s_BuildMutex);
+			if (s_BuildRunning || s_BuildFinished)
+			{
+				s_BuildProjectPath = projectPath;
+				s_RebuildQueued = true;
+				return;
+			}
+		}
+
+		if (s_BuildThread.joinable())
+			s_BuildThread.join();
+
+		std::filesystem::path csprojPath = projectPath / "Assets" / "Scripts" / "Scripts.csproj";
+		if (!std::filesystem::exists(csprojPath))
+		{
+			{
+				std::lock_guard<std::mutex> lock(s_BuildMutex);
+				s_LastBuildError = "Scripts.csproj not found";
+				s_BuildResult = ScriptBuildStatus::Failed;
+			}
+			s_BuildFinished = true;
+			return;
+		}
+
+		s_BuildProjectPath = projectPath;
+		s_BuildFinished = false;
+		s_BuildRunning = true;
+		PushBuildMessage("Building project scripts...", LogLevel::LOG_INFO);
+
+		s_BuildThread = std::thread([projectPath]()
+		{
+			ScriptBuildStatus result = BuildIfChanged(projectPath, [](const std::string& line)
+			{
+				PushBuildMessage(line, ClassifyBuildLine(line));
+			});
+
+			std::lock_guard<std::mutex> lock(s_BuildMutex);
+			s_BuildResult = result;
+			s_BuildFinished = true;
+			s_BuildRunning = false;
+		});
+	}
+
+	ScriptBuildStatus ScriptBuilder::PollBuild(std::vector<ScriptBuildMessage>& outMessages)
+	{
+		ScriptBuildStatus result;
+		bool startQueued = false;
+		std::filesystem::path projectPath;
+		{
+			std::lock_guard<std::mutex> lock(s_BuildMutex);
+			outMessages.insert(outMessages.end(), s_PendingMessages.begin(), s_PendingMessages.end());
+			s_PendingMessages.clear();
+
+			if (!s_BuildFinished)
+				return s_BuildRunning ? ScriptBuildStatus::Building : ScriptBuildStatus::Idle;
+
+			result = s_BuildResult;
+			s_BuildResult = ScriptBuildStatus::Idle;
+			s_BuildFinished = false;
+
+			startQueued = s_RebuildQueued;
+			s_RebuildQueued = false;
+			projectPath = s_BuildProjectPath;
+		}
+
+		if (s_BuildThread.joinable())
+			s_BuildThread.join();
+
+		// We're on the main thread between frames, so swapping the domain is safe here
+		if (result == ScriptBuildStatus::Succeeded)
+		{
+			std::filesystem::path scriptAssembly = projectPath / "Assets" / "Scripts" / "bin" / "Debug" / "Scripts.dll";
+			if (std::filesystem::exists(scriptAssembly))
+			{
+				ScriptEngine::LoadProjectAssembly(scriptAssembly);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(s_BuildMutex);
+				s_LastBuildError = "Scripts.dll not found after build";
+				result = ScriptBuildStatus::Failed;
+			}
+		}
+
+		// Changes arrived while we were building, the result above is already stale
+		if (startQueued)
+			RebuildScriptsAsync(projectPath);
+
+		return result;
+	}
+
+	bool ScriptBuilder::IsBuilding()
+	{
+		return s_BuildRunning;
+	}
+
+	void ScriptBuilder::WaitForBuild()
+	{
+		if (s_BuildThread.joinable())
+			s_BuildThread.join();
+	}
+
 	std::string ScriptBuilder::GetLastBuildError()
 	{
+		std::lock_guard<std::mutex> lock(s_BuildMutex);
 		return s_LastBuildError;
 	}
 
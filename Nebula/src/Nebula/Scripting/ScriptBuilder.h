@@ -1,29 +1,65 @@
 #pragma once
 
 #include "Nebula/Core.h"
+#include "Nebula/Log.h"
 #include <string>
 #include <filesystem>
+#include <functional>
 #include <vector>
 
 namespace Nebula {
 
+	enum class ScriptBuildStatus
+	{
+		Idle = 0,
+		Building,
+		Succeeded,
+		Failed,
+		UpToDate
+	};
+
+	// A single line of build output, classified so the editor can colour it
+	struct ScriptBuildMessage
+	{
+		std::string Message;
+		LogLevel Level = LogLevel::LOG_TRACE;
+	};
+
 	class NEBULA_API ScriptBuilder
 	{
 	public:
-		// Build the project scripts into an assembly
+		// Build the project scripts into an assembly (skipped when sources are unchanged)
 		static bool BuildProjectScripts(const std::filesystem::path& projectPath);
-		
+
 		// Rebuild scripts and reload assembly
 		static bool RebuildScripts(const std::filesystem::path& projectPath);
-		
+
+		// Start a rebuild on a background thread. If a build is already running,
+		// another one is queued and started as soon as the current one finishes.
+		static void RebuildScriptsAsync(const std::filesystem::path& projectPath);
+
+		// Call once per frame from the main thread at a point where no scripts are executing.
+		// Drains streamed build output into outMessages and, when a build has just finished,
+		// reloads the project assembly and returns its final status (returned exactly once).
+		static ScriptBuildStatus PollBuild(std::vector<ScriptBuildMessage>& outMessages);
+
+		static bool IsBuilding();
+
+		// Blocks until the background build (if any) has finished
+		static void WaitForBuild();
+
 		// Generate the .csproj file for the project scripts
 		static bool GenerateProjectFile(const std::filesystem::path& projectPath);
-		
+
 		// Get last build error message
 		static std::string GetLastBuildError();
 
+		// Content hash of every .cs file under Assets/Scripts plus the core assembly
+		static uint64_t ComputeSourceHash(const std::filesystem::path& projectPath);
+
 	private:
-		static bool RunMSBuild(const std::filesystem::path& csprojPath);
+		static bool RunMSBuild(const std::filesystem::path& csprojPath, const std::function<void(const std::string&)>& onOutputLine = nullptr);
+		static ScriptBuildStatus BuildIfChanged(const std::filesystem::path& projectPath, const std::function<void(const std::string&)>& onOutputLine = nullptr);
 	};
 
 }
@@ -16,6 +16,18 @@ namespace Nebula {
 			m_MonoClass = mono_class_from_name(s_Data->AppAssemblyImage, classNamespace.c_str(), className.c_str());
 	}
 
+	uint32_t ScriptClass::GenerateID()
+	{
+		static uint32_t s_NextID = 1;
+		return s_NextID++;
+	}
+
+	int32_t ScriptClass::GetFieldIndex(const std::string& name) const
+	{
+		auto it = m_FieldIndices.find(name);
+		return it != m_FieldIndices.end() ? (int32_t)it->second : -1;
+	}
+
 	MonoObject* ScriptClass::Instantiate()
 	{
 		MonoObject* instance = mono_object_new(s_Data->AppDomain, m_MonoClass);
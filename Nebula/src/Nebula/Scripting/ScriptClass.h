@@ -3,6 +3,7 @@
 #include "Nebula/Core.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 
 extern "C" {
@@ -42,6 +43,7 @@ namespace Nebula {
 		ScriptFieldType Type;
 		std::string Name;
 		MonoClassField* ClassField;
+		uint32_t Offset = 0; // Byte offset of the field inside a managed instance
 	};
 
 	class NEBULA_API ScriptClass
@@ -54,16 +56,25 @@ namespace Nebula {
 		MonoMethod* GetMethod(const std::string& name, int parameterCount);
 		MonoObject* InvokeMethod(MonoObject* instance, MonoMethod* method, void** params);
 
-		const std::unordered_map<std::string, ScriptField>& GetFields() const { return m_Fields; }
+		// Fields in declaration order, resolved once when the class is loaded
+		const std::vector<ScriptField>& GetFields() const { return m_Fields; }
+		int32_t GetFieldIndex(const std::string& name) const;
+		// Unique per loaded class, a reloaded class gets a new ID
+		uint32_t GetID() const { return m_ID; }
+		std::string GetFullName() const { return m_ClassNamespace.empty() ? m_ClassName : m_ClassNamespace + "." + m_ClassName; }
 
 	private:
 		std::string m_ClassNamespace;
 		std::string m_ClassName;
 
-		std::unordered_map<std::string, ScriptField> m_Fields;
+		std::vector<ScriptField> m_Fields;
+		std::unordered_map<std::string, uint32_t> m_FieldIndices;
+		uint32_t m_ID = GenerateID();
 
 		MonoClass* m_MonoClass = nullptr;
 
+		static uint32_t GenerateID();
+
 		friend class ScriptEngine;
 	};
 
@@ -1,6 +1,7 @@
 #include "nbpch.h"
 #include "ScriptEngine.h"
 #include "ScriptGlue.h"
+#include "ScriptScheduler.h"
 
 #include "Nebula/Scene/Scene.h"
 #include "Nebula/Scene/Entity.h"
@@ -71,6 +72,9 @@ namespace Nebula {
 	// Definition of the script engine data pointer
 	ScriptEngineData* s_Data = nullptr;
 
+	// Outside s_Data, it has to be set before Init
+	static ScriptCompileMode s_CompileMode = ScriptCompileMode::JIT;
+
 	static void PrintAssemblyTypes(MonoAssembly* assembly)
 {
 	MonoImage* image = mono_assembly_get_image(assembly);
@@ -100,6 +104,26 @@ namespace Nebula {
 		// NebulaScriptCore and project scripts are loaded in LoadProjectAssembly()
 	}
 
+	void ScriptEngine::SetCompileMode(ScriptCompileMode mode)
+	{
+		if (s_Data)
+		{
+			NB_CORE_WARN("ScriptEngine: compile mode can only be changed before Init");
+			return;
+		}
+		s_CompileMode = mode;
+	}
+
+	ScriptCompileMode ScriptEngine::GetCompileMode()
+	{
+		return s_CompileMode;
+	}
+
+	bool ScriptEngine::AreAssembliesAOTLoaded()
+	{
+		return s_Data && s_Data->CoreAssemblyAOT && s_Data->AppAssemblyAOT;
+	}
+
 void ScriptEngine::Shutdown()
 {
 	s_Data->EntityClasses.clear();
@@ -125,6 +149,10 @@ void ScriptEngine::OnRuntimeStop()
 {
 	s_Data->SceneContext = nullptr;
 	s_Data->EntityInstances.clear();
+	s_Data->UpdateList.clear();
+	s_Data->UpdateListIndex.clear();
+	s_Data->UpdateListDirty = false;
+	ScriptScheduler::Clear();
 }
 
 	bool ScriptEngine::EntityClassExists(const std::string& fullClassName)
@@ -152,7 +180,7 @@ void ScriptEngine::OnRuntimeStop()
 	void ScriptEngine::OnCreateEntity(Entity entity)
 	{
 		const auto& sc = entity.GetComponent<ScriptComponent>();
-		NB_CORE_INFO("OnCreateEntity called for class: {}", sc.ClassName);
+		NB_CORE_TRACE("OnCreateEntity called for class: {}", sc.ClassName);
 		
 		if (ScriptEngine::EntityClassExists(sc.ClassName))
 		{
@@ -160,28 +188,14 @@ void ScriptEngine::OnRuntimeStop()
 			
 			Ref<ScriptInstance> instance = CreateRef<ScriptInstance>(s_Data->EntityClasses[sc.ClassName], entity);
 			s_Data->EntityInstances[entityID] = instance;
+			if (instance->HasOnUpdate())
+				SetUpdateEnabled(entityID, true);
 
 			// Apply stored field values from component to instance
-			for (const auto& [fieldName, fieldValue] : sc.FieldValues)
-			{
-				switch (fieldValue.VarType)
-				{
-				case ScriptVariable::Type::Float:
-					instance->SetFieldValue(fieldName, fieldValue.FloatValue);
-					break;
-				case ScriptVariable::Type::Int:
-					instance->SetFieldValue(fieldName, fieldValue.IntValue);
-					break;
-				case ScriptVariable::Type::Bool:
-					instance->SetFieldValue(fieldName, fieldValue.BoolValue);
-					break;
-				default:
-					break;
-				}
-			}
+			instance->ApplyFieldValues(sc.FieldValues);
 
 			// Call OnCreate
-			NB_CORE_INFO("Calling OnCreate for entity {}", entityID);
+			NB_CORE_TRACE("Calling OnCreate for entity {}", entityID);
 			instance->InvokeOnCreate();
 		}
 		else
@@ -213,6 +227,78 @@ void ScriptEngine::OnRuntimeStop()
 		}
 	}
 
+	void ScriptEngine::OnUpdate(float deltaTime)
+	{
+		s_Data->UpdatingInstances = true;
+
+		// Indexed loop, OnUpdate may create entities that append to the list
+		for (size_t i = 0; i < s_Data->UpdateList.size(); i++)
+		{
+			if (s_Data->HasScriptException)
+				break;
+
+			Ref<ScriptInstance> instance = s_Data->UpdateList[i];
+			if (instance)
+				instance->InvokeOnUpdate(deltaTime);
+		}
+
+		s_Data->UpdatingInstances = false;
+
+		if (s_Data->UpdateListDirty)
+		{
+			auto& list = s_Data->UpdateList;
+			list.erase(std::remove(list.begin(), list.end(), nullptr), list.end());
+			s_Data->UpdateListIndex.clear();
+			for (size_t i = 0; i < list.size(); i++)
+				s_Data->UpdateListIndex[list[i]->GetEntityID()] = i;
+			s_Data->UpdateListDirty = false;
+		}
+
+		// Same handling as OnUpdateEntity: a script exception stops the runtime
+		if (s_Data->HasScriptException && s_Data->SceneContext)
+		{
+			NB_CORE_WARN("Stopping runtime due to C# script exception");
+			Log::LogClientMessage("Runtime stopped due to C# script exception", LOG_WARN);
+			s_Data->SceneContext->OnRuntimeStop();
+			s_Data->HasScriptException = false;
+		}
+	}
+
+	void ScriptEngine::SetUpdateEnabled(uint32_t entityID, bool enabled)
+	{
+		auto indexIt = s_Data->UpdateListIndex.find(entityID);
+		bool listed = indexIt != s_Data->UpdateListIndex.end();
+
+		if (enabled && !listed)
+		{
+			Ref<ScriptInstance> instance = GetEntityScriptInstance(entityID);
+			if (!instance || !instance->HasOnUpdate())
+				return;
+
+			s_Data->UpdateListIndex[entityID] = s_Data->UpdateList.size();
+			s_Data->UpdateList.push_back(instance);
+		}
+		else if (!enabled && listed)
+		{
+			size_t index = indexIt->second;
+			s_Data->UpdateListIndex.erase(indexIt);
+
+			if (s_Data->UpdatingInstances)
+			{
+				s_Data->UpdateList[index] = nullptr;
+				s_Data->UpdateListDirty = true;
+			}
+			else
+			{
+				auto& list = s_Data->UpdateList;
+				list[index] = list.back();
+				list.pop_back();
+				if (index < list.size() && list[index])
+					s_Data->UpdateListIndex[list[index]->GetEntityID()] = index;
+			}
+		}
+	}
+
 	void ScriptEngine::OnDestroyEntity(Entity entity)
 	{
 		uint32_t entityID = (uint32_t)entity;
@@ -220,6 +306,7 @@ void ScriptEngine::OnRuntimeStop()
 		{
 			Ref<ScriptInstance> instance = s_Data->EntityInstances[entityID];
 			instance->InvokeOnDestroy();
+			SetUpdateEnabled(entityID, false);
 			s_Data->EntityInstances.erase(entityID);
 		}
 	}
@@ -252,6 +339,9 @@ void ScriptEngine::OnRuntimeStop()
 		// Set Mono assembly and config directories using absolute paths
 		mono_set_dirs(monoLibPath.string().c_str(), monoEtcPath.string().c_str());
 
+		if (s_CompileMode == ScriptCompileMode::FullAOT)
+			mono_jit_set_aot_mode(MONO_AOT_MODE_FULL);
+
 		MonoDomain* rootDomain = mono_jit_init("NebulaJITRuntime");
 	if (!rootDomain)
 	{
@@ -266,8 +356,45 @@ void ScriptEngine::OnRuntimeStop()
 		// mono_jit_cleanup(s_Data->RootDomain);
 	}
 
-	MonoAssembly* ScriptEngine::LoadMonoAssembly(const std::filesystem::path& assemblyPath)
+	// mono --aot writes the native image next to the assembly, named after it
+	static std::filesystem::path GetAOTImagePath(const std::filesystem::path& assemblyPath)
+	{
+#if defined(_WIN32)
+		return assemblyPath.string() + ".dll";
+#elif defined(__APPLE__)
+		return assemblyPath.string() + ".dylib";
+#else
+		return assemblyPath.string() + ".so";
+#endif
+	}
+
+	MonoAssembly* ScriptEngine::LoadMonoAssembly(const std::filesystem::path& assemblyPath, bool* outAOT)
 	{
+		if (outAOT)
+			*outAOT = false;
+
+		// Mono only picks up a precompiled image for assemblies it opens from disk
+		if (s_CompileMode != ScriptCompileMode::JIT)
+		{
+			if (std::filesystem::exists(GetAOTImagePath(assemblyPath)))
+			{
+				std::string absolutePath = std::filesystem::absolute(assemblyPath).string();
+				MonoAssembly* assembly = mono_domain_assembly_open(mono_domain_get(), absolutePath.c_str());
+				if (assembly)
+				{
+					NB_CORE_INFO("Loaded AOT compiled assembly: {0}", assemblyPath.string());
+					if (outAOT)
+						*outAOT = true;
+					return assembly;
+				}
+				NB_CORE_WARN("Failed to open {0} from disk, falling back to JIT", assemblyPath.string());
+			}
+			else if (s_CompileMode == ScriptCompileMode::FullAOT)
+			{
+				NB_CORE_ERROR("No AOT image for {0}, full AOT mode can't JIT it", assemblyPath.string());
+			}
+		}
+
 		std::ifstream stream(assemblyPath, std::ios::binary | std::ios::ate);
 	if (!stream.is_open())
 	{
@@ -304,13 +431,13 @@ void ScriptEngine::OnRuntimeStop()
 		s_Data->AppDomain = mono_domain_create_appdomain((char*)"NebulaScriptRuntime", nullptr);
 		mono_domain_set(s_Data->AppDomain, true);
 
-		s_Data->CoreAssembly = LoadMonoAssembly(filepath);
+		s_Data->CoreAssembly = LoadMonoAssembly(filepath, &s_Data->CoreAssemblyAOT);
 		s_Data->CoreAssemblyImage = mono_assembly_get_image(s_Data->CoreAssembly);
 	}
 
 	void ScriptEngine::LoadAppAssembly(const std::filesystem::path& filepath)
 	{
-		s_Data->AppAssembly = LoadMonoAssembly(filepath);
+		s_Data->AppAssembly = LoadMonoAssembly(filepath, &s_Data->AppAssemblyAOT);
 		if (s_Data->AppAssembly)
 		{
 			s_Data->AppAssemblyImage = mono_assembly_get_image(s_Data->AppAssembly);
@@ -341,7 +468,7 @@ void ScriptEngine::OnRuntimeStop()
 
 		// Reload core assembly from project's Library folder
 		std::filesystem::path corePath = "Library/NebulaScriptCore.dll";
-		s_Data->CoreAssembly = LoadMonoAssembly(corePath);
+		s_Data->CoreAssembly = LoadMonoAssembly(corePath, &s_Data->CoreAssemblyAOT);
 		if (!s_Data->CoreAssembly)
 		{
 			NB_CORE_ERROR("Failed to load NebulaScriptCore assembly!");
@@ -459,7 +586,8 @@ void ScriptEngine::OnRuntimeStop()
 					NB_CORE_WARN("  {} ({}) {}", fieldName, ScriptFieldTypeToString(fieldType), 
 						hasSerializeField ? "[SerializeField]" : "");
 
-					scriptClass->m_Fields[fieldName] = { fieldType, fieldName, field };
+					scriptClass->m_FieldIndices[fieldName] = (uint32_t)scriptClass->m_Fields.size();
+					scriptClass->m_Fields.push_back({ fieldType, fieldName, field, mono_field_get_offset(field) });
 				}
 			}
 		}
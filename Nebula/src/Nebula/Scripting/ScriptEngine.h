@@ -29,6 +29,14 @@ namespace Nebula {
 	{
 	};
 
+	// How managed code gets compiled. Must be set before ScriptEngine::Init.
+	enum class ScriptCompileMode
+	{
+		JIT = 0, // Assemblies are loaded from memory and JIT compiled, keeps the files unlocked for the editor
+		AOT,     // Assemblies with a precompiled image next to them (mono --aot) use it, the rest is JIT compiled
+		FullAOT  // Everything, the BCL included, must be precompiled (mono --aot=full), the JIT is disabled
+	};
+
 	NEBULA_API const char* ScriptFieldTypeToString(ScriptFieldType type);
 	NEBULA_API ScriptFieldType MonoTypeToScriptFieldType(MonoType* monoType);
 
@@ -38,6 +46,12 @@ namespace Nebula {
 		static void Init();
 		static void Shutdown();
 
+		static void SetCompileMode(ScriptCompileMode mode);
+		static ScriptCompileMode GetCompileMode();
+		// True once both the core and the project assembly were opened with their precompiled
+		// image. The AOT modes fall back to JIT for assemblies without one.
+		static bool AreAssembliesAOTLoaded();
+
 		static void LoadProjectAssembly(const std::filesystem::path& assemblyPath);
 		static void ReloadAssembly();
 
@@ -46,6 +60,9 @@ namespace Nebula {
 
 		static bool EntityClassExists(const std::string& fullClassName);	static std::vector<std::string> GetEntityClassNames();	static Ref<ScriptClass> GetEntityScriptClass(const std::string& fullClassName);		static void OnCreateEntity(Entity entity);
 		static void OnUpdateEntity(Entity entity, float deltaTime);
+		// Calls OnUpdate on every instance in the update set
+		static void OnUpdate(float deltaTime);
+		static void SetUpdateEnabled(uint32_t entityID, bool enabled);
 		static void OnDestroyEntity(Entity entity);
 
 		static Scene* GetSceneContext();
@@ -56,7 +73,8 @@ namespace Nebula {
 		static void InitMono();
 		static void ShutdownMono();
 		
-		static MonoAssembly* LoadMonoAssembly(const std::filesystem::path& assemblyPath);
+		// outAOT is set to whether the assembly was opened with its precompiled image
+		static MonoAssembly* LoadMonoAssembly(const std::filesystem::path& assemblyPath, bool* outAOT = nullptr);
 		static void LoadAssembly(const std::filesystem::path& filepath);
 		static void LoadAppAssembly(const std::filesystem::path& filepath);
 		
@@ -78,11 +96,21 @@ namespace Nebula {
 		MonoAssembly* AppAssembly = nullptr;
 		MonoImage* AppAssemblyImage = nullptr;
 
+		bool CoreAssemblyAOT = false;
+		bool AppAssemblyAOT = false;
+
 		Ref<ScriptClass> EntityClass;
 
 		std::unordered_map<std::string, Ref<ScriptClass>> EntityClasses;
 		std::unordered_map<uint32_t, Ref<ScriptInstance>> EntityInstances;
 
+		// Instances that receive OnUpdate. Removal during the update loop leaves a null slot
+		// that is compacted afterwards, so the loop never skips or repeats an instance.
+		std::vector<Ref<ScriptInstance>> UpdateList;
+		std::unordered_map<uint32_t, size_t> UpdateListIndex;
+		bool UpdatingInstances = false;
+		bool UpdateListDirty = false;
+
 		Scene* SceneContext = nullptr;
 		
 		// Exception tracking
@@ -0,0 +1,114 @@
+#include "nbpch.h"
+#include "ScriptFieldStorage.h"
+#include "ScriptClass.h"
+
+#include <cstring>
+
+namespace Nebula {
+
+	static uint32_t HashFieldName(const std::string& name)
+	{
+		// FNV-1a
+		uint32_t hash = 2166136261u;
+		for (char c : name)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	static bool IsMatchingFieldType(ScriptFieldStorage::Type type, ScriptFieldType fieldType)
+	{
+		switch (type)
+		{
+		case ScriptFieldStorage::Type::Float: return fieldType == ScriptFieldType::Float;
+		case ScriptFieldStorage::Type::Int:   return fieldType == ScriptFieldType::Int;
+		case ScriptFieldStorage::Type::Bool:  return fieldType == ScriptFieldType::Bool;
+		}
+		return false;
+	}
+
+	void ScriptFieldStorage::SetValue(const std::string& name, Type type, const void* value)
+	{
+		// Copy on write, other components may still share the block
+		if (!m_Data)
+			m_Data = std::make_shared<Data>();
+		else if (m_Data.use_count() > 1)
+			m_Data = std::make_shared<Data>(*m_Data);
+
+		int32_t index = FindRecord(name);
+		if (index < 0)
+		{
+			Record record{};
+			record.NameHash = HashFieldName(name);
+			record.NameOffset = (uint32_t)m_Data->Names.size();
+			m_Data->Names.append(name);
+			m_Data->Names.push_back('\0');
+			m_Data->Records.push_back(record);
+			m_Data->ResolvedClassID = 0;
+			index = (int32_t)m_Data->Records.size() - 1;
+		}
+
+		Record& record = m_Data->Records[index];
+		if (record.ValueType != type)
+			m_Data->ResolvedClassID = 0;
+		record.ValueType = type;
+		memset(record.Value, 0, sizeof(record.Value));
+		memcpy(record.Value, value, GetValueSize(type));
+	}
+
+	bool ScriptFieldStorage::GetValue(const std::string& name, Type type, void* outValue) const
+	{
+		int32_t index = FindRecord(name);
+		if (index < 0)
+			return false;
+
+		const Record& record = m_Data->Records[index];
+		if (record.ValueType != type)
+			return false;
+
+		memcpy(outValue, record.Value, GetValueSize(type));
+		return true;
+	}
+
+	int32_t ScriptFieldStorage::FindRecord(const std::string& name) const
+	{
+		if (!m_Data)
+			return -1;
+
+		uint32_t hash = HashFieldName(name);
+		const auto& records = m_Data->Records;
+		for (size_t i = 0; i < records.size(); i++)
+		{
+			if (records[i].NameHash == hash && name == m_Data->Names.c_str() + records[i].NameOffset)
+				return (int32_t)i;
+		}
+		return -1;
+	}
+
+	const std::vector<int32_t>& ScriptFieldStorage::ResolveFields(const ScriptClass& scriptClass) const
+	{
+		static const std::vector<int32_t> s_Empty;
+		if (!m_Data)
+			return s_Empty;
+
+		if (m_Data->ResolvedClassID == scriptClass.GetID())
+			return m_Data->FieldIndices;
+
+		const auto& fields = scriptClass.GetFields();
+		m_Data->FieldIndices.resize(m_Data->Records.size());
+		for (size_t i = 0; i < m_Data->Records.size(); i++)
+		{
+			const Record& record = m_Data->Records[i];
+			int32_t fieldIndex = scriptClass.GetFieldIndex(m_Data->Names.c_str() + record.NameOffset);
+			if (fieldIndex >= 0 && !IsMatchingFieldType(record.ValueType, fields[fieldIndex].Type))
+				fieldIndex = -1;
+			m_Data->FieldIndices[i] = fieldIndex;
+		}
+		m_Data->ResolvedClassID = scriptClass.GetID();
+
+		return m_Data->FieldIndices;
+	}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nebula {
+
+	class ScriptClass;
+
+	// Editor-set values for a script's fields (ScriptComponent::FieldValues).
+	// Each value is a 16-byte record and all names share one buffer. Copies of a component
+	// share the same block until one of them is edited, so cloning a scripted entity
+	// doesn't copy any per-field data.
+	class NEBULA_API ScriptFieldStorage
+	{
+	public:
+		enum class Type : uint8_t { Float, Int, Bool };
+
+		struct Record
+		{
+			uint32_t NameHash;
+			uint32_t NameOffset; // Into the shared name buffer
+			Type ValueType;
+			uint8_t Value[4];
+		};
+
+		void Set(const std::string& name, float value) { SetValue(name, Type::Float, &value); }
+		void Set(const std::string& name, int32_t value) { SetValue(name, Type::Int, &value); }
+		void Set(const std::string& name, bool value) { SetValue(name, Type::Bool, &value); }
+
+		// False if nothing is stored under name or it was stored as another type
+		bool Get(const std::string& name, float& outValue) const { return GetValue(name, Type::Float, &outValue); }
+		bool Get(const std::string& name, int32_t& outValue) const { return GetValue(name, Type::Int, &outValue); }
+		bool Get(const std::string& name, bool& outValue) const { return GetValue(name, Type::Bool, &outValue); }
+
+		bool Contains(const std::string& name) const { return FindRecord(name) >= 0; }
+		size_t GetCount() const { return m_Data ? m_Data->Records.size() : 0; }
+		const Record& GetRecord(size_t index) const { return m_Data->Records[index]; }
+		void Clear() { m_Data.reset(); }
+
+		// Field index in scriptClass for every record, -1 where the class has no field of that
+		// name and type. Resolved once per class and cached in the shared block.
+		const std::vector<int32_t>& ResolveFields(const ScriptClass& scriptClass) const;
+
+		static uint32_t GetValueSize(Type type) { return type == Type::Bool ? 1 : 4; }
+
+	private:
+		struct Data
+		{
+			std::vector<Record> Records;
+			std::string Names; // '\0' separated
+
+			uint32_t ResolvedClassID = 0;
+			std::vector<int32_t> FieldIndices;
+		};
+
+		void SetValue(const std::string& name, Type type, const void* value);
+		bool GetValue(const std::string& name, Type type, void* outValue) const;
+		int32_t FindRecord(const std::string& name) const;
+
+		std::shared_ptr<Data> m_Data;
+	};
+
+}
@@ -1,6 +1,7 @@
 #include "nbpch.h"
 #include "ScriptGlue.h"
 #include "ScriptEngine.h"
+#include "ScriptScheduler.h"
 
 #include "Nebula/Core.h"
 #include "Nebula/Log.h"
@@ -11,6 +12,8 @@
 #include "Nebula/Scene/Scene.h"
 #include "Nebula/Scene/Entity.h"
 #include "Nebula/Scene/Components.h"
+#include "Nebula/Scene/EntityQuery.h"
+#include "Nebula/Scene/TagIndex.h"
 
 #include <btBulletDynamicsCommon.h>
 
@@ -20,10 +23,188 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
+
 namespace Nebula {
 
-	static std::unordered_map<MonoType*, std::function<bool(Entity)>> s_EntityHasComponentFuncs;
-	static std::unordered_map<uint32_t, float> s_DestroyDelayedEntities; // entityID -> timeRemaining
+	// Components scripts can access. A type's index in this group is its component ID,
+	// which the managed side caches per type (Nebula.ComponentTypeID<T>) and passes back
+	// to the *ByID internal calls, so dispatch is a bounds check and an indirect call.
+	using ScriptComponents = ComponentGroup<TransformComponent, MeshRendererComponent, CameraComponent, TagComponent,
+		BoxColliderComponent, SphereColliderComponent, RigidBodyComponent, AudioSourceComponent,
+		LineRendererComponent, PointLightComponent, DirectionalLightComponent>;
+
+	template<typename T, typename... Component>
+	static constexpr int32_t GetComponentID(ComponentGroup<Component...>)
+	{
+		constexpr bool matches[] = { std::is_same_v<T, Component>... };
+		for (int32_t i = 0; i < (int32_t)sizeof...(Component); i++)
+		{
+			if (matches[i])
+				return i;
+		}
+		return -1;
+	}
+
+	template<typename... Component>
+	static constexpr size_t GetComponentCount(ComponentGroup<Component...>) { return sizeof...(Component); }
+
+	static constexpr size_t s_ScriptComponentCount = GetComponentCount(ScriptComponents{});
+	static constexpr size_t s_MaxComponentFields = 8;
+
+	// Copies C++ component data into the matching fields of a managed component instance.
+	// Field handles are resolved once per assembly load, see RegisterComponent.
+	template<typename T>
+	struct ComponentMarshaller
+	{
+		static constexpr std::array<const char*, 0> Fields = {};
+		static void Write(const T&, MonoObject*, MonoClassField* const*) {}
+	};
+
+	static void SetManagedField(MonoObject* object, MonoClassField* field, const void* value)
+	{
+		if (field)
+			mono_field_set_value(object, field, const_cast<void*>(value));
+	}
+
+	template<>
+	struct ComponentMarshaller<TransformComponent>
+	{
+		static constexpr std::array<const char*, 3> Fields = { "Position", "Rotation", "Scale" };
+		static void Write(const TransformComponent& tc, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &tc.Position);
+			SetManagedField(out, fields[1], &tc.Rotation);
+			SetManagedField(out, fields[2], &tc.Scale);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<TagComponent>
+	{
+		static constexpr std::array<const char*, 1> Fields = { "Tag" };
+		static void Write(const TagComponent& tc, MonoObject* out, MonoClassField* const* fields)
+		{
+			if (fields[0])
+				mono_field_set_value(out, fields[0], mono_string_new(mono_domain_get(), tc.Tag.c_str()));
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<CameraComponent>
+	{
+		static constexpr std::array<const char*, 4> Fields = { "Primary", "FOV", "NearClip", "FarClip" };
+		static void Write(const CameraComponent& cc, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &cc.Primary);
+			SetManagedField(out, fields[1], &cc.PerspectiveFOV);
+			SetManagedField(out, fields[2], &cc.PerspectiveNear);
+			SetManagedField(out, fields[3], &cc.PerspectiveFar);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<BoxColliderComponent>
+	{
+		static constexpr std::array<const char*, 2> Fields = { "Size", "Offset" };
+		static void Write(const BoxColliderComponent& bc, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &bc.Size);
+			SetManagedField(out, fields[1], &bc.Offset);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<SphereColliderComponent>
+	{
+		static constexpr std::array<const char*, 2> Fields = { "Radius", "Offset" };
+		static void Write(const SphereColliderComponent& sc, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &sc.Radius);
+			SetManagedField(out, fields[1], &sc.Offset);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<RigidBodyComponent>
+	{
+		static constexpr std::array<const char*, 2> Fields = { "Mass", "IsKinematic" };
+		static void Write(const RigidBodyComponent& rb, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &rb.Mass);
+			SetManagedField(out, fields[1], &rb.IsKinematic);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<AudioSourceComponent>
+	{
+		static constexpr std::array<const char*, 5> Fields = { "Volume", "Pitch", "Loop", "PlayOnAwake", "Spatial" };
+		static void Write(const AudioSourceComponent& ac, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &ac.Volume);
+			SetManagedField(out, fields[1], &ac.Pitch);
+			SetManagedField(out, fields[2], &ac.Loop);
+			SetManagedField(out, fields[3], &ac.PlayOnAwake);
+			SetManagedField(out, fields[4], &ac.Spatial);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<LineRendererComponent>
+	{
+		static constexpr std::array<const char*, 3> Fields = { "Color", "Width", "Loop" };
+		static void Write(const LineRendererComponent& lc, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &lc.Color);
+			SetManagedField(out, fields[1], &lc.Width);
+			SetManagedField(out, fields[2], &lc.Loop);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<PointLightComponent>
+	{
+		static constexpr std::array<const char*, 4> Fields = { "Position", "Color", "Intensity", "Radius" };
+		static void Write(const PointLightComponent& pl, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &pl.Position);
+			SetManagedField(out, fields[1], &pl.Color);
+			SetManagedField(out, fields[2], &pl.Intensity);
+			SetManagedField(out, fields[3], &pl.Radius);
+		}
+	};
+
+	template<>
+	struct ComponentMarshaller<DirectionalLightComponent>
+	{
+		static constexpr std::array<const char*, 2> Fields = { "Color", "Intensity" };
+		static void Write(const DirectionalLightComponent& dl, MonoObject* out, MonoClassField* const* fields)
+		{
+			SetManagedField(out, fields[0], &dl.Color);
+			SetManagedField(out, fields[1], &dl.Intensity);
+		}
+	};
+
+	struct ComponentFuncs
+	{
+		bool (*Has)(Entity entity) = nullptr;
+		void (*Add)(Entity entity) = nullptr;
+		void (*Remove)(Entity entity) = nullptr;
+		// Returns false if the entity doesn't have the component
+		bool (*Get)(Entity entity, MonoObject* outComponent, MonoClassField* const* fields) = nullptr;
+		// Copies up to capacity entity IDs and returns the total number of entities with the component
+		uint32_t (*Collect)(Scene* scene, uint32_t* out, uint32_t capacity) = nullptr;
+		void (*Require)(EntityQuery& query) = nullptr;
+
+		MonoClassField* Fields[s_MaxComponentFields] = {};
+	};
+
+	// Indexed by component ID
+	static std::array<ComponentFuncs, s_ScriptComponentCount> s_ComponentFuncs;
+	// Only used to hand out IDs and for the older System.Type based calls
+	static std::unordered_map<MonoType*, int32_t> s_ComponentTypeIDs;
+
 	static glm::vec2 s_LastMousePos = glm::vec2(0.0f);
 	static glm::vec2 s_MouseDelta = glm::vec2(0.0f);
 	static glm::vec2 s_MouseScrollDelta = glm::vec2(0.0f);
@@ -213,18 +394,41 @@ namespace Nebula {
 	}
 
 	// Entity API
-	static bool Entity_HasComponent(uint32_t entityID, MonoReflectionType* componentType)
+	static int32_t GetComponentTypeID(MonoReflectionType* componentType)
+	{
+		if (!componentType)
+			return -1;
+
+		auto it = s_ComponentTypeIDs.find(mono_reflection_type_get_type(componentType));
+		return it != s_ComponentTypeIDs.end() ? it->second : -1;
+	}
+
+	static const ComponentFuncs* GetComponentFuncs(int32_t componentID)
+	{
+		if ((uint32_t)componentID >= (uint32_t)s_ScriptComponentCount)
+			return nullptr;
+		return &s_ComponentFuncs[componentID];
+	}
+
+	// Called once per component type, the managed side caches the result
+	static int32_t Entity_GetComponentTypeID(MonoReflectionType* componentType)
+	{
+		return GetComponentTypeID(componentType);
+	}
+
+	static bool Entity_HasComponentByID(uint32_t entityID, int32_t componentID)
 	{
+		const ComponentFuncs* funcs = GetComponentFuncs(componentID);
+		if (!funcs)
+			return false;
+
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
-		
+
 		Entity entity{ (entt::entity)entityID, scene };
 		NEB_CORE_ASSERT(entity, "Invalid entity!");
 
-		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		NEB_CORE_ASSERT(s_EntityHasComponentFuncs.find(managedType) != s_EntityHasComponentFuncs.end(), "Unknown component type!");
-		
-		return s_EntityHasComponentFuncs.at(managedType)(entity);
+		return funcs->Has(entity);
 	}
 
 	// Transform Component API
@@ -295,8 +499,12 @@ namespace Nebula {
 	}
 
 	// General Component API
-	static bool Entity_GetComponent(uint32_t entityID, MonoReflectionType* componentType, MonoObject* outComponent)
+	static bool Entity_GetComponentByID(uint32_t entityID, int32_t componentID, MonoObject* outComponent)
 	{
+		const ComponentFuncs* funcs = GetComponentFuncs(componentID);
+		if (!funcs || !outComponent)
+			return false;
+
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 		
@@ -304,282 +512,60 @@ namespace Nebula {
 		if (!entity)
 			return false;
 
-		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		MonoClass* monoClass = mono_type_get_class(managedType);
-		
-		const char* className = mono_class_get_name(monoClass);
-		
-		// Handle TransformComponent
-		if (strcmp(className, "TransformComponent") == 0 && entity.HasComponent<TransformComponent>())
-		{
-			auto& tc = entity.GetComponent<TransformComponent>();
-			MonoClassField* posField = mono_class_get_field_from_name(monoClass, "Position");
-			MonoClassField* rotField = mono_class_get_field_from_name(monoClass, "Rotation");
-			MonoClassField* scaleField = mono_class_get_field_from_name(monoClass, "Scale");
-			if (posField) mono_field_set_value(outComponent, posField, &tc.Position);
-			if (rotField) mono_field_set_value(outComponent, rotField, &tc.Rotation);
-			if (scaleField) mono_field_set_value(outComponent, scaleField, &tc.Scale);
-			NB_CORE_INFO("Entity_GetComponent: TransformComponent for entity {}", entityID);
-			return true;
-		}
-		
-		// Handle RigidBodyComponent
-		if (strcmp(className, "RigidBodyComponent") == 0 && entity.HasComponent<RigidBodyComponent>())
-		{
-			auto& rb = entity.GetComponent<RigidBodyComponent>();
-			MonoClassField* massField = mono_class_get_field_from_name(monoClass, "Mass");
-			MonoClassField* kinematicField = mono_class_get_field_from_name(monoClass, "IsKinematic");
-			if (massField) mono_field_set_value(outComponent, massField, &rb.Mass);
-			if (kinematicField) mono_field_set_value(outComponent, kinematicField, &rb.IsKinematic);
-			return true;
-		}
-		
-		// Handle TagComponent
-		if (strcmp(className, "TagComponent") == 0 && entity.HasComponent<TagComponent>())
-		{
-			auto& tc = entity.GetComponent<TagComponent>();
-			MonoClassField* tagField = mono_class_get_field_from_name(monoClass, "Tag");
-			if (tagField) {
-				MonoString* tagStr = mono_string_new(mono_domain_get(), tc.Tag.c_str());
-				mono_field_set_value(outComponent, tagField, tagStr);
-			}
-			return true;
-		}
-		
-		// Handle CameraComponent
-		if (strcmp(className, "CameraComponent") == 0 && entity.HasComponent<CameraComponent>())
-		{
-			auto& cc = entity.GetComponent<CameraComponent>();
-			MonoClassField* primaryField = mono_class_get_field_from_name(monoClass, "Primary");
-			MonoClassField* fovField = mono_class_get_field_from_name(monoClass, "FOV");
-			MonoClassField* nearField = mono_class_get_field_from_name(monoClass, "NearClip");
-			MonoClassField* farField = mono_class_get_field_from_name(monoClass, "FarClip");
-			if (primaryField) mono_field_set_value(outComponent, primaryField, &cc.Primary);
-			if (fovField) mono_field_set_value(outComponent, fovField, &cc.PerspectiveFOV);
-			if (nearField) mono_field_set_value(outComponent, nearField, &cc.PerspectiveNear);
-			if (farField) mono_field_set_value(outComponent, farField, &cc.PerspectiveFar);
-			return true;
-		}
-		
-		// Handle BoxColliderComponent
-		if (strcmp(className, "BoxColliderComponent") == 0 && entity.HasComponent<BoxColliderComponent>())
-		{
-			auto& bc = entity.GetComponent<BoxColliderComponent>();
-			MonoClassField* sizeField = mono_class_get_field_from_name(monoClass, "Size");
-			MonoClassField* offsetField = mono_class_get_field_from_name(monoClass, "Offset");
-			if (sizeField) mono_field_set_value(outComponent, sizeField, &bc.Size);
-			if (offsetField) mono_field_set_value(outComponent, offsetField, &bc.Offset);
-			return true;
-		}
-		
-		// Handle SphereColliderComponent
-		if (strcmp(className, "SphereColliderComponent") == 0 && entity.HasComponent<SphereColliderComponent>())
-		{
-			auto& sc = entity.GetComponent<SphereColliderComponent>();
-			MonoClassField* radiusField = mono_class_get_field_from_name(monoClass, "Radius");
-			MonoClassField* offsetField = mono_class_get_field_from_name(monoClass, "Offset");
-			if (radiusField) mono_field_set_value(outComponent, radiusField, &sc.Radius);
-			if (offsetField) mono_field_set_value(outComponent, offsetField, &sc.Offset);
-			return true;
-		}
-		
-		// Handle AudioSourceComponent
-		if (strcmp(className, "AudioSourceComponent") == 0 && entity.HasComponent<AudioSourceComponent>())
-		{
-			auto& ac = entity.GetComponent<AudioSourceComponent>();
-			MonoClassField* volumeField = mono_class_get_field_from_name(monoClass, "Volume");
-			MonoClassField* pitchField = mono_class_get_field_from_name(monoClass, "Pitch");
-			MonoClassField* loopField = mono_class_get_field_from_name(monoClass, "Loop");
-			MonoClassField* playOnAwakeField = mono_class_get_field_from_name(monoClass, "PlayOnAwake");
-			MonoClassField* spatialField = mono_class_get_field_from_name(monoClass, "Spatial");
-			if (volumeField) mono_field_set_value(outComponent, volumeField, &ac.Volume);
-			if (pitchField) mono_field_set_value(outComponent, pitchField, &ac.Pitch);
-			if (loopField) mono_field_set_value(outComponent, loopField, &ac.Loop);
-			if (playOnAwakeField) mono_field_set_value(outComponent, playOnAwakeField, &ac.PlayOnAwake);
-			if (spatialField) mono_field_set_value(outComponent, spatialField, &ac.Spatial);
-			return true;
-		}
-		
-		// Handle LineRendererComponent
-		if (strcmp(className, "LineRendererComponent") == 0 && entity.HasComponent<LineRendererComponent>())
-		{
-			auto& lc = entity.GetComponent<LineRendererComponent>();
-			MonoClassField* colorField = mono_class_get_field_from_name(monoClass, "Color");
-			MonoClassField* widthField = mono_class_get_field_from_name(monoClass, "Width");
-			MonoClassField* loopField = mono_class_get_field_from_name(monoClass, "Loop");
-			if (colorField) mono_field_set_value(outComponent, colorField, &lc.Color);
-			if (widthField) mono_field_set_value(outComponent, widthField, &lc.Width);
-			if (loopField) mono_field_set_value(outComponent, loopField, &lc.Loop);
-			return true;
-		}
-		
-		// Handle MeshRendererComponent
-		if (strcmp(className, "MeshRendererComponent") == 0 && entity.HasComponent<MeshRendererComponent>())
-		{
-			// MeshRendererComponent has no fields to sync currently (Mesh and Material are C++ only)
-			return true;
-		}
-		
-		// Handle PointLightComponent
-		if (strcmp(className, "PointLightComponent") == 0 && entity.HasComponent<PointLightComponent>())
-		{
-			auto& pl = entity.GetComponent<PointLightComponent>();
-			MonoClassField* positionField = mono_class_get_field_from_name(monoClass, "Position");
-			MonoClassField* colorField = mono_class_get_field_from_name(monoClass, "Color");
-			MonoClassField* intensityField = mono_class_get_field_from_name(monoClass, "Intensity");
-			MonoClassField* radiusField = mono_class_get_field_from_name(monoClass, "Radius");
-			if (positionField) mono_field_set_value(outComponent, positionField, &pl.Position);
-			if (colorField) mono_field_set_value(outComponent, colorField, &pl.Color);
-			if (intensityField) mono_field_set_value(outComponent, intensityField, &pl.Intensity);
-			if (radiusField) mono_field_set_value(outComponent, radiusField, &pl.Radius);
-			return true;
-		}
-		
-		// Handle DirectionalLightComponent
-		if (strcmp(className, "DirectionalLightComponent") == 0 && entity.HasComponent<DirectionalLightComponent>())
-		{
-			auto& dl = entity.GetComponent<DirectionalLightComponent>();
-			MonoClassField* colorField = mono_class_get_field_from_name(monoClass, "Color");
-			MonoClassField* intensityField = mono_class_get_field_from_name(monoClass, "Intensity");
-			if (colorField) mono_field_set_value(outComponent, colorField, &dl.Color);
-			if (intensityField) mono_field_set_value(outComponent, intensityField, &dl.Intensity);
-			return true;
-		}
-
-		NB_CORE_WARN("Entity_GetComponent: Component type '{}' not handled for entity {}", className, entityID);
-		return false;
+		return funcs->Get(entity, outComponent, funcs->Fields);
 	}
 
-	static void Entity_AddComponent(uint32_t entityID, MonoReflectionType* componentType)
+	static void Entity_AddComponentByID(uint32_t entityID, int32_t componentID)
 	{
+		const ComponentFuncs* funcs = GetComponentFuncs(componentID);
+		if (!funcs)
+		{
+			NB_CORE_WARN("Entity_AddComponent: unknown component ID {}", componentID);
+			return;
+		}
+
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 		
 		Entity entity{ (entt::entity)entityID, scene };
 		NEB_CORE_ASSERT(entity, "Invalid entity!");
 
-		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		MonoClass* monoClass = mono_type_get_class(managedType);
-		const char* className = mono_class_get_name(monoClass);
+		if (!funcs->Has(entity))
+			funcs->Add(entity);
+	}
 
-		// Handle different component types
-		if (strcmp(className, "TransformComponent") == 0)
-		{
-			if (!entity.HasComponent<TransformComponent>())
-				entity.AddComponent<TransformComponent>();
-		}
-		else if (strcmp(className, "MeshRendererComponent") == 0)
-		{
-			if (!entity.HasComponent<MeshRendererComponent>())
-				entity.AddComponent<MeshRendererComponent>();
-		}
-		else if (strcmp(className, "CameraComponent") == 0)
-		{
-			if (!entity.HasComponent<CameraComponent>())
-				entity.AddComponent<CameraComponent>();
-		}
-		else if (strcmp(className, "BoxColliderComponent") == 0)
-		{
-			if (!entity.HasComponent<BoxColliderComponent>())
-				entity.AddComponent<BoxColliderComponent>();
-		}
-		else if (strcmp(className, "SphereColliderComponent") == 0)
-		{
-			if (!entity.HasComponent<SphereColliderComponent>())
-				entity.AddComponent<SphereColliderComponent>();
-		}
-		else if (strcmp(className, "RigidBodyComponent") == 0)
-		{
-			if (!entity.HasComponent<RigidBodyComponent>())
-				entity.AddComponent<RigidBodyComponent>();
-		}
-		else if (strcmp(className, "AudioSourceComponent") == 0)
-		{
-			if (!entity.HasComponent<AudioSourceComponent>())
-				entity.AddComponent<AudioSourceComponent>();
-		}
-		else if (strcmp(className, "LineRendererComponent") == 0)
-		{
-			if (!entity.HasComponent<LineRendererComponent>())
-				entity.AddComponent<LineRendererComponent>();
-		}
-		else if (strcmp(className, "PointLightComponent") == 0)
-		{
-			if (!entity.HasComponent<PointLightComponent>())
-				entity.AddComponent<PointLightComponent>();
-		}
-		else if (strcmp(className, "DirectionalLightComponent") == 0)
+	static void Entity_RemoveComponentByID(uint32_t entityID, int32_t componentID)
+	{
+		const ComponentFuncs* funcs = GetComponentFuncs(componentID);
+		if (!funcs)
 		{
-			if (!entity.HasComponent<DirectionalLightComponent>())
-				entity.AddComponent<DirectionalLightComponent>();
+			NB_CORE_WARN("Entity_RemoveComponent: unknown component ID {}", componentID);
+			return;
 		}
-		// Add more component types as needed
-	}
 
-	static void Entity_RemoveComponent(uint32_t entityID, MonoReflectionType* componentType)
-	{
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 		
 		Entity entity{ (entt::entity)entityID, scene };
 		NEB_CORE_ASSERT(entity, "Invalid entity!");
 
-		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		MonoClass* monoClass = mono_type_get_class(managedType);
-		const char* className = mono_class_get_name(monoClass);
+		if (funcs->Has(entity))
+			funcs->Remove(entity);
+	}
 
-		// Handle different component types
-		if (strcmp(className, "TransformComponent") == 0)
-		{
-			// Cannot remove TransformComponent - every entity needs one
-			NB_CORE_WARN("Cannot remove TransformComponent from entity!");
-		}
-		else if (strcmp(className, "MeshRendererComponent") == 0)
-		{
-			if (entity.HasComponent<MeshRendererComponent>())
-				entity.RemoveComponent<MeshRendererComponent>();
-		}
-		else if (strcmp(className, "CameraComponent") == 0)
-		{
-			if (entity.HasComponent<CameraComponent>())
-				entity.RemoveComponent<CameraComponent>();
-		}
-		else if (strcmp(className, "BoxColliderComponent") == 0)
-		{
-			if (entity.HasComponent<BoxColliderComponent>())
-				entity.RemoveComponent<BoxColliderComponent>();
-		}
-		else if (strcmp(className, "SphereColliderComponent") == 0)
-		{
-			if (entity.HasComponent<SphereColliderComponent>())
-				entity.RemoveComponent<SphereColliderComponent>();
-		}
-		else if (strcmp(className, "RigidBodyComponent") == 0)
-		{
-			if (entity.HasComponent<RigidBodyComponent>())
-				entity.RemoveComponent<RigidBodyComponent>();
-		}
-		else if (strcmp(className, "AudioSourceComponent") == 0)
-		{
-			if (entity.HasComponent<AudioSourceComponent>())
-				entity.RemoveComponent<AudioSourceComponent>();
-		}
-		else if (strcmp(className, "LineRendererComponent") == 0)
-		{
-			if (entity.HasComponent<LineRendererComponent>())
-				entity.RemoveComponent<LineRendererComponent>();
-		}
-		else if (strcmp(className, "PointLightComponent") == 0)
-		{
-			if (entity.HasComponent<PointLightComponent>())
-				entity.RemoveComponent<PointLightComponent>();
-		}
-		else if (strcmp(className, "DirectionalLightComponent") == 0)
-		{
-			if (entity.HasComponent<DirectionalLightComponent>())
-				entity.RemoveComponent<DirectionalLightComponent>();
-		}
-		// Add more component types as needed
+	static bool Entity_GetComponent(uint32_t entityID, MonoReflectionType* componentType, MonoObject* outComponent)
+	{
+		return Entity_GetComponentByID(entityID, GetComponentTypeID(componentType), outComponent);
+	}
+
+	static void Entity_AddComponent(uint32_t entityID, MonoReflectionType* componentType)
+	{
+		Entity_AddComponentByID(entityID, GetComponentTypeID(componentType));
+	}
+
+	static void Entity_RemoveComponent(uint32_t entityID, MonoReflectionType* componentType)
+	{
+		Entity_RemoveComponentByID(entityID, GetComponentTypeID(componentType));
 	}
 
 	static MonoString* Entity_GetName(uint32_t entityID)
@@ -604,80 +590,121 @@ namespace Nebula {
 			return;
 
 		char* cStr = mono_string_to_utf8(name);
-		entity.GetComponent<TagComponent>().Tag = cStr;
+		scene->SetEntityTag(entity, cStr);
 		mono_free(cStr);
 	}
 
+	static const ComponentFuncs* GetComponentQueryFuncs(MonoReflectionType* componentType)
+	{
+		const ComponentFuncs* funcs = GetComponentFuncs(GetComponentTypeID(componentType));
+		if (!funcs)
+			NB_CORE_WARN("Entity query: component type is not registered");
+		return funcs;
+	}
+
+	// Writes as many IDs as fit into a managed uint[] and returns the total match count.
+	// Lets scripts reuse one buffer instead of allocating an array every call.
+	static uint32_t FillManagedBuffer(MonoArray* buffer, const std::function<uint32_t(uint32_t*, uint32_t)>& fill)
+	{
+		uint32_t capacity = buffer ? (uint32_t)mono_array_length(buffer) : 0;
+		uint32_t* data = capacity > 0 ? mono_array_addr(buffer, uint32_t, 0) : nullptr;
+		return fill(data, capacity);
+	}
+
+	static MonoArray* CreateManagedIDArray(const uint32_t* ids, uint32_t count)
+	{
+		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint32_class(), count);
+		if (count > 0)
+			memcpy(mono_array_addr(result, uint32_t, 0), ids, count * sizeof(uint32_t));
+		return result;
+	}
+
 	static MonoArray* Entity_GetAllEntitiesWithComponent(MonoReflectionType* componentType)
 	{
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		MonoClass* monoClass = mono_type_get_class(managedType);
-		const char* className = mono_class_get_name(monoClass);
+		const ComponentFuncs* funcs = GetComponentQueryFuncs(componentType);
+		if (!funcs)
+			return CreateManagedIDArray(nullptr, 0);
 
-		std::vector<uint32_t> entityIDs;
+		std::vector<uint32_t> entityIDs(funcs->Collect(scene, nullptr, 0));
+		funcs->Collect(scene, entityIDs.data(), (uint32_t)entityIDs.size());
+		return CreateManagedIDArray(entityIDs.data(), (uint32_t)entityIDs.size());
+	}
 
-		// Find all entities with this component
-		if (strcmp(className, "TransformComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<TransformComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "MeshRendererComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<MeshRendererComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "CameraComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<CameraComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "ScriptComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<ScriptComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "BoxColliderComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<BoxColliderComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "SphereColliderComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<SphereColliderComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "RigidBodyComponent") == 0)
-		{
-			auto view = scene->GetRegistry().view<RigidBodyComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
-		}
-		else if (strcmp(className, "AudioSourceComponent") == 0)
+	static int32_t Entity_GetEntitiesWithComponentNonAlloc(MonoReflectionType* componentType, MonoArray* buffer)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		const ComponentFuncs* funcs = GetComponentQueryFuncs(componentType);
+		if (!funcs)
+			return 0;
+
+		return (int32_t)FillManagedBuffer(buffer, [&](uint32_t* out, uint32_t capacity) { return funcs->Collect(scene, out, capacity); });
+	}
+
+	// Cached queries
+	static uint32_t Entity_CreateQuery(MonoArray* componentTypes)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		if (!componentTypes || mono_array_length(componentTypes) == 0)
 		{
-			auto view = scene->GetRegistry().view<AudioSourceComponent>();
-			for (auto entity : view)
-				entityIDs.push_back((uint32_t)entity);
+			NB_CORE_ERROR("EntityQuery needs at least one component type");
+			return 0;
 		}
-		// Add more component types as needed
 
-		// Create managed array
-		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint32_class(), entityIDs.size());
-		for (size_t i = 0; i < entityIDs.size(); i++)
+		auto query = std::make_unique<EntityQuery>(scene->GetRegistry());
+		for (uintptr_t i = 0; i < mono_array_length(componentTypes); i++)
 		{
-			mono_array_set(result, uint32_t, i, entityIDs[i]);
+			const ComponentFuncs* funcs = GetComponentQueryFuncs(mono_array_get(componentTypes, MonoReflectionType*, i));
+			if (!funcs)
+				return 0;
+			funcs->Require(*query);
 		}
+		query->Build();
 
-		return result;
+		return scene->AddEntityQuery(std::move(query));
+	}
+
+	static void Entity_DestroyQuery(uint32_t queryID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		if (scene)
+			scene->RemoveEntityQuery(queryID);
+	}
+
+	static uint32_t Entity_QueryGetVersion(uint32_t queryID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		EntityQuery* query = scene->GetEntityQuery(queryID);
+		return query ? query->GetVersion() : 0;
+	}
+
+	static int32_t Entity_QueryGetEntities(uint32_t queryID, MonoArray* buffer)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		EntityQuery* query = scene->GetEntityQuery(queryID);
+		if (!query)
+			return 0;
+
+		return (int32_t)FillManagedBuffer(buffer, [&](uint32_t* out, uint32_t capacity) { return query->CopyTo(out, capacity); });
+	}
+
+	// Names and tags share TagComponent, so both resolve through the scene's TagIndex
+	static const std::vector<uint32_t>& GetEntitiesWithTag(Scene* scene, MonoString* tag)
+	{
+		char* cStr = mono_string_to_utf8(tag);
+		const std::vector<uint32_t>& entities = scene->GetTagIndex().GetEntities(std::string(cStr));
+		mono_free(cStr);
+		return entities;
 	}
 
 	static uint32_t Entity_FindByName(MonoString* name)
@@ -685,20 +712,46 @@ namespace Nebula {
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 
+		const std::vector<uint32_t>& entities = GetEntitiesWithTag(scene, name);
+		return entities.empty() ? 0 : entities.front(); // 0 = not found
+	}
+
+	// Lets C# resolve a name once and then look it up by ID without marshalling the string.
+	// Doesn't intern, so asking about names no entity has doesn't grow the index.
+	static uint32_t Entity_FindNameID(MonoString* name)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
 		char* cStr = mono_string_to_utf8(name);
-		std::string targetName(cStr);
+		uint32_t nameID = scene->GetTagIndex().FindID(cStr);
 		mono_free(cStr);
+		return nameID; // 0 = no entity has the name yet
+	}
 
-		// Search all entities with TagComponent
-		auto view = scene->GetRegistry().view<TagComponent>();
-		for (auto entity : view)
-		{
-			const auto& tag = view.get<TagComponent>(entity);
-			if (tag.Tag == targetName)
-				return (uint32_t)entity;
-		}
+	static uint32_t Entity_FindByNameID(uint32_t nameID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		const std::vector<uint32_t>& entities = scene->GetTagIndex().GetEntities(nameID);
+		return entities.empty() ? 0 : entities.front();
+	}
+
+	static uint32_t Entity_GetNameVersion(uint32_t nameID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		return scene->GetTagIndex().GetVersion(nameID);
+	}
+
+	static uint32_t Entity_GetNameSetVersion()
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		return 0; // Not found
+		return scene->GetTagIndex().GetTagSetVersion();
 	}
 
 	static uint32_t Entity_Instantiate(uint32_t prefabID)
@@ -713,46 +766,42 @@ namespace Nebula {
 			return 0;
 		}
 
-		// Create new entity
-		std::string name = "Clone";
-		if (prefab.HasComponent<TagComponent>())
-			name = prefab.GetComponent<TagComponent>().Tag + " (Clone)";
-
-		Entity newEntity = scene->CreateEntity(name);
-
-		// Copy TransformComponent
-		if (prefab.HasComponent<TransformComponent>())
-		{
-			newEntity.GetComponent<TransformComponent>() = prefab.GetComponent<TransformComponent>();
-		}
+		return (uint32_t)scene->InstantiateEntity(prefab);
+	}
 
-		// Copy MeshRendererComponent
-		if (prefab.HasComponent<MeshRendererComponent>())
-		{
-			if (!newEntity.HasComponent<MeshRendererComponent>())
-				newEntity.AddComponent<MeshRendererComponent>();
-			newEntity.GetComponent<MeshRendererComponent>() = prefab.GetComponent<MeshRendererComponent>();
-		}
+	// positions/rotations are Vector3[] and may be null, otherwise they need count entries
+	static MonoArray* Entity_InstantiateBatch(uint32_t prefabID, int32_t count, MonoArray* positions, MonoArray* rotations)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		// Copy CameraComponent
-		if (prefab.HasComponent<CameraComponent>())
+		Entity prefab{ (entt::entity)prefabID, scene };
+		if (!prefab || count <= 0)
 		{
-			if (!newEntity.HasComponent<CameraComponent>())
-				newEntity.AddComponent<CameraComponent>();
-			newEntity.GetComponent<CameraComponent>() = prefab.GetComponent<CameraComponent>();
+			if (!prefab)
+				NB_CORE_ERROR("Invalid prefab entity!");
+			return CreateManagedIDArray(nullptr, 0);
 		}
 
-		// Copy ScriptComponent
-		if (prefab.HasComponent<ScriptComponent>())
+		auto getOverrides = [count](MonoArray* array, const char* name) -> const glm::vec3*
 		{
-			if (!newEntity.HasComponent<ScriptComponent>())
-				newEntity.AddComponent<ScriptComponent>();
-			newEntity.GetComponent<ScriptComponent>() = prefab.GetComponent<ScriptComponent>();
-		}
+			if (!array)
+				return nullptr;
+			if ((int32_t)mono_array_length(array) < count)
+			{
+				NB_CORE_WARN("Instantiate: {} has fewer than {} entries, ignoring it", name, count);
+				return nullptr;
+			}
+			return mono_array_addr(array, glm::vec3, 0);
+		};
 
-		// Add more component types as needed
+		std::vector<entt::entity> clones;
+		scene->InstantiateEntities(prefab, (uint32_t)count, clones, getOverrides(positions, "positions"), getOverrides(rotations, "rotations"));
 
-		return (uint32_t)newEntity;
+		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint32_class(), clones.size());
+		for (size_t i = 0; i < clones.size(); i++)
+			mono_array_set(result, uint32_t, i, (uint32_t)clones[i]);
+		return result;
 	}
 
 	static void Entity_Destroy(uint32_t entityID)
@@ -769,7 +818,93 @@ namespace Nebula {
 
 	static void Entity_DestroyDelayed(uint32_t entityID, float delay)
 	{
-		s_DestroyDelayedEntities[entityID] = delay;
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		scene->GetTimerWheel().Schedule(delay, [scene, entityID]()
+		{
+			// The entity may already be gone, entt handles carry a version so a reused ID won't match
+			entt::entity handle = (entt::entity)entityID;
+			if (scene->GetRegistry().valid(handle))
+				scene->DestroyEntity({ handle, scene });
+		});
+	}
+
+	// Script timers (Invoke / InvokeRepeating / coroutine waits)
+	static MonoMethod* FindMethodInHierarchy(MonoClass* monoClass, const char* name, int parameterCount)
+	{
+		for (MonoClass* klass = monoClass; klass; klass = mono_class_get_parent(klass))
+		{
+			if (MonoMethod* method = mono_class_get_method_from_name(klass, name, parameterCount))
+				return method;
+		}
+		return nullptr;
+	}
+
+	static TimerHandle ScheduleScriptTimer(uint32_t entityID, MonoMethod* method, float delay, float interval)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+
+		// Repeating timers cancel themselves once the script instance is gone
+		auto self = std::make_shared<TimerHandle>(0);
+		TimerHandle handle = scene->GetTimerWheel().Schedule(delay, [scene, entityID, method, self]()
+		{
+			Ref<ScriptInstance> instance = ScriptEngine::GetEntityScriptInstance(entityID);
+			if (!instance)
+			{
+				scene->GetTimerWheel().Cancel(*self);
+				return;
+			}
+
+			instance->GetScriptClass()->InvokeMethod(instance->GetManagedObject(), method, nullptr);
+		}, interval);
+
+		*self = handle;
+		return handle;
+	}
+
+	static uint64_t Script_Invoke(uint32_t entityID, MonoString* methodName, float delay, float repeatRate)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
+
+		Ref<ScriptInstance> instance = ScriptEngine::GetEntityScriptInstance(entityID);
+		if (!instance)
+			return 0;
+
+		char* cStr = mono_string_to_utf8(methodName);
+		MonoMethod* method = FindMethodInHierarchy(mono_object_get_class(instance->GetManagedObject()), cStr, 0);
+		if (!method)
+			NB_CORE_WARN("Invoke: method '{0}' with no parameters not found on script", cStr);
+		mono_free(cStr);
+
+		if (!method)
+			return 0;
+
+		return ScheduleScriptTimer(entityID, method, delay, repeatRate);
+	}
+
+	// Coroutines
+	static uint64_t Script_WaitCoroutine(uint32_t entityID, int32_t coroutineID, int32_t waitType, float seconds, uint64_t value)
+	{
+		return ScriptScheduler::Wait(entityID, coroutineID, (ScriptWaitType)waitType, seconds, value);
+	}
+
+	static void Script_SetUpdateEnabled(uint32_t entityID, bool enabled)
+	{
+		ScriptEngine::SetUpdateEnabled(entityID, enabled);
+	}
+
+	static bool Script_CancelTimer(uint64_t handle)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		return scene ? scene->GetTimerWheel().Cancel(handle) : false;
+	}
+
+	static bool Script_IsTimerPending(uint64_t handle)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		return scene ? scene->GetTimerWheel().IsPending(handle) : false;
 	}
 
 	static MonoObject* Entity_GetScriptInstance(uint32_t entityID, MonoReflectionType* scriptType)
@@ -837,7 +972,7 @@ namespace Nebula {
 			return;
 
 		char* cStr = mono_string_to_utf8(tag);
-		entity.GetComponent<TagComponent>().Tag = cStr;
+		scene->SetEntityTag(entity, cStr);
 		mono_free(cStr);
 	}
 
@@ -846,19 +981,8 @@ namespace Nebula {
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		char* cStr = mono_string_to_utf8(tag);
-		std::string targetTag(cStr);
-		mono_free(cStr);
-
-		auto view = scene->GetRegistry().view<TagComponent>();
-		for (auto entity : view)
-		{
-			const auto& tagComp = view.get<TagComponent>(entity);
-			if (tagComp.Tag == targetTag)
-				return (uint32_t)entity;
-		}
-
-		return 0;
+		const std::vector<uint32_t>& entities = GetEntitiesWithTag(scene, tag);
+		return entities.empty() ? 0 : entities.front();
 	}
 
 	static MonoArray* Entity_FindAllByTag(MonoString* tag)
@@ -866,26 +990,21 @@ namespace Nebula {
 		Scene* scene = ScriptEngine::GetSceneContext();
 		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		char* cStr = mono_string_to_utf8(tag);
-		std::string targetTag(cStr);
-		mono_free(cStr);
+		const std::vector<uint32_t>& entities = GetEntitiesWithTag(scene, tag);
+		return CreateManagedIDArray(entities.data(), (uint32_t)entities.size());
+	}
 
-		std::vector<uint32_t> entityIDs;
-		auto view = scene->GetRegistry().view<TagComponent>();
-		for (auto entity : view)
-		{
-			const auto& tagComp = view.get<TagComponent>(entity);
-			if (tagComp.Tag == targetTag)
-				entityIDs.push_back((uint32_t)entity);
-		}
+	static int32_t Entity_FindAllByTagNonAlloc(MonoString* tag, MonoArray* buffer)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		NEB_CORE_ASSERT(scene, "No active scene!");
 
-		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint32_class(), entityIDs.size());
-		for (size_t i = 0; i < entityIDs.size(); i++)
+		const std::vector<uint32_t>& entities = GetEntitiesWithTag(scene, tag);
+		return (int32_t)FillManagedBuffer(buffer, [&](uint32_t* out, uint32_t capacity)
 		{
-			mono_array_set(result, uint32_t, i, entityIDs[i]);
-		}
-
-		return result;
+			std::copy_n(entities.begin(), std::min((uint32_t)entities.size(), capacity), out);
+			return (uint32_t)entities.size();
+		});
 	}
 
 	static bool Entity_GetActiveSelf(uint32_t entityID)
@@ -1214,6 +1333,43 @@ namespace Nebula {
 	{
 		([]()
 		{
+			constexpr int32_t componentID = GetComponentID<Component>(ScriptComponents{});
+			static_assert(componentID >= 0, "Component is not part of ScriptComponents");
+			static_assert(ComponentMarshaller<Component>::Fields.size() <= s_MaxComponentFields, "Too many marshalled fields");
+
+			ComponentFuncs& funcs = s_ComponentFuncs[componentID];
+			funcs.Has = [](Entity entity) { return entity.HasComponent<Component>(); };
+			funcs.Add = [](Entity entity) { entity.AddComponent<Component>(); };
+			funcs.Remove = [](Entity entity)
+			{
+				// Every entity needs a transform
+				if constexpr (std::is_same_v<Component, TransformComponent>)
+					NB_CORE_WARN("Cannot remove TransformComponent from entity!");
+				else
+					entity.RemoveComponent<Component>();
+			};
+			funcs.Get = [](Entity entity, MonoObject* outComponent, MonoClassField* const* fields)
+			{
+				if (!entity.HasComponent<Component>())
+					return false;
+				ComponentMarshaller<Component>::Write(entity.GetComponent<Component>(), outComponent, fields);
+				return true;
+			};
+			funcs.Collect = [](Scene* scene, uint32_t* out, uint32_t capacity) -> uint32_t
+			{
+				auto view = scene->GetRegistry().view<Component>();
+				uint32_t count = 0;
+				for (auto entity : view)
+				{
+					if (count < capacity)
+						out[count] = (uint32_t)entity;
+					count++;
+				}
+				return count;
+			};
+			funcs.Require = [](EntityQuery& query) { query.Require<Component>(); };
+			std::fill(std::begin(funcs.Fields), std::end(funcs.Fields), nullptr);
+
 			std::string_view typeName = typeid(Component).name();
 			size_t pos = typeName.find_last_of(':');
 			std::string_view structName = typeName.substr(pos + 1);
@@ -1225,7 +1381,12 @@ namespace Nebula {
 				NB_CORE_ERROR("Could not find component type {}", managedTypename);
 				return;
 			}
-			s_EntityHasComponentFuncs[managedType] = [](Entity entity) { return entity.HasComponent<Component>(); };
+			s_ComponentTypeIDs[managedType] = componentID;
+
+			MonoClass* monoClass = mono_type_get_class(managedType);
+			const auto& fieldNames = ComponentMarshaller<Component>::Fields;
+			for (size_t i = 0; i < fieldNames.size(); i++)
+				funcs.Fields[i] = mono_class_get_field_from_name(monoClass, fieldNames[i]);
 		}(), ...);
 	}
 
@@ -1283,7 +1444,6 @@ namespace Nebula {
 		NB_CORE_INFO("  Registered Nebula.Time functions");
 
 		// Register Entity/Transform functions (Nebula.InternalCalls class)
-		mono_add_internal_call("Nebula.InternalCalls::Entity_HasComponent", (void*)Entity_HasComponent);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetPosition", (void*)TransformComponent_GetPosition);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_SetPosition", (void*)TransformComponent_SetPosition);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetRotation", (void*)TransformComponent_GetRotation);
@@ -1293,19 +1453,40 @@ namespace Nebula {
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetComponent", (void*)Entity_GetComponent);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_AddComponent", (void*)Entity_AddComponent);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_RemoveComponent", (void*)Entity_RemoveComponent);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_GetComponentTypeID", (void*)Entity_GetComponentTypeID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_HasComponentByID", (void*)Entity_HasComponentByID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_GetComponentByID", (void*)Entity_GetComponentByID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_AddComponentByID", (void*)Entity_AddComponentByID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_RemoveComponentByID", (void*)Entity_RemoveComponentByID);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetName", (void*)Entity_GetName);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_SetName", (void*)Entity_SetName);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetAllEntitiesWithComponent", (void*)Entity_GetAllEntitiesWithComponent);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_GetEntitiesWithComponentNonAlloc", (void*)Entity_GetEntitiesWithComponentNonAlloc);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_CreateQuery", (void*)Entity_CreateQuery);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_DestroyQuery", (void*)Entity_DestroyQuery);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_QueryGetVersion", (void*)Entity_QueryGetVersion);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_QueryGetEntities", (void*)Entity_QueryGetEntities);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_FindByName", (void*)Entity_FindByName);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_FindNameID", (void*)Entity_FindNameID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_FindByNameID", (void*)Entity_FindByNameID);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_GetNameVersion", (void*)Entity_GetNameVersion);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_GetNameSetVersion", (void*)Entity_GetNameSetVersion);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_Instantiate", (void*)Entity_Instantiate);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_InstantiateBatch", (void*)Entity_InstantiateBatch);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_Destroy", (void*)Entity_Destroy);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_DestroyDelayed", (void*)Entity_DestroyDelayed);
+		mono_add_internal_call("Nebula.InternalCalls::Script_Invoke", (void*)Script_Invoke);
+		mono_add_internal_call("Nebula.InternalCalls::Script_WaitCoroutine", (void*)Script_WaitCoroutine);
+		mono_add_internal_call("Nebula.InternalCalls::Script_SetUpdateEnabled", (void*)Script_SetUpdateEnabled);
+		mono_add_internal_call("Nebula.InternalCalls::Script_CancelTimer", (void*)Script_CancelTimer);
+		mono_add_internal_call("Nebula.InternalCalls::Script_IsTimerPending", (void*)Script_IsTimerPending);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetScriptInstance", (void*)Entity_GetScriptInstance);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetScriptByName", (void*)Entity_GetScriptByName);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetTag", (void*)Entity_GetTag);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_SetTag", (void*)Entity_SetTag);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_FindByTag", (void*)Entity_FindByTag);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_FindAllByTag", (void*)Entity_FindAllByTag);
+		mono_add_internal_call("Nebula.InternalCalls::Entity_FindAllByTagNonAlloc", (void*)Entity_FindAllByTagNonAlloc);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetActiveSelf", (void*)Entity_GetActiveSelf);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_GetActiveInHierarchy", (void*)Entity_GetActiveInHierarchy);
 		mono_add_internal_call("Nebula.InternalCalls::Entity_SetActive", (void*)Entity_SetActive);
@@ -1351,34 +1532,9 @@ namespace Nebula {
 
 	void ScriptGlue::RegisterComponents()
 	{
-		RegisterComponent<TransformComponent, MeshRendererComponent, CameraComponent, TagComponent, ScriptComponent, 
-			BoxColliderComponent, SphereColliderComponent, RigidBodyComponent, AudioSourceComponent>();
-	}
-
-	void ScriptGlue::Update(float deltaTime)
-	{
-		// Update delayed destroy entities
-		Scene* scene = ScriptEngine::GetSceneContext();
-		if (!scene)
-			return;
-
-		std::vector<uint32_t> toDestroy;
-		for (auto& [entityID, timeRemaining] : s_DestroyDelayedEntities)
-		{
-			timeRemaining -= deltaTime;
-			if (timeRemaining <= 0.0f)
-			{
-				toDestroy.push_back(entityID);
-			}
-		}
-
-		for (uint32_t entityID : toDestroy)
-		{
-			Entity entity{ (entt::entity)entityID, scene };
-			if (entity)
-				scene->DestroyEntity(entity);
-			s_DestroyDelayedEntities.erase(entityID);
-		}
+		// MonoType pointers change on every assembly load
+		s_ComponentTypeIDs.clear();
+		RegisterComponent(ScriptComponents{});
 	}
 
 	void ScriptGlue::UpdateMouseState()
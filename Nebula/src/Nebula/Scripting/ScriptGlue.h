@@ -7,7 +7,6 @@ namespace Nebula {
 	public:
 		static void RegisterFunctions();
 		static void RegisterComponents();
-		static void Update(float deltaTime);
 		static void UpdateMouseState();
 	};
 
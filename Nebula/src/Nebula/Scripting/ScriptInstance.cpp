@@ -1,6 +1,7 @@
 #include "nbpch.h"
 #include "ScriptInstance.h"
 #include "ScriptEngine.h"
+#include "ScriptProfiler.h"
 
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
@@ -12,7 +13,7 @@ namespace Nebula {
 	char g_ScriptFieldValueBuffer[16];
 
 	ScriptInstance::ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity)
-		: m_ScriptClass(scriptClass)
+		: m_ScriptClass(scriptClass), m_EntityID((uint32_t)entity), m_ClassName(scriptClass->GetFullName())
 	{
 		m_Instance = scriptClass->Instantiate();
 
@@ -25,6 +26,7 @@ namespace Nebula {
 		m_OnCollisionExitMethod = scriptClass->GetMethod("OnCollisionExit", 1);
 		
 		MonoClass* scriptBehaviorClass = mono_class_from_name(s_Data->CoreAssemblyImage, "Nebula", "ScriptBehavior");
+		m_ResumeCoroutineMethod = mono_class_get_method_from_name(scriptBehaviorClass, "ResumeCoroutine", 1);
 		MonoProperty* entityProperty = mono_class_get_property_from_name(scriptBehaviorClass, "Entity");
 		
 		uint32_t entityID = (uint32_t)entity;
@@ -55,13 +57,17 @@ namespace Nebula {
 	void ScriptInstance::InvokeOnCreate()
 	{
 		if (m_OnCreateMethod)
+		{
+			ScriptProfiler::Scope profile(m_EntityID, m_ClassName, ScriptCallback::OnCreate);
 			m_ScriptClass->InvokeMethod(m_Instance, m_OnCreateMethod, nullptr);
+		}
 	}
 
 	void ScriptInstance::InvokeOnUpdate(float deltaTime)
 	{
 		if (m_OnUpdateMethod)
 		{
+			ScriptProfiler::Scope profile(m_EntityID, m_ClassName, ScriptCallback::OnUpdate);
 			void* param = &deltaTime;
 			m_ScriptClass->InvokeMethod(m_Instance, m_OnUpdateMethod, &param);
 		}
@@ -70,7 +76,10 @@ namespace Nebula {
 	void ScriptInstance::InvokeOnDestroy()
 	{
 		if (m_OnDestroyMethod)
+		{
+			ScriptProfiler::Scope profile(m_EntityID, m_ClassName, ScriptCallback::OnDestroy);
 			m_ScriptClass->InvokeMethod(m_Instance, m_OnDestroyMethod, nullptr);
+		}
 	}
 
 	void ScriptInstance::InvokeOnCollisionEnter(MonoObject* collision)
@@ -100,28 +109,49 @@ namespace Nebula {
 		}
 	}
 
-	bool ScriptInstance::GetFieldValueInternal(const std::string& name, void* buffer)
+	void ScriptInstance::InvokeResumeCoroutine(int32_t coroutineID)
+	{
+		if (m_ResumeCoroutineMethod)
+		{
+			void* param = &coroutineID;
+			m_ScriptClass->InvokeMethod(m_Instance, m_ResumeCoroutineMethod, &param);
+		}
+	}
+
+	bool ScriptInstance::GetFieldValueInternal(int32_t fieldIndex, void* buffer)
 	{
 		const auto& fields = m_ScriptClass->GetFields();
-		auto it = fields.find(name);
-		if (it == fields.end())
+		if ((uint32_t)fieldIndex >= (uint32_t)fields.size())
 			return false;
 
-		const ScriptField& field = it->second;
-		mono_field_get_value(m_Instance, field.ClassField, buffer);
+		mono_field_get_value(m_Instance, fields[fieldIndex].ClassField, buffer);
 		return true;
 	}
 
-	bool ScriptInstance::SetFieldValueInternal(const std::string& name, const void* value)
+	bool ScriptInstance::SetFieldValueInternal(int32_t fieldIndex, const void* value)
 	{
 		const auto& fields = m_ScriptClass->GetFields();
-		auto it = fields.find(name);
-		if (it == fields.end())
+		if ((uint32_t)fieldIndex >= (uint32_t)fields.size())
 			return false;
 
-		const ScriptField& field = it->second;
-		mono_field_set_value(m_Instance, field.ClassField, (void*)value);
+		mono_field_set_value(m_Instance, fields[fieldIndex].ClassField, (void*)value);
 		return true;
 	}
 
+	void ScriptInstance::ApplyFieldValues(const ScriptFieldStorage& values)
+	{
+		const std::vector<int32_t>& fieldIndices = values.ResolveFields(*m_ScriptClass);
+		const auto& fields = m_ScriptClass->GetFields();
+
+		for (size_t i = 0; i < fieldIndices.size(); i++)
+		{
+			if (fieldIndices[i] < 0)
+				continue;
+
+			// Only float/int/bool fields are stored, so a plain copy into the object is safe (no GC references)
+			const ScriptFieldStorage::Record& record = values.GetRecord(i);
+			memcpy((char*)m_Instance + fields[fieldIndices[i]].Offset, record.Value, ScriptFieldStorage::GetValueSize(record.ValueType));
+		}
+	}
+
 }
@@ -2,6 +2,7 @@
 
 #include "Nebula/Core.h"
 #include "ScriptClass.h"
+#include "ScriptFieldStorage.h"
 #include "Nebula/Scene/Entity.h"
 
 namespace Nebula {
@@ -17,16 +18,28 @@ namespace Nebula {
 		void InvokeOnCollisionEnter(MonoObject* collision);
 		void InvokeOnCollisionStay(MonoObject* collision);
 		void InvokeOnCollisionExit(MonoObject* collision);
+		void InvokeResumeCoroutine(int32_t coroutineID);
+
+		// Scripts without an OnUpdate override are left out of the per-frame update
+		bool HasOnUpdate() const { return m_OnUpdateMethod != nullptr; }
+		uint32_t GetEntityID() const { return m_EntityID; }
 		
 		Ref<ScriptClass> GetScriptClass() { return m_ScriptClass; }
 		MonoObject* GetManagedObject() { return m_Instance; }
 
 		template<typename T>
 		T GetFieldValue(const std::string& name)
+		{
+			return GetFieldValue<T>(m_ScriptClass->GetFieldIndex(name));
+		}
+
+		// Index into GetScriptClass()->GetFields(), skips the name lookup
+		template<typename T>
+		T GetFieldValue(int32_t fieldIndex)
 		{
 			static_assert(sizeof(T) <= 16, "Type too large!");
 
-			bool success = GetFieldValueInternal(name, g_ScriptFieldValueBuffer);
+			bool success = GetFieldValueInternal(fieldIndex, g_ScriptFieldValueBuffer);
 			if (!success)
 				return T();
 
@@ -35,16 +48,27 @@ namespace Nebula {
 
 		template<typename T>
 		void SetFieldValue(const std::string& name, T value)
+		{
+			SetFieldValue(m_ScriptClass->GetFieldIndex(name), value);
+		}
+
+		template<typename T>
+		void SetFieldValue(int32_t fieldIndex, T value)
 		{
 			static_assert(sizeof(T) <= 16, "Type too large!");
-			SetFieldValueInternal(name, &value);
+			SetFieldValueInternal(fieldIndex, &value);
 		}
 
-		bool GetFieldValueInternal(const std::string& name, void* buffer);
-		bool SetFieldValueInternal(const std::string& name, const void* value);
+		bool GetFieldValueInternal(int32_t fieldIndex, void* buffer);
+		bool SetFieldValueInternal(int32_t fieldIndex, const void* value);
+
+		// Writes the component's stored field values into the instance in one pass
+		void ApplyFieldValues(const ScriptFieldStorage& values);
 
 	private:
 		Ref<ScriptClass> m_ScriptClass;
+		uint32_t m_EntityID = 0;
+		std::string m_ClassName; // Cached for the profiler
 
 		MonoObject* m_Instance = nullptr;
 		MonoMethod* m_Constructor = nullptr;
@@ -54,6 +78,7 @@ namespace Nebula {
 		MonoMethod* m_OnCollisionEnterMethod = nullptr;
 		MonoMethod* m_OnCollisionStayMethod = nullptr;
 		MonoMethod* m_OnCollisionExitMethod = nullptr;
+		MonoMethod* m_ResumeCoroutineMethod = nullptr;
 
 		friend struct ScriptFieldInstance;
 	};
@@ -0,0 +1,274 @@
+#include "nbpch.h"
+#include "ScriptProfiler.h"
+#include "Nebula/Log.h"
+
+#include <mono/metadata/mono-gc.h>
+#include <fstream>
+#include <map>
+
+namespace Nebula {
+
+	static constexpr int s_CallbackCount = (int)ScriptCallback::Count;
+
+	struct FrameCounters
+	{
+		float TimeMs[s_CallbackCount] = {};
+		uint32_t Calls[s_CallbackCount] = {};
+		int64_t AllocatedBytes[s_CallbackCount] = {};
+	};
+
+	struct WindowSums
+	{
+		double TimeMs[s_CallbackCount] = {};
+		uint64_t Calls[s_CallbackCount] = {};
+		int64_t AllocatedBytes[s_CallbackCount] = {};
+	};
+
+	struct EntityRecord
+	{
+		std::string ClassName;
+		FrameCounters Current;
+		std::vector<FrameCounters> History; // Ring buffer indexed by s_FrameIndex % window
+		WindowSums Sums;
+		uint32_t IdleFrames = 0;
+	};
+
+	static std::unordered_map<uint32_t, EntityRecord> s_Records;
+	static uint32_t s_WindowSize = 120;
+	static uint64_t s_FrameIndex = 0;
+	static uint32_t s_FramesRecorded = 0;
+
+	bool ScriptProfiler::s_Enabled = false;
+
+	static const char* CallbackToString(ScriptCallback callback)
+	{
+		switch (callback)
+		{
+		case ScriptCallback::OnCreate:  return "OnCreate";
+		case ScriptCallback::OnUpdate:  return "OnUpdate";
+		case ScriptCallback::OnDestroy: return "OnDestroy";
+		default:                        return "Unknown";
+		}
+	}
+
+	static int GetGCCount()
+	{
+		int count = 0;
+		for (int gen = 0; gen <= mono_gc_max_generation(); gen++)
+			count += mono_gc_collection_count(gen);
+		return count;
+	}
+
+	double ScriptProfileEntry::GetTotalTimeMs() const
+	{
+		double total = 0.0;
+		for (const auto& callback : Callbacks)
+			total += callback.TotalTimeMs;
+		return total;
+	}
+
+	void ScriptProfiler::SetEnabled(bool enabled)
+	{
+		s_Enabled = enabled;
+	}
+
+	void ScriptProfiler::SetWindowSize(uint32_t frames)
+	{
+		s_WindowSize = frames > 0 ? frames : 1;
+		Reset();
+	}
+
+	uint32_t ScriptProfiler::GetWindowSize()
+	{
+		return s_WindowSize;
+	}
+
+	uint32_t ScriptProfiler::GetFramesRecorded()
+	{
+		return s_FramesRecorded;
+	}
+
+	void ScriptProfiler::Reset()
+	{
+		s_Records.clear();
+		s_FrameIndex = 0;
+		s_FramesRecorded = 0;
+	}
+
+	void ScriptProfiler::EndFrame()
+	{
+		if (!s_Enabled)
+			return;
+
+		uint32_t slot = (uint32_t)(s_FrameIndex % s_WindowSize);
+
+		for (auto it = s_Records.begin(); it != s_Records.end();)
+		{
+			EntityRecord& record = it->second;
+			if (record.History.size() != s_WindowSize)
+				record.History.resize(s_WindowSize);
+
+			FrameCounters& expired = record.History[slot];
+			bool hadCalls = false;
+			for (int i = 0; i < s_CallbackCount; i++)
+			{
+				record.Sums.TimeMs[i] += record.Current.TimeMs[i] - expired.TimeMs[i];
+				record.Sums.Calls[i] += (uint64_t)record.Current.Calls[i] - expired.Calls[i];
+				record.Sums.AllocatedBytes[i] += record.Current.AllocatedBytes[i] - expired.AllocatedBytes[i];
+				hadCalls |= record.Current.Calls[i] > 0;
+			}
+
+			expired = record.Current;
+			record.Current = FrameCounters();
+			record.IdleFrames = hadCalls ? 0 : record.IdleFrames + 1;
+
+			// Nothing left in the window, e.g. the entity was destroyed
+			if (record.IdleFrames >= s_WindowSize)
+				it = s_Records.erase(it);
+			else
+				++it;
+		}
+
+		s_FrameIndex++;
+		if (s_FramesRecorded < s_WindowSize)
+			s_FramesRecorded++;
+	}
+
+	static ScriptProfileEntry BuildEntry(uint32_t entityID, const EntityRecord& record)
+	{
+		ScriptProfileEntry entry;
+		entry.ClassName = record.ClassName;
+		entry.EntityID = entityID;
+
+		for (int i = 0; i < s_CallbackCount; i++)
+		{
+			// Include the frame in progress so OnDestroy calls after the last EndFrame still show up
+			ScriptCallbackStats& stats = entry.Callbacks[i];
+			stats.TotalTimeMs = record.Sums.TimeMs[i] + record.Current.TimeMs[i];
+			stats.Calls = record.Sums.Calls[i] + record.Current.Calls[i];
+			stats.AllocatedBytes = record.Sums.AllocatedBytes[i] + record.Current.AllocatedBytes[i];
+			stats.MaxTimeMs = record.Current.TimeMs[i];
+
+			for (const auto& frame : record.History)
+				stats.MaxTimeMs = std::max(stats.MaxTimeMs, (double)frame.TimeMs[i]);
+		}
+
+		return entry;
+	}
+
+	std::vector<ScriptProfileEntry> ScriptProfiler::GetEntityStats()
+	{
+		std::vector<ScriptProfileEntry> entries;
+		entries.reserve(s_Records.size());
+
+		for (const auto& [entityID, record] : s_Records)
+			entries.push_back(BuildEntry(entityID, record));
+
+		return entries;
+	}
+
+	std::vector<ScriptProfileEntry> ScriptProfiler::GetClassStats()
+	{
+		std::unordered_map<std::string, ScriptProfileEntry> classes;
+
+		for (const auto& [entityID, record] : s_Records)
+		{
+			ScriptProfileEntry entityEntry = BuildEntry(entityID, record);
+			ScriptProfileEntry& classEntry = classes[record.ClassName];
+			classEntry.ClassName = record.ClassName;
+			classEntry.InstanceCount++;
+
+			for (int i = 0; i < s_CallbackCount; i++)
+			{
+				classEntry.Callbacks[i].TotalTimeMs += entityEntry.Callbacks[i].TotalTimeMs;
+				classEntry.Callbacks[i].Calls += entityEntry.Callbacks[i].Calls;
+				classEntry.Callbacks[i].AllocatedBytes += entityEntry.Callbacks[i].AllocatedBytes;
+				// Per-frame maxima of different entities can't be summed without the history, so this is the worst instance
+				classEntry.Callbacks[i].MaxTimeMs = std::max(classEntry.Callbacks[i].MaxTimeMs, entityEntry.Callbacks[i].MaxTimeMs);
+			}
+		}
+
+		std::vector<ScriptProfileEntry> entries;
+		entries.reserve(classes.size());
+		for (auto& [name, entry] : classes)
+			entries.push_back(std::move(entry));
+
+		return entries;
+	}
+
+	bool ScriptProfiler::ExportCSV(const std::filesystem::path& filepath)
+	{
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			NB_CORE_ERROR("Failed to write script profile to: {0}", filepath.string());
+			return false;
+		}
+
+		double frames = s_FramesRecorded > 0 ? (double)s_FramesRecorded : 1.0;
+
+		file << "Scope,Class,EntityID,Instances,Callback,Calls,TotalMs,AvgMsPerFrame,AvgMsPerCall,MaxMsPerFrame,AllocBytes,AllocBytesPerFrame\n";
+
+		auto writeRows = [&](const char* scope, const std::vector<ScriptProfileEntry>& entries, bool perEntity)
+		{
+			for (const auto& entry : entries)
+			{
+				for (int i = 0; i < s_CallbackCount; i++)
+				{
+					const ScriptCallbackStats& stats = entry.Callbacks[i];
+					if (stats.Calls == 0)
+						continue;
+
+					file << scope << ','
+						<< entry.ClassName << ','
+						<< (perEntity ? std::to_string(entry.EntityID) : "") << ','
+						<< (perEntity ? 1u : entry.InstanceCount) << ','
+						<< CallbackToString((ScriptCallback)i) << ','
+						<< stats.Calls << ','
+						<< stats.TotalTimeMs << ','
+						<< stats.TotalTimeMs / frames << ','
+						<< stats.TotalTimeMs / (double)stats.Calls << ','
+						<< stats.MaxTimeMs << ','
+						<< stats.AllocatedBytes << ','
+						<< (double)stats.AllocatedBytes / frames << '\n';
+				}
+			}
+		};
+
+		writeRows("Class", GetClassStats(), false);
+		writeRows("Entity", GetEntityStats(), true);
+
+		NB_CORE_INFO("Exported script profile ({0} frames) to: {1}", s_FramesRecorded, filepath.string());
+		return true;
+	}
+
+	void ScriptProfiler::Scope::Begin(uint32_t entityID, const std::string& className, ScriptCallback callback)
+	{
+		m_Active = true;
+		m_EntityID = entityID;
+		m_ClassName = &className;
+		m_Callback = callback;
+		m_GCCountStart = GetGCCount();
+		m_HeapStart = mono_gc_get_used_size();
+		m_Start = std::chrono::steady_clock::now();
+	}
+
+	void ScriptProfiler::Scope::End()
+	{
+		auto end = std::chrono::steady_clock::now();
+		int64_t heapEnd = mono_gc_get_used_size();
+
+		EntityRecord& record = s_Records[m_EntityID];
+		if (record.ClassName != *m_ClassName)
+			record.ClassName = *m_ClassName;
+
+		int index = (int)m_Callback;
+		record.Current.TimeMs[index] += std::chrono::duration<float, std::milli>(end - m_Start).count();
+		record.Current.Calls[index]++;
+
+		// A collection during the call makes the heap delta meaningless
+		if (GetGCCount() == m_GCCountStart && heapEnd > m_HeapStart)
+			record.Current.AllocatedBytes[index] += heapEnd - m_HeapStart;
+	}
+
+}
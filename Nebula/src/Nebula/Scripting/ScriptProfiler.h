@@ -0,0 +1,96 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <filesystem>
+
+namespace Nebula {
+
+	enum class ScriptCallback
+	{
+		OnCreate = 0,
+		OnUpdate,
+		OnDestroy,
+		Count
+	};
+
+	struct ScriptCallbackStats
+	{
+		double TotalTimeMs = 0.0;      // Summed over the window
+		double MaxTimeMs = 0.0;        // Slowest single frame in the window
+		uint64_t Calls = 0;
+		int64_t AllocatedBytes = 0;    // Managed heap growth, calls that triggered a GC are not counted
+	};
+
+	struct ScriptProfileEntry
+	{
+		std::string ClassName;
+		uint32_t EntityID = 0;         // Unused for per-class entries
+		uint32_t InstanceCount = 0;    // Only set for per-class entries
+		ScriptCallbackStats Callbacks[(int)ScriptCallback::Count];
+
+		double GetTotalTimeMs() const;
+	};
+
+	// Samples C# callback cost per entity and keeps a rolling window of the
+	// last N frames. Disabled by default; when off, Begin/End are a single branch.
+	class NEBULA_API ScriptProfiler
+	{
+	public:
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled() { return s_Enabled; }
+
+		// Window length in frames, resets collected data
+		static void SetWindowSize(uint32_t frames);
+		static uint32_t GetWindowSize();
+		static uint32_t GetFramesRecorded();
+
+		static void Reset();
+
+		// Closes the current frame and advances the rolling window
+		static void EndFrame();
+
+		static std::vector<ScriptProfileEntry> GetEntityStats();
+		static std::vector<ScriptProfileEntry> GetClassStats();
+
+		// Writes one row per entity and callback, averaged per frame over the window
+		static bool ExportCSV(const std::filesystem::path& filepath);
+
+		// RAII helper used around every callback invocation
+		class Scope
+		{
+		public:
+			Scope(uint32_t entityID, const std::string& className, ScriptCallback callback)
+			{
+				if (s_Enabled)
+					Begin(entityID, className, callback);
+			}
+
+			~Scope()
+			{
+				if (m_Active)
+					End();
+			}
+
+		private:
+			void Begin(uint32_t entityID, const std::string& className, ScriptCallback callback);
+			void End();
+
+			bool m_Active = false;
+			uint32_t m_EntityID = 0;
+			const std::string* m_ClassName = nullptr;
+			ScriptCallback m_Callback = ScriptCallback::OnUpdate;
+			std::chrono::steady_clock::time_point m_Start;
+			int64_t m_HeapStart = 0;
+			int m_GCCountStart = 0;
+		};
+
+	private:
+		static bool s_Enabled;
+	};
+
+}
@@ -0,0 +1,130 @@
+#include "nbpch.h"
+#include "ScriptScheduler.h"
+#include "ScriptEngine.h"
+#include "Nebula/Scene/Scene.h"
+#include "Nebula/Asset/AssetManager.h"
+#include "Nebula/Log.h"
+
+#include <queue>
+
+namespace Nebula {
+
+	struct ScriptWaiter
+	{
+		uint32_t EntityID;
+		int32_t CoroutineID;
+	};
+
+	struct FrameWaiter
+	{
+		uint64_t Frame;
+		ScriptWaiter Waiter;
+
+		bool operator>(const FrameWaiter& other) const { return Frame > other.Frame; }
+	};
+
+	struct AssetWaiter
+	{
+		AssetHandle Handle;
+		ScriptWaiter Waiter;
+	};
+
+	struct ScriptSchedulerData
+	{
+		uint64_t FrameIndex = 0;
+		std::priority_queue<FrameWaiter, std::vector<FrameWaiter>, std::greater<FrameWaiter>> FrameWaiters;
+		std::vector<ScriptWaiter> PhysicsWaiters;
+		std::vector<AssetWaiter> AssetWaiters;
+	};
+
+	static ScriptSchedulerData s_SchedulerData;
+
+	static void Resume(const ScriptWaiter& waiter)
+	{
+		// The entity or its script may have been destroyed while the coroutine waited
+		Ref<ScriptInstance> instance = ScriptEngine::GetEntityScriptInstance(waiter.EntityID);
+		if (instance)
+			instance->InvokeResumeCoroutine(waiter.CoroutineID);
+	}
+
+	uint64_t ScriptScheduler::Wait(uint32_t entityID, int32_t coroutineID, ScriptWaitType type, float seconds, uint64_t value)
+	{
+		ScriptWaiter waiter{ entityID, coroutineID };
+
+		switch (type)
+		{
+		case ScriptWaitType::Frames:
+		{
+			uint64_t frames = value > 0 ? value : 1;
+			s_SchedulerData.FrameWaiters.push({ s_SchedulerData.FrameIndex + frames, waiter });
+			return 1;
+		}
+		case ScriptWaitType::Seconds:
+		{
+			Scene* scene = ScriptEngine::GetSceneContext();
+			if (!scene)
+				return 0;
+
+			return scene->GetTimerWheel().Schedule(seconds, [waiter]() { Resume(waiter); });
+		}
+		case ScriptWaitType::PhysicsStep:
+			s_SchedulerData.PhysicsWaiters.push_back(waiter);
+			return 1;
+		case ScriptWaitType::AssetLoaded:
+			s_SchedulerData.AssetWaiters.push_back({ AssetHandle(value), waiter });
+			return 1;
+		}
+
+		NB_CORE_WARN("ScriptScheduler: unknown wait type {0}", (int32_t)type);
+		return 0;
+	}
+
+	void ScriptScheduler::OnFrame()
+	{
+		s_SchedulerData.FrameIndex++;
+
+		auto& frameWaiters = s_SchedulerData.FrameWaiters;
+		while (!frameWaiters.empty() && frameWaiters.top().Frame <= s_SchedulerData.FrameIndex)
+		{
+			ScriptWaiter waiter = frameWaiters.top().Waiter;
+			frameWaiters.pop();
+			Resume(waiter);
+		}
+
+		// Only coroutines that are actually waiting on an asset are checked
+		auto& assetWaiters = s_SchedulerData.AssetWaiters;
+		for (size_t i = 0; i < assetWaiters.size();)
+		{
+			if (!AssetManager::IsAssetHandleValid(assetWaiters[i].Handle) || AssetManager::IsAssetLoaded(assetWaiters[i].Handle))
+			{
+				ScriptWaiter waiter = assetWaiters[i].Waiter;
+				assetWaiters[i] = assetWaiters.back();
+				assetWaiters.pop_back();
+				Resume(waiter);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	void ScriptScheduler::OnPhysicsStep()
+	{
+		if (s_SchedulerData.PhysicsWaiters.empty())
+			return;
+
+		// Swapped out so coroutines that wait for another step land in the next batch
+		std::vector<ScriptWaiter> resuming;
+		resuming.swap(s_SchedulerData.PhysicsWaiters);
+		for (const ScriptWaiter& waiter : resuming)
+			Resume(waiter);
+	}
+
+	void ScriptScheduler::Clear()
+	{
+		// Seconds waits live on the scene's TimerWheel, which the scene clears itself
+		s_SchedulerData = ScriptSchedulerData();
+	}
+
+}
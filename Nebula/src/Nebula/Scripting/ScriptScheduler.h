@@ -0,0 +1,36 @@
+#pragma once
+#pragma warning(disable: 4251)
+
+#include "Nebula/Core.h"
+#include <cstdint>
+
+namespace Nebula {
+
+	// Matches Nebula.CoroutineWaitType in NebulaScriptCore
+	enum class ScriptWaitType : int32_t
+	{
+		Frames = 0,      // value = frame count, 1 for a plain "yield return null"
+		Seconds,         // seconds of scene time, runs on the scene's TimerWheel
+		PhysicsStep,     // Resumes after the next physics step
+		AssetLoaded      // value = asset handle
+	};
+
+	// Resumes C# coroutines when what they are waiting on is ready.
+	// A waiting coroutine costs no managed call until it is resumed, so
+	// behaviours that only run coroutines never need a per-frame OnUpdate.
+	class NEBULA_API ScriptScheduler
+	{
+	public:
+		// Returns 0 on failure. For Seconds waits the result is a timer handle that
+		// can be cancelled with Scene::GetTimerWheel(), otherwise it is 1.
+		static uint64_t Wait(uint32_t entityID, int32_t coroutineID, ScriptWaitType type, float seconds, uint64_t value);
+
+		// Resumes frame and asset waits that are due, call once per runtime frame after scripts update
+		static void OnFrame();
+		// Resumes coroutines waiting for a physics step
+		static void OnPhysicsStep();
+
+		static void Clear();
+	};
+
+}
@@ -66,7 +66,7 @@ namespace Nebula {
 
 		// Load and set window icon
 		// Note: Title bar icons are limited to 16x16 by Windows, but taskbar/Alt+Tab use larger sizes
-		stbi_set_flip_vertically_on_load(0); // Don't flip icon
+		stbi_set_flip_vertically_on_load_thread(0); // Don't flip icon
 		int iconWidth, iconHeight, iconChannels;
 		unsigned char* iconPixels = stbi_load("Library/logo.png", &iconWidth, &iconHeight, &iconChannels, 4);
 		if (iconPixels)
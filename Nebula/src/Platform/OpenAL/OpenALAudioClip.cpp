@@ -1,6 +1,8 @@
 #include "nbpch.h"
 #include "OpenALAudioClip.h"
+#include "Nebula/Audio/PCMConversion.h"
 #include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
 #include <AL/al.h>
 #include <fstream>
 #include <cstring>
@@ -28,12 +30,15 @@ namespace Nebula {
 		uint32_t Subchunk2Size;
 	};
 
-	OpenALAudioClip::OpenALAudioClip(const std::string& filepath)
-		: m_FilePath(filepath)
+	OpenALAudioClip::OpenALAudioClip(const std::string& filepath, const AudioClipImportOptions& options)
+		: m_FilePath(filepath), m_Options(options)
 	{
-		// Generate OpenAL buffer
-		alGenBuffers(1, &m_BufferID);
-		
+	}
+
+	void OpenALAudioClip::Decode()
+	{
+		const std::string& filepath = m_FilePath;
+
 		// Check file extension and load appropriately
 		if (filepath.find(".wav") != std::string::npos || filepath.find(".WAV") != std::string::npos)
 		{
@@ -60,6 +65,46 @@ namespace Nebula {
 		{
 			NB_CORE_ERROR("Unsupported audio format: {0}", filepath);
 		}
+
+		if (!m_PendingData.empty())
+			Import();
+	}
+
+	void OpenALAudioClip::Import()
+	{
+		bool downmix = m_Options.Mono && m_Channels == 2;
+		bool resample = m_Options.SampleRate != 0 && m_Options.SampleRate != (uint32_t)m_SampleRate;
+		if (!downmix && !resample)
+			return;
+
+		// Both work on 16-bit samples
+		if (m_PendingFormat == AL_FORMAT_MONO8 || m_PendingFormat == AL_FORMAT_STEREO8)
+		{
+			std::vector<char> widened(m_PendingData.size() * sizeof(int16_t));
+			PCMConversion::UInt8ToInt16(reinterpret_cast<const uint8_t*>(m_PendingData.data()), reinterpret_cast<int16_t*>(widened.data()), m_PendingData.size());
+			m_PendingData = std::move(widened);
+		}
+
+		int16_t* samples = reinterpret_cast<int16_t*>(m_PendingData.data());
+		size_t frameCount = m_PendingData.size() / sizeof(int16_t) / m_Channels;
+
+		if (downmix)
+		{
+			PCMConversion::DownmixStereoToMono(samples, samples, frameCount);
+			m_PendingData.resize(frameCount * sizeof(int16_t));
+			m_Channels = 1;
+		}
+
+		if (resample)
+		{
+			std::vector<int16_t> resampled;
+			PCMConversion::Resample(samples, frameCount, m_Channels, (uint32_t)m_SampleRate, m_Options.SampleRate, resampled);
+			const char* bytes = reinterpret_cast<const char*>(resampled.data());
+			m_PendingData.assign(bytes, bytes + resampled.size() * sizeof(int16_t));
+			m_SampleRate = (int)m_Options.SampleRate;
+		}
+
+		m_PendingFormat = (m_Channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 	}
 
 	OpenALAudioClip::~OpenALAudioClip()
@@ -70,10 +115,34 @@ namespace Nebula {
 		}
 	}
 
+	void OpenALAudioClip::Upload()
+	{
+		if (m_Ready)
+			return;
+
+		// A clip that failed to decode is ready too, it just plays nothing
+		m_Ready = true;
+		if (m_PendingData.empty() || m_PendingFormat == 0)
+			return;
+
+		alGenBuffers(1, &m_BufferID);
+		alBufferData(m_BufferID, m_PendingFormat, m_PendingData.data(), static_cast<ALsizei>(m_PendingData.size()), m_SampleRate);
+
+		ALenum error = alGetError();
+		if (error != AL_NO_ERROR)
+		{
+			NB_CORE_ERROR("OpenAL error uploading audio: {0} ({1})", m_FilePath, error);
+		}
+
+		// OpenAL keeps its own copy
+		m_DecodedSize = m_PendingData.size();
+		std::vector<char>().swap(m_PendingData);
+	}
+
 	bool OpenALAudioClip::LoadWAV(const std::string& filepath)
 	{
-		std::ifstream file(filepath, std::ios::binary);
-		if (!file.is_open())
+		VirtualFileStream file(VirtualFileSystem::ReadFile(filepath));
+		if (!file)
 		{
 			NB_CORE_ERROR("Failed to open WAV file: {0}", filepath);
 			return false;
@@ -177,14 +246,9 @@ namespace Nebula {
 			filepath, file.gcount(), dataSize);
 		return false;
 	}
-	
-	file.close();
 
 	// Determine OpenAL format
 	ALenum format = 0;
-	std::vector<int16_t> convertedData;
-	const char* dataToUpload = audioData.data();
-	size_t uploadSize = audioData.size();
 
 	if (numChannels == 1 && bitsPerSample == 8)			format = AL_FORMAT_MONO8;
 		else if (numChannels == 1 && bitsPerSample == 16)
@@ -195,23 +259,12 @@ namespace Nebula {
 			format = AL_FORMAT_STEREO16;
 		else if (bitsPerSample == 32 && audioFormat == 3) // IEEE Float
 		{
-			// Convert 32-bit float to 16-bit PCM
+			// Convert 32-bit float to 16-bit PCM, in place
 			NB_CORE_WARN("Converting 32-bit float audio to 16-bit PCM: {0}", filepath);
 			
 			size_t sampleCount = audioData.size() / sizeof(float);
-			convertedData.resize(sampleCount);
-			
-			const float* floatData = reinterpret_cast<const float*>(audioData.data());
-			for (size_t i = 0; i < sampleCount; ++i)
-			{
-				// Clamp and convert float [-1.0, 1.0] to int16
-				float sample = floatData[i];
-				sample = (sample < -1.0f) ? -1.0f : (sample > 1.0f) ? 1.0f : sample;
-				convertedData[i] = static_cast<int16_t>(sample * 32767.0f);
-			}
-			
-			dataToUpload = reinterpret_cast<const char*>(convertedData.data());
-			uploadSize = convertedData.size() * sizeof(int16_t);
+			PCMConversion::FloatToInt16(reinterpret_cast<const float*>(audioData.data()), reinterpret_cast<int16_t*>(audioData.data()), sampleCount);
+			audioData.resize(sampleCount * sizeof(int16_t));
 			format = (numChannels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 		}
 		else
@@ -221,14 +274,15 @@ namespace Nebula {
 		}
 
 	// Validate buffer data before uploading
-	if (uploadSize == 0 || format == 0)
+	if (audioData.empty() || format == 0)
 	{
-		NB_CORE_ERROR("Invalid buffer data for WAV file: {0} (size: {1}, format: {2})", filepath, uploadSize, format);
+		NB_CORE_ERROR("Invalid buffer data for WAV file: {0} (size: {1}, format: {2})", filepath, audioData.size(), format);
 		return false;
 	}
 
-	// Upload to OpenAL buffer
-	alBufferData(m_BufferID, format, dataToUpload, static_cast<ALsizei>(uploadSize), sampleRate);
+	// Keep it for Upload()
+	m_PendingData = std::move(audioData);
+	m_PendingFormat = format;
 
 NB_CORE_INFO("Loaded WAV audio: {0} ({1} channels, {2} Hz, {3:.2f}s)", filepath, m_Channels, m_SampleRate, m_Duration);
 	return true;
@@ -236,38 +290,31 @@ NB_CORE_INFO("Loaded WAV audio: {0} ({1} channels, {2} Hz, {3:.2f}s)", filepath,
 
 bool OpenALAudioClip::LoadMP3(const std::string& filepath)
 {
-	drmp3_config config;
-	drmp3_uint64 totalFrameCount;
-	drmp3_int16* pSampleData = drmp3_open_file_and_read_pcm_frames_s16(filepath.c_str(), &config, &totalFrameCount, nullptr);
-	
-	if (pSampleData == nullptr)
-	{
+		VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+		drmp3 mp3;
+		if (!file || !drmp3_init_memory(&mp3, file.GetData(), file.GetSize(), nullptr))
+		{
 			NB_CORE_ERROR("Failed to decode MP3 file: {0}", filepath);
 			return false;
 		}
 
-		// Store properties
-		m_SampleRate = config.sampleRate;
-		m_Channels = config.channels;
-		m_Duration = static_cast<float>(totalFrameCount) / static_cast<float>(config.sampleRate);
-
-		// Determine OpenAL format
-		ALenum format = (config.channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-		
-		// Calculate data size in bytes
-		size_t dataSize = totalFrameCount * config.channels * sizeof(drmp3_int16);
+		// Sized up front and decoded in place, rather than grown while decoding and copied
+		drmp3_uint64 totalFrameCount = drmp3_get_pcm_frame_count(&mp3);
+		m_PendingData.resize(totalFrameCount * mp3.channels * sizeof(drmp3_int16));
+		drmp3_uint64 framesRead = drmp3_read_pcm_frames_s16(&mp3, totalFrameCount, reinterpret_cast<drmp3_int16*>(m_PendingData.data()));
+		m_PendingData.resize(framesRead * mp3.channels * sizeof(drmp3_int16));
 
-		// Upload to OpenAL buffer
-		alBufferData(m_BufferID, format, pSampleData, static_cast<ALsizei>(dataSize), config.sampleRate);
+		// Store properties
+		m_SampleRate = mp3.sampleRate;
+		m_Channels = mp3.channels;
+		m_Duration = static_cast<float>(framesRead) / static_cast<float>(mp3.sampleRate);
+		m_PendingFormat = (mp3.channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 
-		// Free the decoded data
-		drmp3_free(pSampleData, nullptr);
+		drmp3_uninit(&mp3);
 
-		// Check for errors
-		ALenum error = alGetError();
-		if (error != AL_NO_ERROR)
+		if (framesRead == 0)
 		{
-			NB_CORE_ERROR("OpenAL error loading MP3: {0}", error);
+			NB_CORE_ERROR("Failed to decode MP3 file: {0}", filepath);
 			return false;
 		}
 
@@ -3,19 +3,25 @@
 #include "Nebula/Audio/AudioClip.h"
 #include <AL/al.h>
 #include <string>
+#include <vector>
 
 namespace Nebula {
 
 	class OpenALAudioClip : public AudioClip
 	{
 	public:
-		OpenALAudioClip(const std::string& filepath);
+		OpenALAudioClip(const std::string& filepath, const AudioClipImportOptions& options = {});
 		virtual ~OpenALAudioClip();
 
 		virtual float GetDuration() const override { return m_Duration; }
 		virtual int GetSampleRate() const override { return m_SampleRate; }
 		virtual int GetChannels() const override { return m_Channels; }
 		virtual const std::string& GetFilePath() const override { return m_FilePath; }
+		virtual uint64_t GetDecodedSize() const override { return m_DecodedSize; }
+
+		virtual void Decode() override;
+		virtual void Upload() override;
+		virtual bool IsReady() const override { return m_Ready; }
 
 		virtual void* GetNativeHandle() const override { return (void*)(uintptr_t)m_BufferID; }
 		ALuint GetBufferID() const { return m_BufferID; }
@@ -24,13 +30,22 @@ namespace Nebula {
 		bool LoadWAV(const std::string& filepath);
 		bool LoadMP3(const std::string& filepath);
 		bool LoadOGG(const std::string& filepath);
+		// Applies m_Options to the pending samples
+		void Import();
 
 	private:
 		std::string m_FilePath;
+		AudioClipImportOptions m_Options;
 		ALuint m_BufferID = 0;
+		uint64_t m_DecodedSize = 0;
 		float m_Duration = 0.0f;
 		int m_SampleRate = 0;
 		int m_Channels = 0;
+		bool m_Ready = false;
+
+		// Decoded PCM waiting for Upload()
+		std::vector<char> m_PendingData;
+		ALenum m_PendingFormat = 0;
 	};
 
 }
@@ -1,8 +1,11 @@
 #include "nbpch.h"
 #include "OpenALAudioEngine.h"
 #include "OpenALAudioClip.h"
+#include "OpenALAudioStream.h"
 #include "Nebula/Log.h"
 
+#include <cmath>
+
 namespace Nebula {
 
 	OpenALAudioEngine::OpenALAudioEngine()
@@ -18,23 +21,8 @@ namespace Nebula {
 	{
 		NB_CORE_INFO("Initializing OpenAL Audio Engine...");
 
-		// Open default audio device
-		m_Device = alcOpenDevice(nullptr);
-		if (!m_Device)
-		{
-			NB_CORE_ERROR("Failed to open OpenAL device");
+		if (!OpenDevice())
 			return false;
-		}
-
-		// Create audio context
-		m_Context = alcCreateContext(m_Device, nullptr);
-		if (!m_Context)
-		{
-			NB_CORE_ERROR("Failed to create OpenAL context");
-			alcCloseDevice(m_Device);
-			m_Device = nullptr;
-			return false;
-		}
 
 		// Make context current
 		if (!alcMakeContextCurrent(m_Context))
@@ -62,25 +50,75 @@ namespace Nebula {
 			return false;
 		}
 
+		// Never ask for more real voices than the device can mix
+		ALCint monoSources = 0;
+		alcGetIntegerv(m_Device, ALC_MONO_SOURCES, 1, &monoSources);
+		if (monoSources > 0 && (uint32_t)monoSources < m_MaxRealVoices)
+			m_MaxRealVoices = (uint32_t)monoSources;
+
+		ALCint frequency = 0;
+		alcGetIntegerv(m_Device, ALC_FREQUENCY, 1, &frequency);
+		m_DeviceSampleRate = frequency > 0 ? (uint32_t)frequency : 0;
+
 		// Log OpenAL version info
 		const ALCchar* deviceName = alcGetString(m_Device, ALC_DEVICE_SPECIFIER);
 		NB_CORE_INFO("OpenAL Device: {0}", deviceName ? deviceName : "Unknown");
 		NB_CORE_INFO("OpenAL Vendor: {0}", alGetString(AL_VENDOR));
 		NB_CORE_INFO("OpenAL Renderer: {0}", alGetString(AL_RENDERER));
 		NB_CORE_INFO("OpenAL Version: {0}", alGetString(AL_VERSION));
+		NB_CORE_INFO("OpenAL real voices: {0}", m_MaxRealVoices);
+
+		StartStreamThread();
 
 		NB_CORE_INFO("OpenAL Audio Engine initialized successfully");
 		return true;
 	}
 
+	bool OpenALAudioEngine::OpenDevice()
+	{
+		// Open default audio device
+		m_Device = alcOpenDevice(nullptr);
+		if (!m_Device)
+		{
+			NB_CORE_ERROR("Failed to open OpenAL device");
+			return false;
+		}
+
+		// Create audio context
+		m_Context = alcCreateContext(m_Device, nullptr);
+		if (!m_Context)
+		{
+			NB_CORE_ERROR("Failed to create OpenAL context");
+			alcCloseDevice(m_Device);
+			m_Device = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+
 	void OpenALAudioEngine::Shutdown()
 	{
-		// Delete all sources
-		for (auto& pair : m_Sources)
+		// Streams own AL buffers, release them while the context is still current
+		for (auto& pair : m_Streams)
+			pair.second->Release();
+		StopStreamThread();
+		m_Streams.clear();
+
+		// Delete the real voices, free or in use
+		for (Voice& voice : m_Voices)
 		{
-			alDeleteSources(1, &pair.second);
+			if (voice.Source != 0)
+				m_FreeSources.push_back(voice.Source);
 		}
-		m_Sources.clear();
+		if (!m_FreeSources.empty())
+			alDeleteSources((ALsizei)m_FreeSources.size(), m_FreeSources.data());
+		m_FreeSources.clear();
+		m_SourcePoolSize = 0;
+		m_Voices.clear();
+		m_VoiceSlots.clear();
+		m_FreeSlots.clear();
+		m_DirtyVoices.clear();
 
 		// Cleanup OpenAL
 		if (m_Context)
@@ -107,6 +145,7 @@ namespace Nebula {
 
 	void OpenALAudioEngine::SetListenerPosition(const glm::vec3& position)
 	{
+		m_ListenerPosition = position;
 		alListener3f(AL_POSITION, position.x, position.y, position.z);
 	}
 
@@ -123,237 +162,690 @@ namespace Nebula {
 
 	uint32_t OpenALAudioEngine::CreateSource()
 	{
-		ALuint source;
-		alGenSources(1, &source);
-
-		ALenum error = alGetError();
-		if (error != AL_NO_ERROR)
+		uint32_t slot;
+		if (!m_FreeSlots.empty())
 		{
-			NB_CORE_ERROR("Failed to create OpenAL source: {0}", error);
-			return 0;
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			if (m_VoiceSlots.size() > s_SlotMask)
+			{
+				NB_CORE_ERROR("Too many audio sources");
+				return 0;
+			}
+			slot = (uint32_t)m_VoiceSlots.size();
+			m_VoiceSlots.emplace_back();
 		}
 
-		// Set default source properties
-		alSourcef(source, AL_PITCH, 1.0f);
-		alSourcef(source, AL_GAIN, 1.0f);
-		alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
-		alSource3f(source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
-		alSourcei(source, AL_LOOPING, AL_FALSE);
-		alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE); // Spatial audio by default
-
-		// Set spatial audio parameters
-		alSourcef(source, AL_ROLLOFF_FACTOR, 1.0f);
-		alSourcef(source, AL_REFERENCE_DISTANCE, 1.0f);
-		alSourcef(source, AL_MAX_DISTANCE, 100.0f);
-
-		uint32_t sourceID = m_NextSourceID++;
-		m_Sources[sourceID] = source;
-
-		return sourceID;
+		// Voices start virtual, a real source is only attached while playing
+		VoiceSlot& voiceSlot = m_VoiceSlots[slot];
+		voiceSlot.Index = (uint32_t)m_Voices.size();
+		m_Voices.emplace_back();
+		m_Voices.back().ID = (voiceSlot.Generation << s_SlotBits) | slot;
+		return m_Voices.back().ID;
 	}
 
 	void OpenALAudioEngine::DestroySource(uint32_t sourceID)
 	{
-		auto it = m_Sources.find(sourceID);
-		if (it != m_Sources.end())
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->State = VoiceState::Stopped;
+		ReleaseRealVoice(sourceID, *voice);
+
+		// Keep the array dense, the last voice moves into the hole
+		VoiceSlot& slot = m_VoiceSlots[sourceID & s_SlotMask];
+		if (slot.Index != m_Voices.size() - 1)
 		{
-			alDeleteSources(1, &it->second);
-			m_Sources.erase(it);
+			m_Voices[slot.Index] = std::move(m_Voices.back());
+			m_VoiceSlots[m_Voices[slot.Index].ID & s_SlotMask].Index = slot.Index;
 		}
+		m_Voices.pop_back();
+
+		// Generation 0 would make ID 0 possible
+		slot.Generation = (slot.Generation + 1) & (0xFFFFFFFFu >> s_SlotBits);
+		if (slot.Generation == 0)
+			slot.Generation = 1;
+		m_FreeSlots.push_back(sourceID & s_SlotMask);
 	}
 
 	void OpenALAudioEngine::PlaySource(uint32_t sourceID)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		Voice* voice = GetVoice(sourceID);
+		if (!voice || !voice->Clip)
+			return;
+
+		if (!voice->Clip->IsReady())
 		{
-			alSourcePlay(source);
+			// Still loading, Update() starts it from the beginning once the clip is uploaded
+			if (voice->State != VoiceState::Paused)
+				voice->Time = 0.0f;
+			voice->State = VoiceState::Playing;
+			return;
 		}
+
+		// Like alSourcePlay, playing again restarts and playing after a pause resumes
+		if (voice->State != VoiceState::Paused)
+			voice->Time = 0.0f;
+		voice->State = VoiceState::Playing;
+
+		if (voice->Source != 0)
+		{
+			FlushVoice(*voice);
+			if (OpenALAudioStream* stream = GetStream(sourceID))
+			{
+				stream->Stop();
+				stream->Play();
+				WakeStreamThread();
+				return;
+			}
+
+			alSourceStop(voice->Source);
+			alSourcef(voice->Source, AL_SEC_OFFSET, voice->Time);
+			alSourcePlay(voice->Source);
+			return;
+		}
+
+		// Start right away if it can be heard and a voice is free, otherwise Update() decides
+		voice->Audibility = ComputeAudibility(*voice);
+		if (voice->Audibility > 0.0f && voice->Audibility >= m_AudibilityThreshold)
+			AcquireRealVoice(sourceID, *voice);
 	}
 
 	void OpenALAudioEngine::PauseSource(uint32_t sourceID)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSourcePause(source);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice || voice->State != VoiceState::Playing)
+			return;
+
+		voice->State = VoiceState::Paused;
+
+		// A paused voice doesn't need to be mixed, ReleaseRealVoice() keeps the position
+		ReleaseRealVoice(sourceID, *voice);
 	}
 
 	void OpenALAudioEngine::StopSource(uint32_t sourceID)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSourceStop(source);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->State = VoiceState::Stopped;
+		ReleaseRealVoice(sourceID, *voice);
+		voice->Time = 0.0f;
 	}
 
 	void OpenALAudioEngine::StopAll()
 	{
-		for (const auto& pair : m_Sources)
+		for (Voice& voice : m_Voices)
 		{
-			ALuint source = pair.second;
-			alSourceStop(source);
-			// Rewind to beginning to fully reset the source
-			alSourceRewind(source);
+			voice.State = VoiceState::Stopped;
+			ReleaseRealVoice(voice.ID, voice);
+			voice.Time = 0.0f;
 		}
 	}
 
 	bool OpenALAudioEngine::IsSourcePlaying(uint32_t sourceID) const
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			ALint state;
-			alGetSourcei(source, AL_SOURCE_STATE, &state);
-			return state == AL_PLAYING;
-		}
-		return false;
+		// Virtual voices count as playing, their sound is only culled
+		const Voice* voice = GetVoice(sourceID);
+		return voice && voice->State == VoiceState::Playing;
 	}
 
-	void OpenALAudioEngine::SetSourceClip(uint32_t sourceID, AudioClip* clip)
+	void OpenALAudioEngine::SetSourceClip(uint32_t sourceID, const std::shared_ptr<AudioClip>& clip)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0 && clip != nullptr)
-		{
-			OpenALAudioClip* openalClip = static_cast<OpenALAudioClip*>(clip);
-			alSourcei(source, AL_BUFFER, openalClip->GetBufferID());
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice || !clip)
+			return;
+
+		// A new clip starts from the beginning and needs a fresh buffer or stream
+		voice->State = VoiceState::Stopped;
+		ReleaseRealVoice(sourceID, *voice);
+		voice->Time = 0.0f;
+		voice->Clip = clip;
 	}
 
 	void OpenALAudioEngine::SetSourcePosition(uint32_t sourceID, const glm::vec3& position)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSource3f(source, AL_POSITION, position.x, position.y, position.z);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		// Called every frame for every spatial source, most of them haven't moved
+		if (voice->Position == position)
+			return;
+
+		voice->Position = position;
+		MarkDirty(*voice, DirtyPosition);
 	}
 
 	void OpenALAudioEngine::SetSourceVelocity(uint32_t sourceID, const glm::vec3& velocity)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSource3f(source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		if (voice->Velocity == velocity)
+			return;
+
+		voice->Velocity = velocity;
+		MarkDirty(*voice, DirtyVelocity);
 	}
 
 	void OpenALAudioEngine::SetSourceVolume(uint32_t sourceID, float volume)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSourcef(source, AL_GAIN, glm::clamp(volume, 0.0f, 1.0f));
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->Volume = glm::clamp(volume, 0.0f, 1.0f);
+		MarkDirty(*voice, DirtyGain);
 	}
 
 	void OpenALAudioEngine::SetSourcePitch(uint32_t sourceID, float pitch)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSourcef(source, AL_PITCH, glm::max(pitch, 0.01f));
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->Pitch = glm::max(pitch, 0.01f);
+		MarkDirty(*voice, DirtyPitch);
 	}
 
 	void OpenALAudioEngine::SetSourceLoop(uint32_t sourceID, bool loop)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			alSourcei(source, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->Loop = loop;
+
+		// Streams loop in the decoder, a looping source would replay its queue
+		if (OpenALAudioStream* stream = GetStream(sourceID))
+			stream->SetLooping(loop);
+		else
+			MarkDirty(*voice, DirtyLooping);
 	}
 
 	void OpenALAudioEngine::SetSourceSpatial(uint32_t sourceID, bool spatial)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
-		{
-			// AL_SOURCE_RELATIVE: true = non-spatial (relative to listener), false = spatial (world position)
-			alSourcei(source, AL_SOURCE_RELATIVE, spatial ? AL_FALSE : AL_TRUE);
-		}
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->Spatial = spatial;
+		MarkDirty(*voice, DirtyRelative);
+	}
+
+	void OpenALAudioEngine::SetSourcePriority(uint32_t sourceID, int priority)
+	{
+		if (Voice* voice = GetVoice(sourceID))
+			voice->Priority = priority;
 	}
 
 	float OpenALAudioEngine::GetSourceVolume(uint32_t sourceID) const
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		const Voice* voice = GetVoice(sourceID);
+		return voice ? voice->Volume : 0.0f;
+	}
+
+	float OpenALAudioEngine::GetSourcePitch(uint32_t sourceID) const
+	{
+		const Voice* voice = GetVoice(sourceID);
+		return voice ? voice->Pitch : 1.0f;
+	}
+
+	bool OpenALAudioEngine::GetSourceLoop(uint32_t sourceID) const
+	{
+		const Voice* voice = GetVoice(sourceID);
+		return voice ? voice->Loop : false;
+	}
+
+	void OpenALAudioEngine::SetSourceRolloffFactor(uint32_t sourceID, float rolloff)
+	{
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->RolloffFactor = glm::max(rolloff, 0.0f);
+		MarkDirty(*voice, DirtyRolloff);
+	}
+
+	void OpenALAudioEngine::SetSourceReferenceDistance(uint32_t sourceID, float distance)
+	{
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->ReferenceDistance = glm::max(distance, 0.0f);
+		MarkDirty(*voice, DirtyReferenceDistance);
+	}
+
+	void OpenALAudioEngine::SetSourceMaxDistance(uint32_t sourceID, float distance)
+	{
+		Voice* voice = GetVoice(sourceID);
+		if (!voice)
+			return;
+
+		voice->MaxDistance = glm::max(distance, 0.0f);
+		MarkDirty(*voice, DirtyMaxDistance);
+	}
+
+	void OpenALAudioEngine::SetMaxRealVoices(uint32_t count)
+	{
+		// Voices over the new limit are virtualized by the next Update()
+		m_MaxRealVoices = glm::max(count, 1u);
+	}
+
+	void OpenALAudioEngine::Update()
+	{
+		auto now = std::chrono::steady_clock::now();
+		float deltaTime = m_HasUpdated ? std::chrono::duration<float>(now - m_LastUpdateTime).count() : 0.0f;
+		m_LastUpdateTime = now;
+		m_HasUpdated = true;
+
+		FinishClipLoads();
+		if (!m_Context)
+			return;
+
+		// Everything below reaches the mixer as one update
+		alcSuspendContext(m_Context);
+
+		// Finished sources and voice ranking don't need to be looked at every frame
+		m_StatePollTimer += deltaTime;
+		if (m_StatePollTimer >= m_StatePollInterval)
 		{
-			ALfloat volume;
-			alGetSourcef(source, AL_GAIN, &volume);
-			return volume;
+			AssignRealVoices(m_StatePollTimer);
+			m_StatePollTimer = 0.0f;
 		}
-		return 0.0f;
+
+		FlushDirtyVoices();
+		alcProcessContext(m_Context);
+
+		if (m_Streams.empty())
+			return;
+
+		// Queue what the stream thread decoded and hand it the buffers that finished playing
+		for (auto& pair : m_Streams)
+			pair.second->Update();
+
+		WakeStreamThread();
 	}
 
-	float OpenALAudioEngine::GetSourcePitch(uint32_t sourceID) const
+	void OpenALAudioEngine::AssignRealVoices(float deltaTime)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		m_VoiceRanks.clear();
+
+		for (Voice& voice : m_Voices)
+		{
+			if (voice.State != VoiceState::Playing)
+				continue;
+
+			// Played before its clip finished loading, waits without advancing
+			if (!voice.Clip->IsReady())
+				continue;
+
+			if (voice.Source != 0)
+			{
+				// Played to the end on its own. A stream's source also stops when the decoder falls behind, so ask the stream.
+				bool finished;
+				if (voice.IsStreaming())
+				{
+					OpenALAudioStream* stream = GetStream(voice.ID);
+					finished = !stream || !stream->IsPlaying();
+				}
+				else
+				{
+					ALint state;
+					alGetSourcei(voice.Source, AL_SOURCE_STATE, &state);
+					finished = state == AL_STOPPED;
+				}
+
+				if (finished)
+				{
+					voice.State = VoiceState::Stopped;
+					ReleaseRealVoice(voice.ID, voice);
+					voice.Time = 0.0f;
+					continue;
+				}
+			}
+			else
+			{
+				// Virtual voices advance without being mixed
+				float duration = voice.Clip->GetDuration();
+				voice.Time += deltaTime * voice.Pitch;
+				if (duration <= 0.0f || (!voice.Loop && voice.Time >= duration))
+				{
+					voice.State = VoiceState::Stopped;
+					ReleaseRealVoice(voice.ID, voice);
+					voice.Time = 0.0f;
+					continue;
+				}
+				if (voice.Time >= duration)
+					voice.Time = std::fmod(voice.Time, duration);
+			}
+
+			voice.Audibility = ComputeAudibility(voice);
+			// Small bonus for voices that are already real so equal voices don't swap every frame
+			float audibility = voice.Source != 0 ? voice.Audibility * 1.1f : voice.Audibility;
+
+			if (audibility < m_AudibilityThreshold || voice.Audibility <= 0.0f)
+			{
+				// Out of earshot. Keeps playing virtually and picks up at its offset when it's back in range.
+				if (voice.Source != 0)
+					ReleaseRealVoice(voice.ID, voice);
+				continue;
+			}
+
+			m_VoiceRanks.push_back({ voice.ID, voice.Priority, audibility });
+		}
+
+		size_t realCount = glm::min<size_t>(m_MaxRealVoices, m_VoiceRanks.size());
+
+		// Lower priority values win, then the louder voice. Only the winners need to be found, not sorted.
+		if (realCount < m_VoiceRanks.size())
+		{
+			std::nth_element(m_VoiceRanks.begin(), m_VoiceRanks.begin() + realCount, m_VoiceRanks.end(),
+				[](const VoiceRank& a, const VoiceRank& b)
+				{
+					if (a.Priority != b.Priority)
+						return a.Priority < b.Priority;
+					return a.Audibility > b.Audibility;
+				});
+		}
+
+		// Virtualize the losers first so their sources can go to the winners
+		for (size_t i = realCount; i < m_VoiceRanks.size(); i++)
 		{
-			ALfloat pitch;
-			alGetSourcef(source, AL_PITCH, &pitch);
-			return pitch;
+			Voice& voice = *GetVoice(m_VoiceRanks[i].SourceID);
+			if (voice.Source != 0)
+				ReleaseRealVoice(m_VoiceRanks[i].SourceID, voice);
+		}
+
+		for (size_t i = 0; i < realCount; i++)
+		{
+			Voice& voice = *GetVoice(m_VoiceRanks[i].SourceID);
+			if (voice.Source == 0)
+				AcquireRealVoice(m_VoiceRanks[i].SourceID, voice);
 		}
-		return 1.0f;
 	}
 
-	bool OpenALAudioEngine::GetSourceLoop(uint32_t sourceID) const
+	float OpenALAudioEngine::ComputeAudibility(const Voice& voice) const
+	{
+		if (!voice.Spatial)
+			return voice.Volume;
+
+		// Past MaxDistance a source is culled rather than left at its clamped gain. A real voice
+		// gets a little further, so one right at the edge doesn't flip on every poll.
+		float distance = glm::length(voice.Position - m_ListenerPosition);
+		float cullDistance = voice.Source != 0 ? voice.MaxDistance * s_MaxDistanceHysteresis : voice.MaxDistance;
+		if (distance > cullDistance)
+			return 0.0f;
+
+		// AL_INVERSE_DISTANCE_CLAMPED, OpenAL's default distance model
+		distance = glm::clamp(distance, voice.ReferenceDistance, glm::max(voice.MaxDistance, voice.ReferenceDistance));
+
+		float denominator = voice.ReferenceDistance + voice.RolloffFactor * (distance - voice.ReferenceDistance);
+		float attenuation = denominator > 0.0f ? voice.ReferenceDistance / denominator : 1.0f;
+		return voice.Volume * attenuation;
+	}
+
+	bool OpenALAudioEngine::AcquireRealVoice(uint32_t sourceID, Voice& voice)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		if (voice.Source != 0)
+			return true;
+
+		if (m_FreeSources.empty() && m_SourcePoolSize < m_MaxRealVoices)
 		{
-			ALint loop;
-			alGetSourcei(source, AL_LOOPING, &loop);
-			return loop == AL_TRUE;
+			ALuint source;
+			alGenSources(1, &source);
+			if (alGetError() == AL_NO_ERROR)
+			{
+				m_FreeSources.push_back(source);
+				m_SourcePoolSize++;
+			}
+			else
+			{
+				// The device ran out of voices before our limit
+				m_MaxRealVoices = m_SourcePoolSize;
+			}
 		}
-		return false;
+
+		if (m_FreeSources.empty())
+			return false;
+
+		voice.Source = m_FreeSources.back();
+		m_FreeSources.pop_back();
+		ApplyVoice(voice);
+
+		if (voice.IsStreaming())
+		{
+			// A voice that was real before still has its stream, only the first time opens one.
+			// Either way the stream thread does the opening and seeking.
+			OpenALAudioStream* stream = GetStream(sourceID);
+			if (!stream)
+			{
+				auto newStream = std::make_shared<OpenALAudioStream>(std::static_pointer_cast<const OpenALStreamingAudioClip>(voice.Clip));
+				stream = newStream.get();
+				std::lock_guard<std::mutex> lock(m_StreamMutex);
+				m_Streams[sourceID] = std::move(newStream);
+			}
+
+			if (!stream->IsValid())
+			{
+				ReleaseStream(sourceID);
+				m_FreeSources.push_back(voice.Source);
+				voice.Source = 0;
+				return false;
+			}
+
+			// Pick up where the virtual voice is
+			stream->Attach(voice.Source);
+			stream->SetLooping(voice.Loop);
+			stream->Seek((uint64_t)(voice.Time * voice.Clip->GetSampleRate() + 0.5f));
+			if (voice.State == VoiceState::Playing)
+				stream->Play();
+			WakeStreamThread();
+			return true;
+		}
+
+		// Pick up where the virtual voice is
+		OpenALAudioClip* clip = static_cast<OpenALAudioClip*>(voice.Clip.get());
+		alSourcei(voice.Source, AL_BUFFER, clip->GetBufferID());
+		alSourcef(voice.Source, AL_SEC_OFFSET, voice.Time);
+		if (voice.State == VoiceState::Playing)
+			alSourcePlay(voice.Source);
+		return true;
 	}
 
-	void OpenALAudioEngine::SetSourceRolloffFactor(uint32_t sourceID, float rolloff)
+	void OpenALAudioEngine::ReleaseRealVoice(uint32_t sourceID, Voice& voice)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		if (voice.Source != 0)
 		{
-			alSourcef(source, AL_ROLLOFF_FACTOR, glm::max(rolloff, 0.0f));
+			if (OpenALAudioStream* stream = GetStream(sourceID))
+			{
+				// Remember where it was, the stream seeks back there when the voice is real again
+				voice.Time = (float)stream->GetPlaybackFrame() / (float)voice.Clip->GetSampleRate();
+				stream->Detach();
+			}
+			else
+			{
+				// Remember where it was so the voice can continue virtually
+				ALfloat offset = 0.0f;
+				alGetSourcef(voice.Source, AL_SEC_OFFSET, &offset);
+				voice.Time = offset;
+				alSourceStop(voice.Source);
+				alSourcei(voice.Source, AL_BUFFER, 0);
+			}
+
+			m_FreeSources.push_back(voice.Source);
+			voice.Source = 0;
 		}
+
+		// A virtual or paused stream keeps its decoder open, a stopped one lets it go
+		if (voice.State == VoiceState::Stopped)
+			ReleaseStream(sourceID);
 	}
 
-	void OpenALAudioEngine::SetSourceReferenceDistance(uint32_t sourceID, float distance)
+	void OpenALAudioEngine::ApplyVoice(Voice& voice)
+	{
+		voice.Dirty = 0;
+
+		ALuint source = voice.Source;
+		alSourcef(source, AL_PITCH, voice.Pitch);
+		alSourcef(source, AL_GAIN, voice.Volume);
+		alSource3f(source, AL_POSITION, voice.Position.x, voice.Position.y, voice.Position.z);
+		alSource3f(source, AL_VELOCITY, voice.Velocity.x, voice.Velocity.y, voice.Velocity.z);
+		alSourcei(source, AL_LOOPING, (voice.Loop && !voice.IsStreaming()) ? AL_TRUE : AL_FALSE);
+		alSourcei(source, AL_SOURCE_RELATIVE, voice.Spatial ? AL_FALSE : AL_TRUE);
+		alSourcef(source, AL_ROLLOFF_FACTOR, voice.RolloffFactor);
+		alSourcef(source, AL_REFERENCE_DISTANCE, voice.ReferenceDistance);
+		alSourcef(source, AL_MAX_DISTANCE, voice.MaxDistance);
+	}
+
+	bool OpenALAudioEngine::Voice::IsStreaming() const
+	{
+		return Clip && Clip->IsStreaming();
+	}
+
+	OpenALAudioEngine::Voice* OpenALAudioEngine::GetVoice(uint32_t sourceID)
+	{
+		return const_cast<Voice*>(static_cast<const OpenALAudioEngine*>(this)->GetVoice(sourceID));
+	}
+
+	const OpenALAudioEngine::Voice* OpenALAudioEngine::GetVoice(uint32_t sourceID) const
+	{
+		uint32_t slot = sourceID & s_SlotMask;
+		if (slot >= m_VoiceSlots.size() || m_VoiceSlots[slot].Generation != (sourceID >> s_SlotBits))
+			return nullptr;
+		return &m_Voices[m_VoiceSlots[slot].Index];
+	}
+
+	void OpenALAudioEngine::MarkDirty(Voice& voice, uint16_t flags)
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		// Virtual voices get all their properties when they become real
+		if (voice.Source == 0)
+			return;
+
+		if (voice.Dirty == 0)
+			m_DirtyVoices.push_back(voice.ID);
+		voice.Dirty |= flags;
+	}
+
+	void OpenALAudioEngine::FlushVoice(Voice& voice)
+	{
+		uint16_t dirty = voice.Dirty;
+		voice.Dirty = 0;
+		if (dirty == 0 || voice.Source == 0)
+			return;
+
+		ALuint source = voice.Source;
+		if (dirty & DirtyPosition)
+			alSource3f(source, AL_POSITION, voice.Position.x, voice.Position.y, voice.Position.z);
+		if (dirty & DirtyVelocity)
+			alSource3f(source, AL_VELOCITY, voice.Velocity.x, voice.Velocity.y, voice.Velocity.z);
+		if (dirty & DirtyGain)
+			alSourcef(source, AL_GAIN, voice.Volume);
+		if (dirty & DirtyPitch)
+			alSourcef(source, AL_PITCH, voice.Pitch);
+		if (dirty & DirtyLooping)
+			alSourcei(source, AL_LOOPING, (voice.Loop && !voice.IsStreaming()) ? AL_TRUE : AL_FALSE);
+		// AL_SOURCE_RELATIVE: true = non-spatial (relative to listener), false = spatial (world position)
+		if (dirty & DirtyRelative)
+			alSourcei(source, AL_SOURCE_RELATIVE, voice.Spatial ? AL_FALSE : AL_TRUE);
+		if (dirty & DirtyRolloff)
+			alSourcef(source, AL_ROLLOFF_FACTOR, voice.RolloffFactor);
+		if (dirty & DirtyReferenceDistance)
+			alSourcef(source, AL_REFERENCE_DISTANCE, voice.ReferenceDistance);
+		if (dirty & DirtyMaxDistance)
+			alSourcef(source, AL_MAX_DISTANCE, voice.MaxDistance);
+	}
+
+	void OpenALAudioEngine::FlushDirtyVoices()
+	{
+		// IDs of destroyed voices fail the lookup, voices already applied have no flags left
+		for (uint32_t sourceID : m_DirtyVoices)
 		{
-			alSourcef(source, AL_REFERENCE_DISTANCE, glm::max(distance, 0.0f));
+			if (Voice* voice = GetVoice(sourceID))
+				FlushVoice(*voice);
 		}
+		m_DirtyVoices.clear();
 	}
 
-	void OpenALAudioEngine::SetSourceMaxDistance(uint32_t sourceID, float distance)
+	void OpenALAudioEngine::ReleaseStream(uint32_t sourceID)
+	{
+		auto it = m_Streams.find(sourceID);
+		if (it == m_Streams.end())
+			return;
+
+		it->second->Release();
+		std::lock_guard<std::mutex> lock(m_StreamMutex);
+		m_Streams.erase(it);
+	}
+
+	OpenALAudioStream* OpenALAudioEngine::GetStream(uint32_t sourceID) const
 	{
-		ALuint source = GetALSource(sourceID);
-		if (source != 0)
+		if (m_Streams.empty())
+			return nullptr;
+
+		auto it = m_Streams.find(sourceID);
+		return it != m_Streams.end() ? it->second.get() : nullptr;
+	}
+
+	void OpenALAudioEngine::StartStreamThread()
+	{
+		m_StreamThreadRunning = true;
+		m_StreamThread = std::thread([this]() { StreamThreadLoop(); });
+	}
+
+	void OpenALAudioEngine::StopStreamThread()
+	{
+		if (!m_StreamThread.joinable())
+			return;
+
 		{
-			alSourcef(source, AL_MAX_DISTANCE, glm::max(distance, 0.0f));
+			std::lock_guard<std::mutex> lock(m_StreamMutex);
+			m_StreamThreadRunning = false;
 		}
+		m_StreamCondition.notify_one();
+		m_StreamThread.join();
 	}
 
-	void OpenALAudioEngine::Update()
+	void OpenALAudioEngine::WakeStreamThread()
 	{
-		// OpenAL handles most updates internally
-		// This can be used for streaming audio or other per-frame updates if needed
+		{
+			std::lock_guard<std::mutex> lock(m_StreamMutex);
+			m_StreamWorkPending = true;
+		}
+		m_StreamCondition.notify_one();
 	}
 
-	ALuint OpenALAudioEngine::GetALSource(uint32_t sourceID) const
+	void OpenALAudioEngine::StreamThreadLoop()
 	{
-		auto it = m_Sources.find(sourceID);
-		if (it != m_Sources.end())
+		std::vector<std::shared_ptr<OpenALAudioStream>> streams;
+
+		while (true)
 		{
-			return it->second;
+			{
+				// Woken by Update() every frame, the timeout keeps streams fed if frames stall
+				std::unique_lock<std::mutex> lock(m_StreamMutex);
+				m_StreamCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() { return !m_StreamThreadRunning || m_StreamWorkPending; });
+				if (!m_StreamThreadRunning)
+					break;
+
+				m_StreamWorkPending = false;
+				for (auto& pair : m_Streams)
+					streams.push_back(pair.second);
+			}
+
+			// Decoded without the map locked so the main thread never waits on a decode
+			for (auto& stream : streams)
+				stream->Decode();
+			streams.clear();
 		}
-		return 0;
 	}
 
 }
@@ -4,9 +4,22 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 #include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace Nebula {
 
+	class OpenALAudioStream;
+
+	// Sources handed out by CreateSource() are voices. Only a fixed pool of them
+	// own a real AL source at a time, Update() gives those to the playing voices
+	// with the best priority and audibility. The rest are virtual: they keep
+	// their playback position but cost nothing to mix.
+	// Voices live in a dense array. Setters only record the change, Update()
+	// sends the changed properties of real voices to OpenAL in one batch.
 	class OpenALAudioEngine : public AudioEngine
 	{
 	public:
@@ -18,6 +31,7 @@ namespace Nebula {
 
 		virtual void SetMasterVolume(float volume) override;
 		virtual float GetMasterVolume() const override { return m_MasterVolume; }
+		virtual uint32_t GetDeviceSampleRate() const override { return m_DeviceSampleRate; }
 
 		virtual void SetListenerPosition(const glm::vec3& position) override;
 		virtual void SetListenerVelocity(const glm::vec3& velocity) override;
@@ -32,13 +46,14 @@ namespace Nebula {
 		virtual void StopAll() override;
 		virtual bool IsSourcePlaying(uint32_t sourceID) const override;
 
-		virtual void SetSourceClip(uint32_t sourceID, AudioClip* clip) override;
+		virtual void SetSourceClip(uint32_t sourceID, const std::shared_ptr<AudioClip>& clip) override;
 		virtual void SetSourcePosition(uint32_t sourceID, const glm::vec3& position) override;
 		virtual void SetSourceVelocity(uint32_t sourceID, const glm::vec3& velocity) override;
 		virtual void SetSourceVolume(uint32_t sourceID, float volume) override;
 		virtual void SetSourcePitch(uint32_t sourceID, float pitch) override;
 		virtual void SetSourceLoop(uint32_t sourceID, bool loop) override;
 		virtual void SetSourceSpatial(uint32_t sourceID, bool spatial) override;
+		virtual void SetSourcePriority(uint32_t sourceID, int priority) override;
 
 		virtual float GetSourceVolume(uint32_t sourceID) const override;
 		virtual float GetSourcePitch(uint32_t sourceID) const override;
@@ -48,18 +63,142 @@ namespace Nebula {
 		virtual void SetSourceReferenceDistance(uint32_t sourceID, float distance) override;
 		virtual void SetSourceMaxDistance(uint32_t sourceID, float distance) override;
 
+		virtual void SetMaxRealVoices(uint32_t count) override;
+		virtual uint32_t GetMaxRealVoices() const override { return m_MaxRealVoices; }
+		virtual uint32_t GetRealVoiceCount() const override { return m_SourcePoolSize - (uint32_t)m_FreeSources.size(); }
+
+		virtual void SetAudibilityThreshold(float gain) override { m_AudibilityThreshold = glm::max(gain, 0.0f); }
+		virtual float GetAudibilityThreshold() const override { return m_AudibilityThreshold; }
+
+		virtual void SetStatePollInterval(float seconds) override { m_StatePollInterval = glm::max(seconds, 0.0f); }
+		virtual float GetStatePollInterval() const override { return m_StatePollInterval; }
+
 		virtual void Update() override;
 
-	private:
-		ALuint GetALSource(uint32_t sourceID) const;
+	protected:
+		// Creates m_Device and m_Context, Init() does the rest
+		virtual bool OpenDevice();
+		// Voices waiting on a clip that just arrived shouldn't wait for the next poll as well
+		virtual void OnClipsUploaded() override { m_StatePollTimer = m_StatePollInterval; }
 
-	private:
 		ALCdevice* m_Device = nullptr;
 		ALCcontext* m_Context = nullptr;
-		float m_MasterVolume = 1.0f;
 
-		std::unordered_map<uint32_t, ALuint> m_Sources;
-		uint32_t m_NextSourceID = 1;
+	private:
+		enum class VoiceState : uint8_t
+		{
+			Stopped = 0,
+			Playing,
+			Paused
+		};
+
+		// Properties changed since the last flush
+		enum VoiceDirtyFlags : uint16_t
+		{
+			DirtyPosition          = 1 << 0,
+			DirtyVelocity          = 1 << 1,
+			DirtyGain              = 1 << 2,
+			DirtyPitch             = 1 << 3,
+			DirtyLooping           = 1 << 4,
+			DirtyRelative          = 1 << 5,
+			DirtyRolloff           = 1 << 6,
+			DirtyReferenceDistance = 1 << 7,
+			DirtyMaxDistance       = 1 << 8
+		};
+
+		struct Voice
+		{
+			uint32_t ID = 0;
+			std::shared_ptr<AudioClip> Clip;
+			ALuint Source = 0; // Real AL source, 0 while virtual
+
+			glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+			glm::vec3 Velocity = { 0.0f, 0.0f, 0.0f };
+			float Volume = 1.0f;
+			float Pitch = 1.0f;
+			float RolloffFactor = 1.0f;
+			float ReferenceDistance = 1.0f;
+			float MaxDistance = 100.0f;
+			bool Loop = false;
+			bool Spatial = true;
+			int Priority = 128;
+
+			VoiceState State = VoiceState::Stopped;
+			float Time = 0.0f; // Playback position in seconds, only kept up to date while virtual
+			float Audibility = 0.0f;
+			uint16_t Dirty = 0;
+
+			bool IsStreaming() const;
+		};
+
+		Voice* GetVoice(uint32_t sourceID);
+		const Voice* GetVoice(uint32_t sourceID) const;
+		void MarkDirty(Voice& voice, uint16_t flags);
+		void FlushVoice(Voice& voice);
+		void FlushDirtyVoices();
+		OpenALAudioStream* GetStream(uint32_t sourceID) const;
+
+		// Real voice management. Streams are virtualized like any other voice, their
+		// stream is detached with the decoder left open and seeks back to Time when
+		// the voice is real again. The stream is only released once the voice stops.
+		bool AcquireRealVoice(uint32_t sourceID, Voice& voice);
+		void ReleaseRealVoice(uint32_t sourceID, Voice& voice);
+		void ReleaseStream(uint32_t sourceID);
+		void ApplyVoice(Voice& voice);
+		float ComputeAudibility(const Voice& voice) const;
+		void AssignRealVoices(float deltaTime);
+
+		void StartStreamThread();
+		void StopStreamThread();
+		void WakeStreamThread();
+		void StreamThreadLoop();
+
+	private:
+		float m_MasterVolume = 1.0f;
+		uint32_t m_DeviceSampleRate = 0;
+		glm::vec3 m_ListenerPosition = { 0.0f, 0.0f, 0.0f };
+
+		// Source IDs are a slot index plus a generation, so a stale ID never
+		// reaches the voice that reused its slot
+		static constexpr uint32_t s_SlotBits = 20;
+		static constexpr uint32_t s_SlotMask = (1u << s_SlotBits) - 1;
+		struct VoiceSlot
+		{
+			uint32_t Index = 0; // Into m_Voices
+			uint32_t Generation = 1;
+		};
+		std::vector<Voice> m_Voices;
+		std::vector<VoiceSlot> m_VoiceSlots;
+		std::vector<uint32_t> m_FreeSlots;
+		std::vector<uint32_t> m_DirtyVoices; // IDs of real voices with Dirty set
+
+		// Real AL sources, created on demand up to m_MaxRealVoices
+		std::vector<ALuint> m_FreeSources;
+		uint32_t m_SourcePoolSize = 0;
+		uint32_t m_MaxRealVoices = 32;
+		float m_AudibilityThreshold = 0.001f; // -60 dB
+		static constexpr float s_MaxDistanceHysteresis = 1.1f; // Real voices are culled this far past MaxDistance
+
+		struct VoiceRank
+		{
+			uint32_t SourceID;
+			int Priority;
+			float Audibility;
+		};
+		std::vector<VoiceRank> m_VoiceRanks; // Reused every frame
+		std::chrono::steady_clock::time_point m_LastUpdateTime;
+		bool m_HasUpdated = false;
+		float m_StatePollInterval = 0.05f;
+		float m_StatePollTimer = 0.0f;
+
+		// Voices playing a streaming clip, real or virtual. Only the main thread modifies
+		// the map, the stream thread reads it under m_StreamMutex
+		std::unordered_map<uint32_t, std::shared_ptr<OpenALAudioStream>> m_Streams;
+		std::thread m_StreamThread;
+		std::mutex m_StreamMutex;
+		std::condition_variable m_StreamCondition;
+		bool m_StreamThreadRunning = false;
+		bool m_StreamWorkPending = false;
 	};
 
 }
@@ -0,0 +1,307 @@
+#include "nbpch.h"
+#include "OpenALAudioStream.h"
+#include "Nebula/Log.h"
+
+namespace Nebula {
+
+	OpenALAudioStream::OpenALAudioStream(std::shared_ptr<const OpenALStreamingAudioClip> clip)
+		: m_Clip(std::move(clip))
+	{
+		m_SampleRate = m_Clip->GetSampleRate();
+		m_Channels = m_Clip->GetChannels();
+		m_Format = (m_Channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+		m_ChunkFrames = std::max<uint64_t>((uint64_t)(m_SampleRate * ChunkSeconds), 1);
+
+		for (Chunk& chunk : m_Chunks)
+			alGenBuffers(1, &chunk.Buffer);
+	}
+
+	void OpenALAudioStream::Attach(ALuint source)
+	{
+		if (m_Released || m_Source != 0)
+			return;
+
+		m_Source = source;
+
+		std::lock_guard<std::mutex> lock(m_DecoderMutex);
+		for (Chunk& chunk : m_Chunks)
+			chunk.Samples.resize((size_t)m_ChunkFrames * m_Channels);
+		m_Attached = true;
+	}
+
+	void OpenALAudioStream::Detach()
+	{
+		if (m_Source == 0)
+			return;
+
+		m_Playing = false;
+		Rewind(0);
+
+		// The decoder stays open, the seek waits until the stream is attached again
+		std::lock_guard<std::mutex> lock(m_DecoderMutex);
+		m_Attached = false;
+		for (Chunk& chunk : m_Chunks)
+		{
+			chunk.Samples.clear();
+			chunk.Samples.shrink_to_fit();
+		}
+		m_Source = 0;
+	}
+
+	void OpenALAudioStream::Play()
+	{
+		if (m_OpenFailed || m_Released || m_Source == 0)
+			return;
+
+		m_Playing = true;
+
+		// Don't wait a frame for the stream thread if the first chunk is cheap to decode right here.
+		// Opening and seeking are left to the stream thread, and so is a chunk it's busy with.
+		{
+			std::unique_lock<std::mutex> lock(m_DecoderMutex, std::try_to_lock);
+			if (lock.owns_lock() && m_Decoder && !m_SeekPending)
+				DecodeNext();
+		}
+		Update();
+	}
+
+	void OpenALAudioStream::Stop()
+	{
+		m_Playing = false;
+		Rewind(0);
+	}
+
+	void OpenALAudioStream::Seek(uint64_t frame)
+	{
+		m_Playing = false;
+		Rewind(frame);
+	}
+
+	uint64_t OpenALAudioStream::GetPlaybackFrame() const
+	{
+		if (m_Source == 0)
+		{
+			std::lock_guard<std::mutex> lock(m_DecoderMutex);
+			return m_DecodeFrame;
+		}
+
+		// Offsets count from the first buffer still in the queue, processed ones included
+		ALint offset = 0;
+		alGetSourcei(m_Source, AL_SAMPLE_OFFSET, &offset);
+
+		uint64_t remaining = (uint64_t)std::max(offset, 0);
+		for (uint32_t i = 0, index = m_PlayIndex; i < ChunkCount; i++, index = (index + 1) % ChunkCount)
+		{
+			const Chunk& chunk = m_Chunks[index];
+			if (chunk.State != ChunkState::Queued)
+				break;
+
+			uint64_t frames = chunk.SampleCount / m_Channels;
+			if (remaining < frames)
+				return remaining < chunk.WrapFrame ? chunk.StartFrame + remaining : remaining - chunk.WrapFrame;
+			remaining -= frames;
+		}
+
+		// Nothing queued yet, the next chunk to play has the position
+		const Chunk& next = m_Chunks[m_QueueIndex];
+		if (next.State == ChunkState::Decoded)
+			return next.StartFrame;
+
+		std::lock_guard<std::mutex> lock(m_DecoderMutex);
+		return m_DecodeFrame;
+	}
+
+	void OpenALAudioStream::Update()
+	{
+		if (m_Released || m_Source == 0)
+			return;
+
+		// Hand played buffers back to the stream thread, they come out in queue order
+		ALint processed = 0;
+		alGetSourcei(m_Source, AL_BUFFERS_PROCESSED, &processed);
+		while (processed-- > 0)
+		{
+			ALuint buffer;
+			alSourceUnqueueBuffers(m_Source, 1, &buffer);
+			for (uint32_t i = 0; i < ChunkCount; i++)
+			{
+				if (m_Chunks[i].Buffer == buffer)
+				{
+					m_Chunks[i].State = ChunkState::Free;
+					m_PlayIndex = (i + 1) % ChunkCount;
+					break;
+				}
+			}
+		}
+
+		while (m_Chunks[m_QueueIndex].State == ChunkState::Decoded)
+		{
+			Chunk& chunk = m_Chunks[m_QueueIndex];
+			alBufferData(chunk.Buffer, m_Format, chunk.Samples.data(), (ALsizei)(chunk.SampleCount * sizeof(int16_t)), m_SampleRate);
+			alSourceQueueBuffers(m_Source, 1, &chunk.Buffer);
+			chunk.State = ChunkState::Queued;
+			m_QueueIndex = (m_QueueIndex + 1) % ChunkCount;
+		}
+
+		if (!m_Playing)
+			return;
+
+		ALint state;
+		alGetSourcei(m_Source, AL_SOURCE_STATE, &state);
+		if (state == AL_PLAYING || state == AL_PAUSED)
+			return;
+
+		ALint queued = 0;
+		alGetSourcei(m_Source, AL_BUFFERS_QUEUED, &queued);
+		if (queued > 0)
+		{
+			// First start, or the decoder fell behind and the source ran dry
+			alSourcePlay(m_Source);
+		}
+		else if (m_EndOfStream)
+		{
+			// Played to the end, or the file couldn't be opened. The next Play() starts from the top.
+			m_Playing = false;
+			Rewind(0);
+		}
+	}
+
+	void OpenALAudioStream::Release()
+	{
+		if (m_Released)
+			return;
+
+		m_Released = true;
+		m_Playing = false;
+
+		if (m_Source != 0)
+		{
+			alSourceStop(m_Source);
+			alSourcei(m_Source, AL_BUFFER, 0);
+			m_Source = 0;
+		}
+
+		// Waits for a decode in progress on the stream thread
+		std::lock_guard<std::mutex> lock(m_DecoderMutex);
+		m_Attached = false;
+		for (Chunk& chunk : m_Chunks)
+		{
+			if (chunk.Buffer != 0)
+				alDeleteBuffers(1, &chunk.Buffer);
+			chunk.Buffer = 0;
+			chunk.Samples.clear();
+			chunk.Samples.shrink_to_fit();
+		}
+	}
+
+	bool OpenALAudioStream::Decode()
+	{
+		if (!m_Attached || m_Released)
+			return false;
+
+		// Opened here rather than on the main thread, it may read a whole packed file.
+		// Only this thread assigns m_Decoder, so it can be checked without the lock.
+		if (!m_Decoder && !m_OpenFailed)
+		{
+			std::unique_ptr<AudioStreamDecoder> decoder = m_Clip->OpenDecoder();
+			std::lock_guard<std::mutex> lock(m_DecoderMutex);
+			if (decoder)
+			{
+				m_Decoder = std::move(decoder);
+			}
+			else
+			{
+				m_OpenFailed = true;
+				m_EndOfStream = true;
+			}
+		}
+
+		bool decoded = false;
+		while (!m_Released && !m_EndOfStream)
+		{
+			// Locked per chunk so Stop() never waits for more than one
+			std::lock_guard<std::mutex> lock(m_DecoderMutex);
+			if (!DecodeNext())
+				break;
+			decoded = true;
+		}
+		return decoded;
+	}
+
+	bool OpenALAudioStream::DecodeNext()
+	{
+		if (!m_Decoder || !m_Attached || m_Released || m_EndOfStream)
+			return false;
+
+		Chunk& chunk = m_Chunks[m_DecodeIndex];
+		if (chunk.State != ChunkState::Free)
+			return false;
+
+		if (m_SeekPending)
+		{
+			m_SeekPending = false;
+			if (m_DecodeFrame != 0 && !m_Decoder->SeekToFrame(m_DecodeFrame))
+				m_DecodeFrame = 0;
+			if (m_DecodeFrame == 0)
+				m_Decoder->SeekToFrame(0);
+		}
+
+		uint64_t frames = 0;
+		uint64_t wrapFrame = ~0ull;
+		bool wrapped = false;
+		chunk.StartFrame = m_DecodeFrame;
+		while (frames < m_ChunkFrames)
+		{
+			uint64_t read = m_Decoder->Read(chunk.Samples.data() + frames * m_Channels, m_ChunkFrames - frames);
+			frames += read;
+			m_DecodeFrame += read;
+			if (frames == m_ChunkFrames)
+				break;
+			if (read > 0)
+				wrapped = false;
+
+			// End of the file, wrap around or finish. Nothing read right after wrapping means there is no audio
+			if (!m_Looping || wrapped || !m_Decoder->SeekToFrame(0))
+			{
+				m_EndOfStream = true;
+				break;
+			}
+			wrapped = true;
+			m_DecodeFrame = 0;
+			wrapFrame = std::min(wrapFrame, frames);
+		}
+
+		if (frames == 0)
+			return false;
+
+		chunk.WrapFrame = std::min(wrapFrame, frames);
+		chunk.SampleCount = (size_t)frames * m_Channels;
+		chunk.State = ChunkState::Decoded;
+		m_DecodeIndex = (m_DecodeIndex + 1) % ChunkCount;
+		return true;
+	}
+
+	void OpenALAudioStream::Rewind(uint64_t frame)
+	{
+		// Unqueues everything, only valid on a stopped source
+		if (m_Source != 0)
+		{
+			alSourceStop(m_Source);
+			alSourcei(m_Source, AL_BUFFER, 0);
+		}
+
+		// The seek itself waits for the stream thread, it can be slow
+		std::lock_guard<std::mutex> lock(m_DecoderMutex);
+		m_SeekPending = true;
+
+		for (Chunk& chunk : m_Chunks)
+			chunk.State = ChunkState::Free;
+
+		m_DecodeIndex = 0;
+		m_DecodeFrame = frame;
+		m_QueueIndex = 0;
+		m_PlayIndex = 0;
+		m_EndOfStream = false;
+	}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "OpenALStreamingAudioClip.h"
+#include <AL/al.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Nebula {
+
+	// Playback of a streaming clip on one source. The engine's stream thread decodes
+	// into free chunks of a small ring, Update() on the main thread uploads decoded
+	// chunks into their AL buffers and queues them on the source in ring order.
+	// Looping is done by the decoder, the source itself never loops. The stream
+	// outlives its source: a virtualized voice detaches it and keeps the decoder
+	// open, and Seek() back to the voice's position when it's real again. Opening
+	// the decoder and seeking both happen on the stream thread.
+	class OpenALAudioStream
+	{
+	public:
+		static constexpr uint32_t ChunkCount = 4;
+		static constexpr float ChunkSeconds = 0.25f;
+
+		OpenALAudioStream(std::shared_ptr<const OpenALStreamingAudioClip> clip);
+		~OpenALAudioStream() = default;
+
+		// False once the stream thread failed to open the file
+		bool IsValid() const { return !m_OpenFailed; }
+
+		// Main thread
+		void Attach(ALuint source);
+		// Stops and gives the source back. The decoder stays open, chunk memory is freed.
+		void Detach();
+		bool IsAttached() const { return m_Source != 0; }
+		void Play();
+		void Stop();
+		// Stops and continues from this frame on the next Play(), the start if it's past the end
+		void Seek(uint64_t frame);
+		void Update();
+		// Frame of the file that is being heard right now
+		uint64_t GetPlaybackFrame() const;
+		// Detaches and deletes the AL buffers, call before the source is deleted. The stream
+		// thread may hold the last reference, so the destructor never touches OpenAL
+		void Release();
+
+		void SetLooping(bool loop) { m_Looping = loop; }
+		bool IsLooping() const { return m_Looping; }
+		bool IsPlaying() const { return m_Playing; }
+
+		// Stream thread. Opens the decoder the first time, then fills every free chunk.
+		// Returns true if anything was decoded.
+		bool Decode();
+
+	private:
+		enum class ChunkState : uint8_t
+		{
+			Free = 0,
+			Decoded,
+			Queued
+		};
+
+		struct Chunk
+		{
+			std::vector<int16_t> Samples;
+			size_t SampleCount = 0;
+			uint64_t StartFrame = 0; // File position of the first frame
+			uint64_t WrapFrame = 0;  // Frames before the decoder looped back to the start, all of them if it didn't
+			ALuint Buffer = 0;
+			std::atomic<ChunkState> State = ChunkState::Free;
+		};
+
+		// Caller holds m_DecoderMutex
+		bool DecodeNext();
+		// Unqueues everything and frees the chunks, the decoder goes back to frame
+		void Rewind(uint64_t frame);
+
+	private:
+		std::shared_ptr<const OpenALStreamingAudioClip> m_Clip;
+		ALuint m_Source = 0; // 0 while detached
+		ALenum m_Format = 0;
+		int m_SampleRate = 0;
+		int m_Channels = 0;
+		uint64_t m_ChunkFrames = 0;
+
+		std::unique_ptr<AudioStreamDecoder> m_Decoder;
+		mutable std::mutex m_DecoderMutex;
+		std::array<Chunk, ChunkCount> m_Chunks;
+		uint32_t m_DecodeIndex = 0; // Next chunk to decode, guarded by m_DecoderMutex
+		uint64_t m_DecodeFrame = 0; // Decoder position, guarded by m_DecoderMutex
+		bool m_SeekPending = false; // Decoder still has to seek to m_DecodeFrame, guarded by m_DecoderMutex
+		std::atomic<bool> m_Attached = false;
+		uint32_t m_QueueIndex = 0;  // Next chunk to queue, main thread only
+		uint32_t m_PlayIndex = 0;   // Oldest queued chunk, main thread only
+
+		std::atomic<bool> m_Looping = false;
+		std::atomic<bool> m_EndOfStream = false;
+		std::atomic<bool> m_Released = false;
+		std::atomic<bool> m_OpenFailed = false;
+		bool m_Playing = false;
+	};
+
+}
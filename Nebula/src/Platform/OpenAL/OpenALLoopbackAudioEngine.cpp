@@ -0,0 +1,108 @@
+#include "nbpch.h"
+#include "OpenALLoopbackAudioEngine.h"
+#include "Nebula/Log.h"
+
+namespace Nebula {
+
+	OpenALLoopbackAudioEngine::OpenALLoopbackAudioEngine(uint32_t sampleRate, bool renderOnUpdate)
+		: m_SampleRate(sampleRate), m_RenderOnUpdate(renderOnUpdate)
+	{
+	}
+
+	bool OpenALLoopbackAudioEngine::OpenDevice()
+	{
+		if (!alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback"))
+		{
+			NB_CORE_ERROR("OpenAL loopback devices are not supported (ALC_SOFT_loopback)");
+			return false;
+		}
+
+		auto loopbackOpenDevice = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+		auto isRenderFormatSupported = reinterpret_cast<LPALCISRENDERFORMATSUPPORTEDSOFT>(alcGetProcAddress(nullptr, "alcIsRenderFormatSupportedSOFT"));
+		m_RenderSamples = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+		if (!loopbackOpenDevice || !isRenderFormatSupported || !m_RenderSamples)
+		{
+			NB_CORE_ERROR("Failed to load the OpenAL loopback functions");
+			return false;
+		}
+
+		m_Device = loopbackOpenDevice(nullptr);
+		if (!m_Device)
+		{
+			NB_CORE_ERROR("Failed to open OpenAL loopback device");
+			return false;
+		}
+
+		if (!isRenderFormatSupported(m_Device, (ALCsizei)m_SampleRate, ALC_STEREO_SOFT, ALC_SHORT_SOFT))
+		{
+			NB_CORE_ERROR("OpenAL loopback device can't render 16-bit stereo at {0} Hz", m_SampleRate);
+			alcCloseDevice(m_Device);
+			m_Device = nullptr;
+			return false;
+		}
+
+		// The render format has to be given when the context is created
+		ALCint attributes[] = {
+			ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+			ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+			ALC_FREQUENCY, (ALCint)m_SampleRate,
+			0
+		};
+		m_Context = alcCreateContext(m_Device, attributes);
+		if (!m_Context)
+		{
+			NB_CORE_ERROR("Failed to create OpenAL loopback context");
+			alcCloseDevice(m_Device);
+			m_Device = nullptr;
+			return false;
+		}
+
+		NB_CORE_INFO("OpenAL loopback device: 16-bit stereo at {0} Hz", m_SampleRate);
+		return true;
+	}
+
+	bool OpenALLoopbackAudioEngine::Render(int16_t* samples, uint32_t frameCount)
+	{
+		if (!m_Device || !m_Context || !m_RenderSamples)
+			return false;
+
+		m_RenderSamples(m_Device, samples, (ALCsizei)frameCount);
+		return true;
+	}
+
+	void OpenALLoopbackAudioEngine::Update()
+	{
+		OpenALAudioEngine::Update();
+
+		if (!m_RenderOnUpdate || !m_Context)
+			return;
+
+		auto now = std::chrono::steady_clock::now();
+		if (!m_HasRendered)
+		{
+			m_LastRenderTime = now;
+			m_HasRendered = true;
+			return;
+		}
+
+		// After a long stall the mix skips ahead instead of rendering seconds of audio in one frame
+		float elapsed = std::chrono::duration<float>(now - m_LastRenderTime).count();
+		if (elapsed > 0.25f)
+		{
+			elapsed = 0.25f;
+			m_LastRenderTime = now - std::chrono::milliseconds(250);
+		}
+
+		uint32_t frameCount = (uint32_t)(elapsed * m_SampleRate);
+		if (frameCount == 0)
+			return;
+
+		// Only whole frames are consumed, the remainder carries over to the next update
+		m_LastRenderTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>((double)frameCount / m_SampleRate));
+
+		m_DiscardBuffer.resize((size_t)frameCount * 2);
+		Render(m_DiscardBuffer.data(), frameCount);
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "OpenALAudioEngine.h"
+#include <AL/alext.h>
+#include <vector>
+#include <chrono>
+
+namespace Nebula {
+
+	// OpenAL engine on an ALC_SOFT_loopback device. Nothing is played, the mix
+	// is pulled into memory with Render(), so it works on machines without a
+	// sound card (CI, dedicated servers).
+	class OpenALLoopbackAudioEngine : public OpenALAudioEngine
+	{
+	public:
+		OpenALLoopbackAudioEngine(uint32_t sampleRate, bool renderOnUpdate);
+
+		virtual bool IsHeadless() const override { return true; }
+		virtual bool Render(int16_t* samples, uint32_t frameCount) override;
+
+		virtual void Update() override;
+
+	protected:
+		virtual bool OpenDevice() override;
+
+	private:
+		uint32_t m_SampleRate;
+		LPALCRENDERSAMPLESSOFT m_RenderSamples = nullptr;
+
+		// Mixes the elapsed time on every Update() so playback advances without a Render() caller
+		bool m_RenderOnUpdate;
+		std::vector<int16_t> m_DiscardBuffer;
+		std::chrono::steady_clock::time_point m_LastRenderTime;
+		bool m_HasRendered = false;
+	};
+
+}
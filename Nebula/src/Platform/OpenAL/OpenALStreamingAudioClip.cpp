@@ -0,0 +1,347 @@
+#include "nbpch.h"
+#include "OpenALStreamingAudioClip.h"
+#include "Nebula/Audio/PCMConversion.h"
+#include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+// Implementation lives in OpenALAudioClip.cpp
+#include "dr_libs/dr_mp3.h"
+
+namespace Nebula {
+
+	struct StreamInfo
+	{
+		int SampleRate = 0;
+		int Channels = 0;
+		uint64_t FrameCount = 0;
+	};
+
+	struct MP3SeekTable
+	{
+		std::vector<drmp3_seek_point> Points;
+	};
+
+	class MP3StreamDecoder : public AudioStreamDecoder
+	{
+	public:
+		~MP3StreamDecoder()
+		{
+			if (m_Open)
+				drmp3_uninit(&m_MP3);
+		}
+
+		bool Open(const std::string& filepath, StreamInfo* info)
+		{
+			// Packed files are read from the mapping (packs store audio uncompressed), loose ones stream from disk
+			if (VirtualFileSystem::IsPacked(filepath))
+			{
+				m_Packed = VirtualFileSystem::ReadFile(filepath);
+				m_Open = m_Packed && drmp3_init_memory(&m_MP3, m_Packed.GetData(), m_Packed.GetSize(), nullptr);
+			}
+			else
+			{
+				m_Open = drmp3_init_file(&m_MP3, filepath.c_str(), nullptr);
+			}
+			if (!m_Open)
+				return false;
+
+			if (info)
+			{
+				info->SampleRate = (int)m_MP3.sampleRate;
+				info->Channels = (int)m_MP3.channels;
+				// Walks the frame headers without decoding, then seeks back to the start
+				info->FrameCount = drmp3_get_pcm_frame_count(&m_MP3);
+			}
+			return true;
+		}
+
+		// Walks the whole file like the frame count does, one seek point every SeekPointSeconds
+		std::shared_ptr<const MP3SeekTable> CreateSeekTable(uint64_t frameCount)
+		{
+			constexpr uint64_t SeekPointSeconds = 1;
+			auto table = std::make_shared<MP3SeekTable>();
+			drmp3_uint32 count = (drmp3_uint32)std::min<uint64_t>(frameCount / std::max<uint64_t>(m_MP3.sampleRate * SeekPointSeconds, 1) + 1, 0xFFFF);
+			table->Points.resize(count);
+			if (!drmp3_calculate_seek_points(&m_MP3, &count, table->Points.data()) || count == 0)
+				return nullptr;
+			table->Points.resize(count);
+			return table;
+		}
+
+		// The table has to outlive the decoder, so it holds a reference
+		void BindSeekTable(std::shared_ptr<const MP3SeekTable> table)
+		{
+			if (!table)
+				return;
+			m_SeekTable = std::move(table);
+			drmp3_bind_seek_table(&m_MP3, (drmp3_uint32)m_SeekTable->Points.size(), const_cast<drmp3_seek_point*>(m_SeekTable->Points.data()));
+		}
+
+		virtual uint64_t Read(int16_t* samples, uint64_t frameCount) override
+		{
+			return drmp3_read_pcm_frames_s16(&m_MP3, frameCount, samples);
+		}
+
+		virtual bool SeekToFrame(uint64_t frame) override
+		{
+			return drmp3_seek_to_pcm_frame(&m_MP3, frame);
+		}
+
+	private:
+		VirtualFile m_Packed;
+		drmp3 m_MP3;
+		std::shared_ptr<const MP3SeekTable> m_SeekTable;
+		bool m_Open = false;
+	};
+
+	class WAVStreamDecoder : public AudioStreamDecoder
+	{
+	public:
+		bool Open(const std::string& filepath, StreamInfo* info)
+		{
+			if (VirtualFileSystem::IsPacked(filepath))
+				m_File = std::make_unique<VirtualFileStream>(VirtualFileSystem::ReadFile(filepath));
+			else
+				m_File = std::make_unique<std::ifstream>(filepath, std::ios::binary);
+			if (!*m_File)
+				return false;
+
+			char riff[4], wave[4];
+			uint32_t chunkSize;
+			m_File->read(riff, 4);
+			m_File->read(reinterpret_cast<char*>(&chunkSize), 4);
+			m_File->read(wave, 4);
+			if (std::strncmp(riff, "RIFF", 4) != 0 || std::strncmp(wave, "WAVE", 4) != 0)
+				return false;
+
+			// Walk the chunks, fmt has to come before data
+			bool foundFormat = false;
+			char header[4];
+			uint32_t size = 0;
+			while (m_File->read(header, 4) && m_File->read(reinterpret_cast<char*>(&size), 4))
+			{
+				if (std::strncmp(header, "fmt ", 4) == 0)
+				{
+					uint32_t byteRate;
+					m_File->read(reinterpret_cast<char*>(&m_AudioFormat), 2);
+					m_File->read(reinterpret_cast<char*>(&m_Channels), 2);
+					m_File->read(reinterpret_cast<char*>(&m_SampleRate), 4);
+					m_File->read(reinterpret_cast<char*>(&byteRate), 4);
+					m_File->read(reinterpret_cast<char*>(&m_BlockAlign), 2);
+					m_File->read(reinterpret_cast<char*>(&m_BitsPerSample), 2);
+					if (size > 16)
+						m_File->seekg(size - 16, std::ios::cur);
+					foundFormat = true;
+				}
+				else if (std::strncmp(header, "data", 4) == 0)
+				{
+					m_DataOffset = m_File->tellg();
+					m_DataSize = size;
+
+					// Size unknown or corrupted, play until the end of the file
+					if (m_DataSize == 0 || m_DataSize == 0xFFFFFFFF)
+					{
+						m_File->seekg(0, std::ios::end);
+						m_DataSize = (uint64_t)(m_File->tellg() - m_DataOffset);
+						m_File->seekg(m_DataOffset);
+					}
+					break;
+				}
+				else
+				{
+					m_File->seekg(size, std::ios::cur);
+				}
+			}
+
+			if (!foundFormat || m_DataSize == 0 || m_BlockAlign == 0)
+				return false;
+
+			bool pcm = m_AudioFormat == 1 && (m_BitsPerSample == 8 || m_BitsPerSample == 16);
+			bool float32 = m_AudioFormat == 3 && m_BitsPerSample == 32;
+			if (!pcm && !float32)
+			{
+				NB_CORE_WARN("WAV format can't be streamed ({0} bits, format {1}): {2}", m_BitsPerSample, m_AudioFormat, filepath);
+				return false;
+			}
+
+			if (info)
+			{
+				info->SampleRate = (int)m_SampleRate;
+				info->Channels = (int)m_Channels;
+				info->FrameCount = m_DataSize / m_BlockAlign;
+			}
+			return true;
+		}
+
+		virtual uint64_t Read(int16_t* samples, uint64_t frameCount) override
+		{
+			uint64_t remaining = (m_DataSize - m_Position) / m_BlockAlign;
+			frameCount = std::min(frameCount, remaining);
+			if (frameCount == 0)
+				return 0;
+
+			size_t sampleCount = (size_t)frameCount * m_Channels;
+			if (m_AudioFormat == 1 && m_BitsPerSample == 16)
+			{
+				m_File->read(reinterpret_cast<char*>(samples), sampleCount * sizeof(int16_t));
+			}
+			else if (m_AudioFormat == 1)
+			{
+				// Unsigned 8-bit to 16-bit PCM
+				m_ByteScratch.resize(sampleCount);
+				m_File->read(reinterpret_cast<char*>(m_ByteScratch.data()), sampleCount);
+				PCMConversion::UInt8ToInt16(m_ByteScratch.data(), samples, sampleCount);
+			}
+			else
+			{
+				// 32-bit float to 16-bit PCM
+				m_FloatScratch.resize(sampleCount);
+				m_File->read(reinterpret_cast<char*>(m_FloatScratch.data()), sampleCount * sizeof(float));
+				PCMConversion::FloatToInt16(m_FloatScratch.data(), samples, sampleCount);
+			}
+
+			uint64_t framesRead = (uint64_t)m_File->gcount() / m_BlockAlign;
+			m_Position += framesRead * m_BlockAlign;
+			return framesRead;
+		}
+
+		virtual bool SeekToFrame(uint64_t frame) override
+		{
+			m_Position = std::min<uint64_t>(frame * m_BlockAlign, m_DataSize);
+			m_File->clear();
+			m_File->seekg(m_DataOffset + (std::streamoff)m_Position);
+			return !m_File->fail();
+		}
+
+	private:
+		std::unique_ptr<std::istream> m_File;
+		std::streampos m_DataOffset = 0;
+		uint64_t m_DataSize = 0;
+		uint64_t m_Position = 0;
+
+		uint16_t m_AudioFormat = 0;
+		uint16_t m_Channels = 0;
+		uint32_t m_SampleRate = 0;
+		uint16_t m_BlockAlign = 0;
+		uint16_t m_BitsPerSample = 0;
+
+		std::vector<float> m_FloatScratch;
+		std::vector<uint8_t> m_ByteScratch;
+	};
+
+	// Reads stereo from another decoder and hands out mono
+	class DownmixStreamDecoder : public AudioStreamDecoder
+	{
+	public:
+		DownmixStreamDecoder(std::unique_ptr<AudioStreamDecoder> decoder)
+			: m_Decoder(std::move(decoder))
+		{
+		}
+
+		virtual uint64_t Read(int16_t* samples, uint64_t frameCount) override
+		{
+			m_StereoScratch.resize((size_t)frameCount * 2);
+			uint64_t framesRead = m_Decoder->Read(m_StereoScratch.data(), frameCount);
+			PCMConversion::DownmixStereoToMono(m_StereoScratch.data(), samples, (size_t)framesRead);
+			return framesRead;
+		}
+
+		virtual bool SeekToFrame(uint64_t frame) override
+		{
+			return m_Decoder->SeekToFrame(frame);
+		}
+
+	private:
+		std::unique_ptr<AudioStreamDecoder> m_Decoder;
+		std::vector<int16_t> m_StereoScratch;
+	};
+
+	// Compares the file's extension only, ignoring case, so "music.wav.bak" or a ".mp3" directory don't match
+	static bool HasExtension(const std::string& filepath, const char* extension)
+	{
+		std::string fileExtension = std::filesystem::path(filepath).extension().string();
+		std::transform(fileExtension.begin(), fileExtension.end(), fileExtension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return fileExtension == extension;
+	}
+
+	OpenALStreamingAudioClip::OpenALStreamingAudioClip(const std::string& filepath, const AudioClipImportOptions& options)
+		: m_FilePath(filepath), m_Downmix(options.Mono)
+	{
+		m_Format = HasExtension(filepath, ".wav") ? Format::WAV : Format::MP3;
+	}
+
+	void OpenALStreamingAudioClip::Decode()
+	{
+		// Only the format is read here, counting MP3 frames and building the seek table still walk the whole file
+		const std::string& filepath = m_FilePath;
+		StreamInfo info;
+		bool opened = false;
+		if (m_Format == Format::MP3)
+		{
+			auto mp3 = std::make_unique<MP3StreamDecoder>();
+			opened = mp3->Open(filepath, &info);
+			if (opened)
+				m_SeekTable = mp3->CreateSeekTable(info.FrameCount);
+		}
+		else
+			opened = std::make_unique<WAVStreamDecoder>()->Open(filepath, &info);
+
+		if (!opened || info.SampleRate == 0 || (info.Channels != 1 && info.Channels != 2))
+		{
+			NB_CORE_WARN("Audio file can't be streamed: {0}", filepath);
+			return;
+		}
+
+		m_SampleRate = info.SampleRate;
+		m_Downmix = m_Downmix && info.Channels == 2;
+		m_Channels = m_Downmix ? 1 : info.Channels;
+		m_Duration = static_cast<float>(info.FrameCount) / static_cast<float>(info.SampleRate);
+		m_Valid = true;
+
+		NB_CORE_INFO("Streaming audio: {0} ({1} channels, {2} Hz, {3:.2f}s)", filepath, m_Channels, m_SampleRate, m_Duration);
+	}
+
+	std::unique_ptr<AudioStreamDecoder> OpenALStreamingAudioClip::OpenDecoder() const
+	{
+		if (!m_Valid)
+			return nullptr;
+
+		std::unique_ptr<AudioStreamDecoder> decoder;
+		if (m_Format == Format::MP3)
+		{
+			auto mp3 = std::make_unique<MP3StreamDecoder>();
+			if (mp3->Open(m_FilePath, nullptr))
+			{
+				mp3->BindSeekTable(m_SeekTable);
+				decoder = std::move(mp3);
+			}
+		}
+		else
+		{
+			auto wav = std::make_unique<WAVStreamDecoder>();
+			if (wav->Open(m_FilePath, nullptr))
+				decoder = std::move(wav);
+		}
+
+		if (!decoder)
+		{
+			NB_CORE_ERROR("Failed to open audio stream: {0}", m_FilePath);
+			return nullptr;
+		}
+
+		if (m_Downmix)
+			return std::make_unique<DownmixStreamDecoder>(std::move(decoder));
+		return decoder;
+	}
+
+	bool OpenALStreamingAudioClip::IsSupported(const std::string& filepath)
+	{
+		return HasExtension(filepath, ".mp3") || HasExtension(filepath, ".wav");
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Nebula/Audio/AudioClip.h"
+#include <string>
+#include <memory>
+
+namespace Nebula {
+
+	// Pulls interleaved 16-bit PCM frames from a file, every playing stream owns one
+	class AudioStreamDecoder
+	{
+	public:
+		virtual ~AudioStreamDecoder() = default;
+
+		// Returns the number of frames read, fewer than requested at the end of the file
+		virtual uint64_t Read(int16_t* samples, uint64_t frameCount) = 0;
+		virtual bool SeekToFrame(uint64_t frame) = 0;
+	};
+
+	struct MP3SeekTable;
+
+	// Clip that is never decoded as a whole. Loading only reads the format, the
+	// audio engine opens a decoder per source and feeds it to OpenAL in chunks.
+	class OpenALStreamingAudioClip : public AudioClip
+	{
+	public:
+		OpenALStreamingAudioClip(const std::string& filepath, const AudioClipImportOptions& options = {});
+		virtual ~OpenALStreamingAudioClip() = default;
+
+		virtual float GetDuration() const override { return m_Duration; }
+		virtual int GetSampleRate() const override { return m_SampleRate; }
+		virtual int GetChannels() const override { return m_Channels; }
+		virtual const std::string& GetFilePath() const override { return m_FilePath; }
+
+		virtual bool IsStreaming() const override { return true; }
+		virtual uint64_t GetDecodedSize() const override { return 0; }
+		virtual void* GetNativeHandle() const override { return nullptr; }
+
+		virtual void Decode() override;
+		// Nothing to upload, chunks are queued by the audio engine while playing
+		virtual void Upload() override { m_Ready = true; }
+		virtual bool IsReady() const override { return m_Ready; }
+
+		bool IsValid() const { return m_Valid; }
+		// Called from the audio engine's stream thread
+		std::unique_ptr<AudioStreamDecoder> OpenDecoder() const;
+
+		// MP3 and WAV (8/16-bit PCM, 32-bit float) can be streamed, other formats are decoded up front
+		static bool IsSupported(const std::string& filepath);
+
+	private:
+		enum class Format { MP3, WAV };
+
+		std::string m_FilePath;
+		Format m_Format = Format::MP3;
+		bool m_Downmix = false; // Stereo file played as mono
+		bool m_Valid = false;
+		bool m_Ready = false;
+		float m_Duration = 0.0f;
+		int m_SampleRate = 0;
+		int m_Channels = 0;
+		// Built once on load and shared by every decoder, so MP3 seeks don't decode from the start
+		std::shared_ptr<const MP3SeekTable> m_SeekTable;
+	};
+
+}
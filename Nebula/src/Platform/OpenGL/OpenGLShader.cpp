@@ -1,18 +1,58 @@
 #include "nbpch.h"
 #include "OpenGLShader.h"
 #include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Core/DerivedDataCache.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <fstream>
+#include <filesystem>
+#include <cstring>
 
 namespace Nebula {
 
+	// Live file-backed shaders, so a changed source file can be recompiled in place
+	static std::unordered_set<OpenGLShader*> s_FileShaders;
+
+	static std::string CanonicalShaderPath(const std::string& filepath)
+	{
+		std::error_code ec;
+		auto path = std::filesystem::weakly_canonical(filepath, ec);
+		return ec ? filepath : path.string();
+	}
+
+	// Bump when Compile() changes in a way that affects the linked program
+	static constexpr uint32_t s_ProgramBinaryVersion = 1;
+
+	// Program binaries only load on the driver that produced them
+	static std::string GetProgramCacheKey(const std::string& filepath)
+	{
+		static const std::string s_Driver = []()
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			if (formatCount <= 0)
+				return std::string();
+
+			auto glString = [](GLenum name)
+			{
+				const GLubyte* value = glGetString(name);
+				return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+			};
+			return glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+		}();
+
+		if (s_Driver.empty())
+			return "";
+		return DerivedDataCache::GetKey(filepath, "GLProgram", s_ProgramBinaryVersion, s_Driver);
+	}
+
 	OpenGLShader::OpenGLShader(const std::string& filepath)
+		: m_FilePath(CanonicalShaderPath(filepath))
 	{
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
+		LoadFromFile(filepath);
+		s_FileShaders.insert(this);
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -25,20 +65,105 @@ namespace Nebula {
 
 	OpenGLShader::~OpenGLShader()
 	{
+		s_FileShaders.erase(this);
 		glDeleteProgram(m_RendererID);
 	}
 
+	bool OpenGLShader::Reload()
+	{
+		if (m_FilePath.empty())
+			return false;
+
+		uint32_t oldProgram = m_RendererID;
+		if (!LoadFromFile(m_FilePath))
+		{
+			NB_CORE_ERROR("Shader reload failed, keeping previous version: {0}", m_FilePath);
+			return false;
+		}
+
+		glDeleteProgram(oldProgram);
+		return true;
+	}
+
+	uint32_t OpenGLShader::ReloadFromFile(const std::string& filepath)
+	{
+		std::string path = CanonicalShaderPath(filepath);
+		uint32_t reloaded = 0;
+		for (OpenGLShader* shader : s_FileShaders)
+		{
+			if (shader->m_FilePath == path && shader->Reload())
+				reloaded++;
+		}
+		return reloaded;
+	}
+
+	bool OpenGLShader::LoadFromFile(const std::string& filepath)
+	{
+		std::string cacheKey = GetProgramCacheKey(filepath);
+		if (LoadProgramBinary(cacheKey))
+		{
+			NB_CORE_INFO("Loaded cached shader program: {0}", filepath);
+			return true;
+		}
+
+		std::string source = ReadFile(filepath);
+		if (source.empty() || !Compile(PreProcess(source)))
+			return false;
+
+		if (!cacheKey.empty())
+			StoreProgramBinary(cacheKey);
+		return true;
+	}
+
+	bool OpenGLShader::LoadProgramBinary(const std::string& cacheKey)
+	{
+		std::vector<uint8_t> cached;
+		if (!DerivedDataCache::Load(cacheKey, cached) || cached.size() <= sizeof(GLenum))
+			return false;
+
+		GLenum format = 0;
+		memcpy(&format, cached.data(), sizeof(format));
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, format, cached.data() + sizeof(format), (GLsizei)(cached.size() - sizeof(format)));
+
+		// Drivers may reject binaries they produced themselves, e.g. after an update
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			return false;
+		}
+
+		m_RendererID = program;
+		return true;
+	}
+
+	void OpenGLShader::StoreProgramBinary(const std::string& cacheKey) const
+	{
+		GLint length = 0;
+		glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		// Binary format first, then the driver's blob
+		std::vector<uint8_t> binary(sizeof(GLenum) + length);
+		GLenum format = 0;
+		glGetProgramBinary(m_RendererID, length, &length, &format, binary.data() + sizeof(format));
+		memcpy(binary.data(), &format, sizeof(format));
+		binary.resize(sizeof(format) + length);
+
+		DerivedDataCache::Store(cacheKey, binary.data(), binary.size());
+	}
+
 	std::string OpenGLShader::ReadFile(const std::string& filepath)
 	{
 		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary);
-		if (in)
+		VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+		if (file)
 		{
-			in.seekg(0, std::ios::end);
-			result.resize(in.tellg());
-			in.seekg(0, std::ios::beg);
-			in.read(&result[0], result.size());
-			in.close();
+			result = file.ToString();
 			NB_CORE_INFO("Loaded shader file: {0}", filepath);
 		}
 		else
@@ -74,13 +199,13 @@ namespace Nebula {
 		return shaderSources;
 	}
 
-	void OpenGLShader::Compile(const std::unordered_map<uint32_t, std::string>& shaderSources)
+	bool OpenGLShader::Compile(const std::unordered_map<uint32_t, std::string>& shaderSources)
 	{
 		// Code from https://wikis.khronos.org/opengl/Shader_Compilation
 		
 		GLuint program = glCreateProgram();
 		NEB_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for now");
-		std::array<GLenum, 2> glShaderIDs;
+		std::array<GLenum, 2> glShaderIDs = {};
 		int glShaderIDIndex = 0;
 
 		for (auto& kv : shaderSources)
@@ -109,16 +234,19 @@ namespace Nebula {
 
 				NB_CORE_ERROR("{0}", infoLog.data());
 				NEB_CORE_ASSERT(false, "Shader compilation failure!");
-				break;
+
+				for (int i = 0; i < glShaderIDIndex; i++)
+					glDeleteShader(glShaderIDs[i]);
+				glDeleteProgram(program);
+				return false;
 			}
 
 			glAttachShader(program, shader);
 			glShaderIDs[glShaderIDIndex++] = shader;
 		}
 
-		m_RendererID = program;
-
-		// Link our program
+		// Link our program, keeping the binary retrievable for the derived data cache
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(program);
 
 		GLint isLinked = 0;
@@ -133,18 +261,23 @@ namespace Nebula {
 
 			glDeleteProgram(program);
 
-			for (auto id : glShaderIDs)
-				glDeleteShader(id);
+			for (int i = 0; i < glShaderIDIndex; i++)
+				glDeleteShader(glShaderIDs[i]);
 
 			NB_CORE_ERROR("{0}", infoLog.data());
 			NEB_CORE_ASSERT(false, "Shader link failure!");
-			return;
+			return false;
 		}
 
-		for (auto id : glShaderIDs)
-			glDetachShader(program, id);
-		
+		for (int i = 0; i < glShaderIDIndex; i++)
+		{
+			glDetachShader(program, glShaderIDs[i]);
+			glDeleteShader(glShaderIDs[i]);
+		}
+
+		m_RendererID = program;
 		NB_CORE_INFO("Shader compiled and linked successfully");
+		return true;
 	}
 
 	void OpenGLShader::Bind() const
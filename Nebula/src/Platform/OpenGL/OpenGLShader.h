@@ -22,12 +22,22 @@ namespace Nebula {
 	virtual void SetMat3(const std::string& name, const glm::mat3& matrix) override;
 	virtual void SetMat4(const std::string& name, const glm::mat4& matrix) override;
 
+	virtual bool Reload() override;
+
+	static uint32_t ReloadFromFile(const std::string& filepath);
+
 private:
+		// Links from the derived data cache when it has this source's program binary
+		bool LoadFromFile(const std::string& filepath);
+		bool LoadProgramBinary(const std::string& cacheKey);
+		void StoreProgramBinary(const std::string& cacheKey) const;
+
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<uint32_t, std::string> PreProcess(const std::string& source);
-		void Compile(const std::unordered_map<uint32_t, std::string>& shaderSources);
+		bool Compile(const std::unordered_map<uint32_t, std::string>& shaderSources);
 
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
+		std::string m_FilePath; // Canonical path, empty for shaders built from source strings
 	};
 }
@@ -1,6 +1,7 @@
 #include "nbpch.h"
 #include "OpenGLSkybox.h"
 #include "Nebula/Log.h"
+#include "Nebula/Core/VirtualFileSystem.h"
 
 #include <glad/glad.h>
 #include <stb_image.h>
@@ -119,12 +120,6 @@ namespace Nebula {
 	{
 		namespace fs = std::filesystem;
 
-		if (!fs::exists(directoryPath) || !fs::is_directory(directoryPath))
-		{
-			NB_CORE_ERROR("Skybox directory does not exist: {0}", directoryPath);
-			return false;
-		}
-
 		// Required files (must have at least one extension)
 		std::array<std::string, 6> requiredFiles = {
 			"right", "left", "top", "bottom", "front", "back"
@@ -132,14 +127,14 @@ namespace Nebula {
 
 		std::array<std::string, 2> validExtensions = { ".png", ".jpg" };
 
-		// Check each required file exists with valid extension
+		// Packed games have no directory on disk, so only the faces themselves are looked up
 		for (const auto& filename : requiredFiles)
 		{
 			bool found = false;
 			for (const auto& ext : validExtensions)
 			{
 				fs::path filePath = fs::path(directoryPath) / (filename + ext);
-				if (fs::exists(filePath))
+				if (VirtualFileSystem::Exists(filePath.string()))
 				{
 					found = true;
 					break;
@@ -148,26 +143,11 @@ namespace Nebula {
 
 			if (!found)
 			{
-				NB_CORE_ERROR("Skybox missing required file: {0}.png or {0}.jpg", filename);
+				NB_CORE_ERROR("Skybox missing required file in {0}: {1}.png or {1}.jpg", directoryPath, filename);
 				return false;
 			}
 		}
 
-		// Count total files in directory
-		int fileCount = 0;
-		for (const auto& entry : fs::directory_iterator(directoryPath))
-		{
-			if (entry.is_regular_file())
-				fileCount++;
-		}
-
-		// Should have exactly 6 files
-		if (fileCount != 6)
-		{
-			NB_CORE_ERROR("Skybox directory should contain exactly 6 image files. Found: {0}", fileCount);
-			return false;
-		}
-
 		return true;
 	}
 
@@ -184,7 +164,7 @@ namespace Nebula {
 		};
 
 		// Temporarily disable flipping for cubemaps (we'll restore after)
-		stbi_set_flip_vertically_on_load(false);
+		stbi_set_flip_vertically_on_load_thread(false);
 
 		for (unsigned int i = 0; i < faceFiles.size(); i++)
 		{
@@ -193,9 +173,9 @@ namespace Nebula {
 			fs::path pngPath = fs::path(directoryPath) / (faceFiles[i] + ".png");
 			fs::path jpgPath = fs::path(directoryPath) / (faceFiles[i] + ".jpg");
 
-			if (fs::exists(pngPath))
+			if (VirtualFileSystem::Exists(pngPath.string()))
 				filepath = pngPath.string();
-			else if (fs::exists(jpgPath))
+			else if (VirtualFileSystem::Exists(jpgPath.string()))
 				filepath = jpgPath.string();
 			else
 			{
@@ -204,7 +184,10 @@ namespace Nebula {
 			}
 
 			int width, height, channels;
-			unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+			unsigned char* data = nullptr;
+			VirtualFile file = VirtualFileSystem::ReadFile(filepath);
+			if (file)
+				data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 0);
 
 			if (data)
 			{
@@ -230,7 +213,7 @@ namespace Nebula {
 		}
 
 		// Restore flipping for regular textures
-		stbi_set_flip_vertically_on_load(true);
+		stbi_set_flip_vertically_on_load_thread(true);
 
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -1,62 +1,131 @@
 #include "nbpch.h"
 #include "OpenGLTexture.h"
+#include "Nebula/Core/VirtualFileSystem.h"
+#include "Nebula/Core/DerivedDataCache.h"
 
 #include "stb_image.h"
 
 #include <glad/glad.h>
+#include <cstring>
 
 namespace Nebula {
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, bool useNearest, bool repeat)
 		: m_Path(path), m_UseNearest(useNearest), m_Repeat(repeat)
 	{
+	}
+
+	// Cached decode result: CookedTextureHeader, then the pixels flipped for GL
+	struct CookedTextureHeader
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Channels = 0;
+		uint32_t Reserved = 0;
+	};
+
+	// Bump when the decoded output changes
+	static constexpr uint32_t s_CookedTextureVersion = 1;
+
+	void OpenGLTexture2D::Decode()
+	{
+		std::string cacheKey = DerivedDataCache::GetKey(m_Path, "Texture2D", s_CookedTextureVersion);
+		std::vector<uint8_t> cooked;
+		if (DerivedDataCache::Load(cacheKey, cooked) && cooked.size() >= sizeof(CookedTextureHeader))
+		{
+			CookedTextureHeader header;
+			memcpy(&header, cooked.data(), sizeof(header));
+			if ((header.Channels == 3 || header.Channels == 4) &&
+				cooked.size() - sizeof(header) == (size_t)header.Width * header.Height * header.Channels)
+			{
+				m_Width = header.Width;
+				m_Height = header.Height;
+				m_PendingChannels = header.Channels;
+				m_PendingData.assign(cooked.begin() + sizeof(header), cooked.end());
+				return;
+			}
+		}
+
 		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		// Per thread, textures decode on workers while the main thread loads skyboxes unflipped
+		stbi_set_flip_vertically_on_load_thread(1);
+		stbi_uc* data = nullptr;
+		VirtualFile file = VirtualFileSystem::ReadFile(m_Path);
+		if (file)
+			data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 0);
 		if (!data)
 		{
-			NB_CORE_ERROR("Failed to load texture: {0}", path);
+			NB_CORE_ERROR("Failed to load texture: {0}", m_Path);
 			NB_CORE_ERROR("STB Image Error: {0}", stbi_failure_reason());
+			return;
+		}
+
+		if (channels != 3 && channels != 4)
+		{
+			NB_CORE_ERROR("Texture format not supported ({0} channels): {1}", channels, m_Path);
+			stbi_image_free(data);
+			return;
 		}
-		NEB_CORE_ASSERT(data, "Failed to load image!");
+
 		m_Width = width;
 		m_Height = height;
+		m_PendingChannels = channels;
+		m_PendingData.assign(data, data + (size_t)width * height * channels);
+		stbi_image_free(data);
+
+		if (!cacheKey.empty())
+		{
+			CookedTextureHeader header;
+			header.Width = m_Width;
+			header.Height = m_Height;
+			header.Channels = m_PendingChannels;
+			cooked.resize(sizeof(header) + m_PendingData.size());
+			memcpy(cooked.data(), &header, sizeof(header));
+			memcpy(cooked.data() + sizeof(header), m_PendingData.data(), m_PendingData.size());
+			DerivedDataCache::Store(cacheKey, cooked.data(), cooked.size());
+		}
+	}
+
+	void OpenGLTexture2D::Upload()
+	{
+		if (m_PendingData.empty())
+			return;
 
 		GLenum internalFormat = 0, dataFormat = 0;
-		if (channels == 4)
+		if (m_PendingChannels == 4)
 		{
 			internalFormat = GL_RGBA8;
 			dataFormat = GL_RGBA;
 		}
-		else if (channels == 3)
+		else
 		{
 			internalFormat = GL_RGB8;
 			dataFormat = GL_RGB;
 		}
 
-		NEB_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
-
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
 		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
 
 		// Set filtering
-		GLenum filter = useNearest ? GL_NEAREST : GL_LINEAR;
+		GLenum filter = m_UseNearest ? GL_NEAREST : GL_LINEAR;
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, filter);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, filter);
 
 		// Set wrapping mode
-		GLenum wrapMode = repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+		GLenum wrapMode = m_Repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, wrapMode);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, wrapMode);
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, m_PendingData.data());
+		m_Channels = m_PendingChannels;
 
-		stbi_image_free(data);
+		std::vector<uint8_t>().swap(m_PendingData);
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
-		glDeleteTextures(1, &m_RendererID);
+		if (m_RendererID)
+			glDeleteTextures(1, &m_RendererID);
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
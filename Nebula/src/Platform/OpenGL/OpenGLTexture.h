@@ -2,6 +2,7 @@
 #pragma warning(disable: 4251)
 
 #include "Nebula/Renderer/Texture.h"
+#include <vector>
 
 namespace Nebula {
 
@@ -14,19 +15,29 @@ namespace Nebula {
 		virtual uint32_t GetWidth() const override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual uint64_t GetMemorySize() const override { return m_RendererID ? (uint64_t)m_Width * m_Height * m_Channels : 0; }
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
+		virtual void Decode() override;
+		virtual void Upload() override;
+		virtual bool IsReady() const override { return m_RendererID != 0; }
+
 		const std::string& GetPath() const { return m_Path; }
 		bool GetUseNearest() const { return m_UseNearest; }
 		bool GetRepeat() const { return m_Repeat; }
 
 	private:
 		std::string m_Path;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererID = 0;
+		uint32_t m_Channels = 0;
 		bool m_UseNearest;
 		bool m_Repeat;
+
+		// Decoded pixels waiting for Upload()
+		std::vector<uint8_t> m_PendingData;
+		int m_PendingChannels = 0;
 	};
 
 }
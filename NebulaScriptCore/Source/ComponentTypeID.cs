@@ -0,0 +1,10 @@
+namespace Nebula
+{
+    // Caches the engine's component ID for T. The ID is looked up once per type,
+    // after that component calls index the engine's dispatch table directly.
+    // -1 means T isn't an engine component.
+    internal static class ComponentTypeID<T>
+    {
+        internal static readonly int Value = InternalCalls.Entity_GetComponentTypeID(typeof(T));
+    }
+}
@@ -4,13 +4,33 @@ using System.Collections.Generic;
 
 namespace Nebula
 {
+    // Matches ScriptWaitType in ScriptScheduler.h
+    internal enum CoroutineWaitType
+    {
+        Frames = 0,
+        Seconds,
+        PhysicsStep,
+        AssetLoaded
+    }
+
     // Base class for yield instructions
     public abstract class YieldInstruction
     {
         internal abstract bool KeepWaiting { get; }
+
+        // Waits the engine can track natively. Returning false means the coroutine
+        // has to be checked every frame (e.g. WaitUntil).
+        internal virtual bool GetEngineWait(out CoroutineWaitType type, out float seconds, out ulong value)
+        {
+            type = CoroutineWaitType.Frames;
+            seconds = 0.0f;
+            value = 1;
+            return false;
+        }
     }
 
-    // Wait for given seconds (simulate with real time)
+    // Wait for given seconds. Coroutines started from a ScriptBehavior are resumed by the
+    // engine's timer wheel; the real-time check is only a fallback for standalone managers.
     public class WaitForSeconds : YieldInstruction
     {
         private readonly float _seconds;
@@ -23,6 +43,74 @@ namespace Nebula
         }
 
         internal override bool KeepWaiting => (DateTime.UtcNow - _startTime).TotalSeconds < _seconds;
+
+        internal override bool GetEngineWait(out CoroutineWaitType type, out float seconds, out ulong value)
+        {
+            type = CoroutineWaitType.Seconds;
+            seconds = _seconds;
+            value = 0;
+            return true;
+        }
+    }
+
+    // Wait for a number of frames
+    public class WaitForFrames : YieldInstruction
+    {
+        private readonly int _frames;
+        private int _remaining;
+
+        public WaitForFrames(int frames)
+        {
+            _frames = Math.Max(frames, 1);
+            _remaining = _frames;
+        }
+
+        // Fallback for standalone managers, which poll once per frame
+        internal override bool KeepWaiting => --_remaining > 0;
+
+        internal override bool GetEngineWait(out CoroutineWaitType type, out float seconds, out ulong value)
+        {
+            type = CoroutineWaitType.Frames;
+            seconds = 0.0f;
+            value = (ulong)_frames;
+            return true;
+        }
+    }
+
+    // Wait until after the next physics step
+    public class WaitForFixedUpdate : YieldInstruction
+    {
+        internal override bool KeepWaiting => false;
+
+        internal override bool GetEngineWait(out CoroutineWaitType type, out float seconds, out ulong value)
+        {
+            type = CoroutineWaitType.PhysicsStep;
+            seconds = 0.0f;
+            value = 0;
+            return true;
+        }
+    }
+
+    // Wait until an asset has finished loading
+    public class WaitForAssetLoaded : YieldInstruction
+    {
+        private readonly ulong _assetHandle;
+
+        public WaitForAssetLoaded(ulong assetHandle)
+        {
+            _assetHandle = assetHandle;
+        }
+
+        // Standalone managers can't see asset state and continue on the next frame
+        internal override bool KeepWaiting => false;
+
+        internal override bool GetEngineWait(out CoroutineWaitType type, out float seconds, out ulong value)
+        {
+            type = CoroutineWaitType.AssetLoaded;
+            seconds = 0.0f;
+            value = _assetHandle;
+            return true;
+        }
     }
 
     // Wait until a condition is true
@@ -46,6 +134,10 @@ namespace Nebula
 
         public bool IsComplete { get; private set; }
 
+        internal int ID { get; set; }
+        internal ulong TimerHandle { get; set; }
+        internal YieldInstruction CurrentYield => _currentYield;
+
         public Coroutine(IEnumerator routine)
         {
             _routine = routine ?? throw new ArgumentNullException(nameof(routine));
@@ -69,23 +161,62 @@ namespace Nebula
             _currentYield = _routine.Current as YieldInstruction;
             // If yielded null or no YieldInstruction, _currentYield will be null and coroutine continues next Update()
         }
+
+        // Called when the engine reports the current wait is over
+        internal void ClearYield()
+        {
+            _currentYield = null;
+        }
     }
 
-    // The CoroutineManager handles all active coroutines
+    // The CoroutineManager handles all active coroutines.
+    // When owned by a ScriptBehavior, every waiting coroutine is parked in the engine's
+    // ScriptScheduler and only resumed when its wait is over; nothing is polled per frame
+    // except WaitUntil conditions. Standalone managers poll everything from Update().
     public class CoroutineManager
     {
         private readonly List<Coroutine> _coroutines = new List<Coroutine>();
+        private readonly Dictionary<int, Coroutine> _sleeping = new Dictionary<int, Coroutine>();
+        private readonly ScriptBehavior _owner;
+        private int _nextID = 1;
+
+        public CoroutineManager()
+        {
+        }
+
+        internal CoroutineManager(ScriptBehavior owner)
+        {
+            _owner = owner;
+        }
 
         public Coroutine StartCoroutine(IEnumerator routine)
         {
-            var coroutine = new Coroutine(routine);
-            _coroutines.Add(coroutine);
+            var coroutine = new Coroutine(routine) { ID = _nextID++ };
+
+            // First step runs next frame, like the polled path
+            if (!TryPark(coroutine))
+                _coroutines.Add(coroutine);
             return coroutine;
         }
 
         public void StopCoroutine(Coroutine coroutine)
         {
+            if (coroutine == null)
+                return;
+
             _coroutines.Remove(coroutine);
+            if (_sleeping.Remove(coroutine.ID) && coroutine.TimerHandle != 0)
+                InternalCalls.Script_CancelTimer(coroutine.TimerHandle);
+        }
+
+        public void StopAllCoroutines()
+        {
+            foreach (var coroutine in _sleeping.Values)
+                if (coroutine.TimerHandle != 0)
+                    InternalCalls.Script_CancelTimer(coroutine.TimerHandle);
+
+            _sleeping.Clear();
+            _coroutines.Clear();
         }
 
         public void Update()
@@ -94,9 +225,56 @@ namespace Nebula
             {
                 var coroutine = _coroutines[i];
                 coroutine.Update();
-                if (coroutine.IsComplete)
+                if (coroutine.IsComplete || TryPark(coroutine))
                     _coroutines.RemoveAt(i);
             }
         }
+
+        // Called by the engine when a parked coroutine's wait is over
+        internal void Resume(int coroutineID)
+        {
+            // Stopped while it was waiting
+            if (!_sleeping.TryGetValue(coroutineID, out Coroutine coroutine))
+                return;
+
+            _sleeping.Remove(coroutineID);
+            coroutine.TimerHandle = 0;
+
+            // Engine-tracked waits are over by definition, polled ones (WaitUntil) check themselves
+            YieldInstruction current = coroutine.CurrentYield;
+            if (current != null && current.GetEngineWait(out _, out _, out _))
+                coroutine.ClearYield();
+
+            coroutine.Update();
+
+            if (!coroutine.IsComplete && !TryPark(coroutine))
+                _coroutines.Add(coroutine);
+        }
+
+        private bool TryPark(Coroutine coroutine)
+        {
+            if (_owner?.Entity == null)
+                return false;
+
+            CoroutineWaitType type = CoroutineWaitType.Frames;
+            float seconds = 0.0f;
+            ulong value = 1;
+
+            // null, non-instruction yields and polled instructions are checked again next frame
+            YieldInstruction current = coroutine.CurrentYield;
+            if (current != null && !current.GetEngineWait(out type, out seconds, out value))
+            {
+                type = CoroutineWaitType.Frames;
+                value = 1;
+            }
+
+            ulong handle = InternalCalls.Script_WaitCoroutine(_owner.Entity.ID, coroutine.ID, type, seconds, value);
+            if (handle == 0)
+                return false;
+
+            coroutine.TimerHandle = type == CoroutineWaitType.Seconds ? handle : 0;
+            _sleeping[coroutine.ID] = coroutine;
+            return true;
+        }
     }
 }
@@ -0,0 +1,104 @@
+using System;
+
+namespace Nebula
+{
+    /// <summary>
+    /// A cached list of entities that have all of the given components.
+    /// The engine keeps the list up to date as components are added and removed,
+    /// so reading it every frame doesn't walk the scene or allocate.
+    /// </summary>
+    public sealed class EntityQuery : IDisposable
+    {
+        private uint queryID;
+        private uint version;
+        private uint[] entities = new uint[16];
+        private int count;
+
+        private EntityQuery(uint id)
+        {
+            queryID = id;
+            Refresh();
+        }
+
+        /// <summary>
+        /// Creates a query matching entities that have every one of the component types
+        /// </summary>
+        public static EntityQuery Create(params Type[] componentTypes)
+        {
+            uint id = InternalCalls.Entity_CreateQuery(componentTypes);
+            if (id == 0)
+                return null;
+
+            return new EntityQuery(id);
+        }
+
+        /// <summary>
+        /// Number of matching entities
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                Refresh();
+                return count;
+            }
+        }
+
+        /// <summary>
+        /// Entity ID at the given index, valid for 0 &lt;= index &lt; Count
+        /// </summary>
+        public uint this[int index]
+        {
+            get
+            {
+                Refresh();
+                if (index < 0 || index >= count)
+                    throw new IndexOutOfRangeException();
+                return entities[index];
+            }
+        }
+
+        /// <summary>
+        /// Copies the matching entity IDs into a caller-owned buffer and returns the total match count,
+        /// which can be larger than the buffer
+        /// </summary>
+        public int GetEntities(uint[] results)
+        {
+            Refresh();
+            int copied = Math.Min(count, results.Length);
+            Array.Copy(entities, results, copied);
+            return count;
+        }
+
+        public void Dispose()
+        {
+            if (queryID != 0)
+            {
+                InternalCalls.Entity_DestroyQuery(queryID);
+                queryID = 0;
+            }
+        }
+
+        // Only copies from native when the match list actually changed
+        private void Refresh()
+        {
+            if (queryID == 0)
+            {
+                count = 0;
+                return;
+            }
+
+            uint currentVersion = InternalCalls.Entity_QueryGetVersion(queryID);
+            if (currentVersion == version)
+                return;
+
+            count = InternalCalls.Entity_QueryGetEntities(queryID, entities);
+            if (count > entities.Length)
+            {
+                entities = new uint[Math.Max(count, entities.Length * 2)];
+                count = InternalCalls.Entity_QueryGetEntities(queryID, entities);
+            }
+            version = currentVersion;
+        }
+    }
+}
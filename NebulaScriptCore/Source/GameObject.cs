@@ -22,6 +22,15 @@ namespace Nebula
             return entity;
         }
 
+        /// <summary>
+        /// Returns a handle that finds a GameObject by name and caches the result.
+        /// Keep the handle around (e.g. in OnCreate) and read handle.Entity each frame.
+        /// </summary>
+        public static NamedEntity FindCached(string name)
+        {
+            return new NamedEntity(name);
+        }
+
         /// <summary>
         /// Finds all GameObjects with a specific component type
         /// </summary>
@@ -40,6 +49,15 @@ namespace Nebula
             return entities;
         }
 
+        /// <summary>
+        /// Writes the IDs of all entities with a specific component type into results without allocating.
+        /// Returns the total number of matches, which can be larger than results.Length.
+        /// </summary>
+        public static int FindObjectsOfTypeNonAlloc<T>(uint[] results) where T : class
+        {
+            return InternalCalls.Entity_GetEntitiesWithComponentNonAlloc(typeof(T), results);
+        }
+
         /// <summary>
         /// Finds the first GameObject with a specific component type
         /// </summary>
@@ -84,6 +102,25 @@ namespace Nebula
             return entity;
         }
 
+        /// <summary>
+        /// Instantiates count copies of a prefab, including its children, in a single engine call.
+        /// positions and rotations are optional and need at least count entries.
+        /// </summary>
+        public static ScriptEntity[] Instantiate(ScriptEntity prefab, int count, Vector3[] positions, Vector3[] rotations = null)
+        {
+            if (prefab == null)
+            {
+                Log.LogError("Cannot instantiate null prefab");
+                return new ScriptEntity[0];
+            }
+
+            uint[] entityIDs = InternalCalls.Entity_InstantiateBatch(prefab.ID, count, positions, rotations);
+            var entities = new ScriptEntity[entityIDs.Length];
+            for (int i = 0; i < entityIDs.Length; i++)
+                entities[i] = new ScriptEntity { ID = entityIDs[i] };
+            return entities;
+        }
+
         /// <summary>
         /// Destroys a GameObject
         /// </summary>
@@ -141,6 +178,15 @@ namespace Nebula
 
             return entities;
         }
+
+        /// <summary>
+        /// Writes the IDs of all entities with the specified tag into results without allocating.
+        /// Returns the total number of matches, which can be larger than results.Length.
+        /// </summary>
+        public static int FindGameObjectsWithTagNonAlloc(string tag, uint[] results)
+        {
+            return InternalCalls.Entity_FindAllByTagNonAlloc(tag, results);
+        }
     }
 
     internal static class InternalCalls
@@ -165,9 +211,6 @@ namespace Nebula
         internal static extern void Entity_SetScale(uint entityID, ref Vector3 scale);
 
         // Component methods
-        [MethodImpl(MethodImplOptions.InternalCall)]
-        internal static extern bool Entity_HasComponent(uint entityID, Type componentType);
-
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern bool Entity_GetComponent(uint entityID, Type componentType, object outComponent);
 
@@ -177,6 +220,22 @@ namespace Nebula
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern void Entity_RemoveComponent(uint entityID, Type componentType);
 
+        // Component calls keyed by the engine's dense component ID, see ComponentTypeID<T>
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Entity_GetComponentTypeID(Type componentType);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Entity_HasComponentByID(uint entityID, int componentID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Entity_GetComponentByID(uint entityID, int componentID, object outComponent);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Entity_AddComponentByID(uint entityID, int componentID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Entity_RemoveComponentByID(uint entityID, int componentID);
+
         // Entity management
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern string Entity_GetName(uint entityID);
@@ -187,24 +246,74 @@ namespace Nebula
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern uint[] Entity_GetAllEntitiesWithComponent(Type componentType);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Entity_GetEntitiesWithComponentNonAlloc(Type componentType, uint[] buffer);
+
+        // Cached queries
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_CreateQuery(Type[] componentTypes);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Entity_DestroyQuery(uint queryID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_QueryGetVersion(uint queryID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Entity_QueryGetEntities(uint queryID, uint[] buffer);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern uint Entity_FindByName(string name);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_FindNameID(string name);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_FindByNameID(uint nameID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_GetNameVersion(uint nameID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint Entity_GetNameSetVersion();
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern uint Entity_FindByTag(string tag);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern uint[] Entity_FindAllByTag(string tag);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Entity_FindAllByTagNonAlloc(string tag, uint[] buffer);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern uint Entity_Instantiate(uint prefabID);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern uint[] Entity_InstantiateBatch(uint prefabID, int count, Vector3[] positions, Vector3[] rotations);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern void Entity_Destroy(uint entityID);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern void Entity_DestroyDelayed(uint entityID, float delay);
 
+        // Script timers
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong Script_Invoke(uint entityID, string methodName, float delay, float repeatRate);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong Script_WaitCoroutine(uint entityID, int coroutineID, CoroutineWaitType waitType, float seconds, ulong value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Script_SetUpdateEnabled(uint entityID, bool enabled);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Script_CancelTimer(ulong handle);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Script_IsTimerPending(ulong handle);
+
         // Script methods
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern object Entity_GetScriptInstance(uint entityID, Type scriptType);
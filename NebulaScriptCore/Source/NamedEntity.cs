@@ -0,0 +1,70 @@
+namespace Nebula
+{
+    /// <summary>
+    /// A cached lookup of an entity by name. Reading Entity doesn't marshal the string
+    /// once the name is found, and only asks the engine again when an entity with that
+    /// name has been created, renamed or destroyed.
+    /// </summary>
+    public sealed class NamedEntity
+    {
+        // 0 while no entity has the name. The engine drops a name with its last
+        // entity, so the ID can also go stale and has to be looked up again.
+        private uint nameID;
+        private uint version;
+        private uint nameSetVersion = uint.MaxValue;
+        private ScriptEntity entity;
+
+        /// <summary>
+        /// The name being looked up
+        /// </summary>
+        public string Name { get; }
+
+        internal NamedEntity(string name)
+        {
+            Name = name;
+        }
+
+        /// <summary>
+        /// An entity with the name, or null if there is none. Stays the same entity
+        /// until it is destroyed or renamed, even when others share the name.
+        /// </summary>
+        public ScriptEntity Entity
+        {
+            get
+            {
+                if (nameID != 0)
+                {
+                    uint currentVersion = InternalCalls.Entity_GetNameVersion(nameID);
+                    if (currentVersion != 0)
+                    {
+                        if (currentVersion != version)
+                            Refresh(currentVersion);
+                        return entity;
+                    }
+
+                    // The last entity with the name is gone
+                    nameID = 0;
+                    entity = null;
+                }
+
+                // Only marshal the string again once some new name has shown up
+                uint currentNameSetVersion = InternalCalls.Entity_GetNameSetVersion();
+                if (currentNameSetVersion != nameSetVersion)
+                {
+                    nameSetVersion = currentNameSetVersion;
+                    nameID = InternalCalls.Entity_FindNameID(Name);
+                    if (nameID != 0)
+                        Refresh(InternalCalls.Entity_GetNameVersion(nameID));
+                }
+                return entity;
+            }
+        }
+
+        private void Refresh(uint currentVersion)
+        {
+            uint entityID = InternalCalls.Entity_FindByNameID(nameID);
+            entity = entityID != 0 ? new ScriptEntity { ID = entityID } : null;
+            version = currentVersion;
+        }
+    }
+}
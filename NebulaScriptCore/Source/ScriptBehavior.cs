@@ -1,3 +1,5 @@
+using System.Collections.Generic;
+
 namespace Nebula
 {
     public abstract class ScriptBehavior
@@ -12,7 +14,7 @@ namespace Nebula
             get
             {
                 if (_coroutineManager == null)
-                    _coroutineManager = new CoroutineManager();
+                    _coroutineManager = new CoroutineManager(this);
                 return _coroutineManager;
             }
         }
@@ -69,6 +71,11 @@ namespace Nebula
             return GameObject.Instantiate(prefab, position, rotation);
         }
 
+        public static ScriptEntity[] Instantiate(ScriptEntity prefab, int count, Vector3[] positions, Vector3[] rotations = null)
+        {
+            return GameObject.Instantiate(prefab, count, positions, rotations);
+        }
+
         public static void Destroy(ScriptEntity entity)
         {
             GameObject.Destroy(entity);
@@ -90,11 +97,94 @@ namespace Nebula
             coroutineManager.StopCoroutine(coroutine);
         }
 
+        public void StopAllCoroutines()
+        {
+            _coroutineManager?.StopAllCoroutines();
+        }
+
+        /// <summary>
+        /// Adds or removes this behaviour from the per-frame OnUpdate set. Coroutines and
+        /// Invoke keep running while it is disabled, so a behaviour that is only waiting
+        /// can turn this off and pay nothing per frame.
+        /// </summary>
+        public void SetUpdateEnabled(bool enabled)
+        {
+            if (Entity != null)
+                InternalCalls.Script_SetUpdateEnabled(Entity.ID, enabled);
+        }
+
+        // Called by the engine when a coroutine's wait is over
+        internal void ResumeCoroutine(int coroutineID)
+        {
+            _coroutineManager?.Resume(coroutineID);
+        }
+
+        // Delayed method calls, scheduled on the engine's timer wheel
+        private Dictionary<string, List<ulong>> _invokes;
+
+        public void Invoke(string methodName, float time)
+        {
+            InvokeRepeating(methodName, time, 0.0f);
+        }
+
+        public void InvokeRepeating(string methodName, float time, float repeatRate)
+        {
+            if (Entity == null)
+                return;
+
+            ulong handle = InternalCalls.Script_Invoke(Entity.ID, methodName, time, repeatRate);
+            if (handle == 0)
+                return;
+
+            if (_invokes == null)
+                _invokes = new Dictionary<string, List<ulong>>();
+            if (!_invokes.TryGetValue(methodName, out List<ulong> handles))
+            {
+                handles = new List<ulong>();
+                _invokes[methodName] = handles;
+            }
+
+            handles.RemoveAll(h => !InternalCalls.Script_IsTimerPending(h));
+            handles.Add(handle);
+        }
+
+        public void CancelInvoke()
+        {
+            if (_invokes == null)
+                return;
+
+            foreach (var handles in _invokes.Values)
+                foreach (ulong handle in handles)
+                    InternalCalls.Script_CancelTimer(handle);
+            _invokes.Clear();
+        }
+
+        public void CancelInvoke(string methodName)
+        {
+            if (_invokes == null || !_invokes.TryGetValue(methodName, out List<ulong> handles))
+                return;
+
+            foreach (ulong handle in handles)
+                InternalCalls.Script_CancelTimer(handle);
+            _invokes.Remove(methodName);
+        }
+
+        public bool IsInvoking(string methodName)
+        {
+            if (_invokes == null || !_invokes.TryGetValue(methodName, out List<ulong> handles))
+                return false;
+
+            foreach (ulong handle in handles)
+                if (InternalCalls.Script_IsTimerPending(handle))
+                    return true;
+            return false;
+        }
+
         // Unity-like lifecycle methods
         public virtual void OnCreate() { }
         public virtual void OnUpdate(float deltaTime)
         {
-            // Update coroutines
+            // Coroutines are resumed by the engine; this only advances ones that couldn't be parked
             _coroutineManager?.Update();
         }
         public virtual void OnFixedUpdate() { }
@@ -176,9 +176,6 @@ namespace Nebula
             // Handle ScriptBehavior subclasses (returns script instance)
             if (typeof(ScriptBehavior).IsAssignableFrom(typeof(T)))
             {
-                if (!HasComponent<T>())
-                    return null;
-
                 object scriptInstance = InternalCalls.Entity_GetScriptInstance(ID, typeof(T));
                 return scriptInstance as T;
             }
@@ -206,7 +203,7 @@ namespace Nebula
                 lineRenderer._entityID = ID;
             }
             
-            if (!InternalCalls.Entity_GetComponent(ID, typeof(T), component))
+            if (!InternalCalls.Entity_GetComponentByID(ID, ComponentTypeID<T>.Value, component))
                 return null;
 
             // Ensure entity ID is set AFTER getting component data (in case it was overwritten)
@@ -228,7 +225,15 @@ namespace Nebula
 
         public bool HasComponent<T>() where T : class
         {
-            return InternalCalls.Entity_HasComponent(ID, typeof(T));
+            int componentID = ComponentTypeID<T>.Value;
+            if (componentID >= 0)
+                return InternalCalls.Entity_HasComponentByID(ID, componentID);
+
+            // Scripts aren't engine components, the entity has one if its script instance is a T
+            if (typeof(ScriptBehavior).IsAssignableFrom(typeof(T)))
+                return InternalCalls.Entity_GetScriptInstance(ID, typeof(T)) is T;
+
+            return false;
         }
 
         public T AddComponent<T>() where T : class
@@ -239,7 +244,7 @@ namespace Nebula
                 return GetComponent<T>();
             }
 
-            InternalCalls.Entity_AddComponent(ID, typeof(T));
+            InternalCalls.Entity_AddComponentByID(ID, ComponentTypeID<T>.Value);
             return GetComponent<T>();
         }
 
@@ -251,7 +256,7 @@ namespace Nebula
                 return;
             }
 
-            InternalCalls.Entity_RemoveComponent(ID, typeof(T));
+            InternalCalls.Entity_RemoveComponentByID(ID, ComponentTypeID<T>.Value);
         }
 
         // GetScript methods for accessing script instances
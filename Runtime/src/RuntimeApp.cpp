@@ -2,6 +2,12 @@
 
 #include <Nebula.h>
 #include <filesystem>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+// Set in CreateApplication, before the engine and Mono start up
+static std::chrono::steady_clock::time_point s_LaunchTime;
 
 class RuntimeLayer : public Nebula::Layer {
 public:
@@ -47,6 +53,8 @@ public:
 		m_FrameTime = ts.GetSeconds();
 		m_FPS = 1.0f / m_FrameTime;
 
+		TrackStartup(ts.GetSeconds());
+
 		// Update scene (runs all scripts, physics, etc.)
 		if (m_ActiveScene)
 		{
@@ -132,10 +140,51 @@ public:
 #endif
 	}
 
+private:
+	// Logs launch-to-first-frame time and frame times over the first second,
+	// to compare JIT and AOT compiled scripts
+	void TrackStartup(float frameTime)
+	{
+		if (m_StartupReported)
+			return;
+
+		if (m_StartupFrames == 0)
+		{
+			float coldStart = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - s_LaunchTime).count();
+			// Label by what was actually loaded, the AOT modes fall back to JIT without images
+			const char* scripts = "JIT";
+			if (Nebula::ScriptEngine::AreAssembliesAOTLoaded())
+				scripts = "AOT";
+			else if (Nebula::ScriptEngine::GetCompileMode() != Nebula::ScriptCompileMode::JIT)
+				scripts = "JIT, AOT images missing or not loaded";
+			NB_INFO("Startup: {0:.1f} ms to first frame ({1})", coldStart, scripts);
+		}
+		else
+		{
+			// The first frame's delta covers loading, it's already in the cold start number
+			m_StartupTime += frameTime;
+			m_StartupWorstFrame = std::max(m_StartupWorstFrame, frameTime);
+		}
+		m_StartupFrames++;
+
+		if (m_StartupTime >= 1.0f)
+		{
+			uint32_t frames = m_StartupFrames - 1;
+			NB_INFO("First second: {0} frames, avg {1:.2f} ms, worst {2:.2f} ms", frames,
+				m_StartupTime * 1000.0f / frames, m_StartupWorstFrame * 1000.0f);
+			m_StartupReported = true;
+		}
+	}
+
 private:
 	std::shared_ptr<Nebula::Scene> m_ActiveScene;
 	float m_FPS = 0.0f;
 	float m_FrameTime = 0.0f;
+
+	uint32_t m_StartupFrames = 0;
+	float m_StartupTime = 0.0f;
+	float m_StartupWorstFrame = 0.0f;
+	bool m_StartupReported = false;
 };
 
 class Runtime : public Nebula::Application {
@@ -161,5 +210,22 @@ public:
 
 
 Nebula::Application* Nebula::CreateApplication(int argc, char** argv) {
+	s_LaunchTime = std::chrono::steady_clock::now();
+
+	// Precompiled script images are used when present (see aot-compile-scripts.ps1)
+	Nebula::ScriptCompileMode compileMode = Nebula::ScriptCompileMode::AOT;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--jit") == 0)
+			compileMode = Nebula::ScriptCompileMode::JIT;
+		else if (strcmp(argv[i], "--full-aot") == 0)
+			compileMode = Nebula::ScriptCompileMode::FullAOT;
+	}
+	Nebula::ScriptEngine::SetCompileMode(compileMode);
+
+	// Cooked builds ship their assets in a pack next to the executable, loose files still work without one
+	if (std::filesystem::exists("Game.nbpak"))
+		Nebula::VirtualFileSystem::Mount("Game.nbpak");
+
 	return new Runtime();
 }
\ No newline at end of file
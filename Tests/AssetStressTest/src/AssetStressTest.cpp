@@ -0,0 +1,179 @@
+#include "AssetStressTest.h"
+#include "Nebula/Asset/AssetManager.h"
+#include "Nebula/Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+namespace Nebula {
+
+	using StressClock = std::chrono::steady_clock;
+
+	static std::vector<std::thread> s_Threads;
+	static std::vector<std::string> s_Paths;
+	// First handle each path came back with, 0 until one did
+	static std::unique_ptr<std::atomic<uint64_t>[]> s_FirstHandles;
+
+	static std::atomic<bool> s_StopRequested{ false };
+	static std::atomic<uint32_t> s_ActiveWorkers{ 0 };
+	static StressClock::time_point s_StartTime;
+	static StressClock::time_point s_EndTime;
+	static AssetStressTestResult s_Result;
+
+	static std::atomic<uint64_t> s_Loads{ 0 };
+	static std::atomic<uint64_t> s_Gets{ 0 };
+	static std::atomic<uint64_t> s_AsyncLoads{ 0 };
+	static std::atomic<uint64_t> s_Failures{ 0 };
+	static std::atomic<uint64_t> s_DuplicateHandles{ 0 };
+
+	static void StressWorker(uint32_t seed, float seconds)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<size_t> pickPath(0, s_Paths.size() - 1);
+		auto end = StressClock::now() + std::chrono::duration_cast<StressClock::duration>(std::chrono::duration<float>(seconds));
+
+		for (uint32_t iteration = 0; !s_StopRequested && StressClock::now() < end; iteration++)
+		{
+			size_t index = pickPath(random);
+
+			// Now and then go through the async path too, without waiting for it
+			if (iteration % 16 == 0)
+			{
+				AssetManager::LoadAssetAsync(s_Paths[pickPath(random)], (AssetLoadPriority)(iteration % 3));
+				s_AsyncLoads++;
+			}
+
+			std::shared_ptr<Asset> asset = AssetManager::LoadAssetFromPath(s_Paths[index]);
+			s_Loads++;
+			if (!asset)
+			{
+				s_Failures++;
+				continue;
+			}
+
+			uint64_t handle = asset->GetHandle();
+			uint64_t expected = 0;
+			if (!s_FirstHandles[index].compare_exchange_strong(expected, handle) && expected != handle)
+				s_DuplicateHandles++;
+
+			// The asset may be evicted in between under a tight budget, which reloads it
+			if (!AssetManager::GetAsset<Asset>(handle))
+				s_Failures++;
+			s_Gets++;
+		}
+
+		s_ActiveWorkers--;
+	}
+
+	void AssetStressTest::Start(const std::vector<std::string>& paths, uint32_t threadCount, float seconds)
+	{
+		if (IsRunning())
+		{
+			NB_WARN("Asset stress test is already running");
+			return;
+		}
+
+		if (paths.empty() || threadCount == 0)
+		{
+			NB_WARN("Asset stress test needs at least one path and one thread");
+			return;
+		}
+
+		s_Paths = paths;
+		s_FirstHandles = std::make_unique<std::atomic<uint64_t>[]>(paths.size());
+		for (size_t i = 0; i < paths.size(); i++)
+			s_FirstHandles[i] = 0;
+
+		s_Loads = 0;
+		s_Gets = 0;
+		s_AsyncLoads = 0;
+		s_Failures = 0;
+		s_DuplicateHandles = 0;
+
+		s_Result = AssetStressTestResult();
+		s_Result.Threads = threadCount;
+		s_Result.Paths = (uint32_t)paths.size();
+
+		s_StopRequested = false;
+		s_ActiveWorkers = threadCount;
+		s_StartTime = StressClock::now();
+		for (uint32_t i = 0; i < threadCount; i++)
+			s_Threads.emplace_back(StressWorker, i + 1, seconds);
+
+		NB_INFO("Asset stress test: {0} threads on {1} files for {2}s", threadCount, paths.size(), seconds);
+	}
+
+	void AssetStressTest::Start(const std::filesystem::path& directory, uint32_t threadCount, float seconds, uint32_t maxPaths)
+	{
+		std::vector<std::string> paths;
+		std::error_code error;
+		for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+		{
+			if (paths.size() >= maxPaths)
+				break;
+
+			std::error_code entryError;
+			if (it->is_regular_file(entryError) && AssetManager::GetAssetTypeFromExtension(it->path().extension().string()) == AssetType::Texture2D)
+				paths.push_back(it->path().string());
+		}
+
+		if (paths.empty())
+		{
+			NB_WARN("Asset stress test: no textures found in {0}", directory.string());
+			return;
+		}
+
+		Start(paths, threadCount, seconds);
+	}
+
+	void AssetStressTest::Stop()
+	{
+		if (s_Threads.empty())
+			return;
+
+		// Workers blocked in LoadAsset wait for the main thread to finish their load
+		s_StopRequested = true;
+		while (s_ActiveWorkers > 0)
+		{
+			AssetManager::Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		IsRunning();
+	}
+
+	bool AssetStressTest::IsRunning()
+	{
+		if (s_Threads.empty())
+			return false;
+		if (s_ActiveWorkers > 0)
+			return true;
+
+		for (std::thread& thread : s_Threads)
+			thread.join();
+		s_Threads.clear();
+		s_EndTime = StressClock::now();
+
+		AssetStressTestResult result = GetResult();
+		if (result.Failures == 0 && result.DuplicateHandles == 0)
+			NB_INFO("Asset stress test passed: {0} loads, {1} gets, {2} async loads in {3}s", result.Loads, result.Gets, result.AsyncLoads, result.Seconds);
+		else
+			NB_ERROR("Asset stress test failed: {0} failures, {1} duplicate handles in {2} loads", result.Failures, result.DuplicateHandles, result.Loads);
+		return false;
+	}
+
+	AssetStressTestResult AssetStressTest::GetResult()
+	{
+		AssetStressTestResult result = s_Result;
+		auto end = s_Threads.empty() ? s_EndTime : StressClock::now();
+		result.Seconds = s_Result.Threads > 0 ? std::chrono::duration<float>(end - s_StartTime).count() : 0.0f;
+		result.Loads = s_Loads;
+		result.Gets = s_Gets;
+		result.AsyncLoads = s_AsyncLoads;
+		result.Failures = s_Failures;
+		result.DuplicateHandles = s_DuplicateHandles;
+		return result;
+	}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Nebula {
+
+	struct AssetStressTestResult
+	{
+		uint32_t Threads = 0;
+		uint32_t Paths = 0;
+		float Seconds = 0.0f;
+
+		uint64_t Loads = 0;      // LoadAsset calls
+		uint64_t Gets = 0;       // GetAsset calls on the loaded handle
+		uint64_t AsyncLoads = 0; // LoadAssetAsync calls
+
+		// Should all stay 0
+		uint64_t Failures = 0;          // A load or get that returned nothing
+		uint64_t DuplicateHandles = 0;  // A path that came back under a second handle, i.e. was imported twice
+	};
+
+	// Hammers GetAsset / LoadAsset / LoadAssetAsync from worker threads to check that
+	// AssetManager stays consistent under contention. Run it under a race detector
+	// for the full picture. Loads from workers finish in AssetManager::Update(), so the
+	// main loop has to keep running while the test does. Main thread only.
+	class AssetStressTest
+	{
+	public:
+		static void Start(const std::vector<std::string>& paths, uint32_t threadCount = 8, float seconds = 5.0f);
+		// Uses up to maxPaths textures found under the directory
+		static void Start(const std::filesystem::path& directory, uint32_t threadCount = 8, float seconds = 5.0f, uint32_t maxPaths = 32);
+		// Ends the test early. Pumps AssetManager::Update() until the workers are done.
+		static void Stop();
+
+		// Also joins the workers once they're done
+		static bool IsRunning();
+		// Counts so far while running
+		static AssetStressTestResult GetResult();
+	};
+
+}
@@ -0,0 +1,124 @@
+#include "AssetStressTest.h"
+#include "Nebula/Asset/AssetManager.h"
+#include "Nebula/Core/JobSystem.h"
+#include "Nebula/Log.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+// Runs AssetStressTest against its own AssetManager and the files in fixtures/.
+// No window or GL context here, so .png files load through FixtureImporter, which
+// only reads and checks the bytes. Exits with 1 if any load failed or a file was
+// imported twice.
+//
+//   AssetStressTest [fixture directory] [threads] [seconds]
+
+namespace {
+
+	struct FixtureImportData : public Nebula::AssetImportData
+	{
+		std::vector<char> Bytes;
+	};
+
+	class FixtureAsset : public Nebula::Asset
+	{
+	public:
+		FixtureAsset(Nebula::AssetHandle handle, const std::string& path, std::vector<char> bytes)
+			: Asset(handle, Nebula::AssetType::Texture2D, path), m_Bytes(std::move(bytes))
+		{
+			m_IsLoaded = true;
+		}
+
+		virtual Nebula::AssetMemoryUsage GetMemoryUsage() const override
+		{
+			Nebula::AssetMemoryUsage usage;
+			usage.CPUBytes = m_Bytes.size();
+			return usage;
+		}
+
+	private:
+		std::vector<char> m_Bytes;
+	};
+
+	class FixtureImporter : public Nebula::AssetImporter
+	{
+	public:
+		virtual std::shared_ptr<Nebula::Asset> ImportAsset(Nebula::AssetHandle handle, const Nebula::AssetMetadata& metadata) override
+		{
+			return FinalizeAsset(handle, metadata, LoadAssetData(metadata));
+		}
+
+		virtual bool CanImport(const std::string& extension) const override
+		{
+			return extension == ".png";
+		}
+
+		virtual std::unique_ptr<Nebula::AssetImportData> LoadAssetData(const Nebula::AssetMetadata& metadata) override
+		{
+			std::ifstream file(metadata.FilePath, std::ios::binary);
+			if (!file)
+				return nullptr;
+
+			auto data = std::make_unique<FixtureImportData>();
+			data->Bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			return data;
+		}
+
+		virtual std::shared_ptr<Nebula::Asset> FinalizeAsset(Nebula::AssetHandle handle, const Nebula::AssetMetadata& metadata, std::unique_ptr<Nebula::AssetImportData> data) override
+		{
+			static const char s_PNGSignature[8] = { '\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n' };
+
+			auto* fixtureData = static_cast<FixtureImportData*>(data.get());
+			if (!fixtureData || fixtureData->Bytes.size() < sizeof(s_PNGSignature) ||
+				std::memcmp(fixtureData->Bytes.data(), s_PNGSignature, sizeof(s_PNGSignature)) != 0)
+			{
+				NB_ERROR("Not a PNG fixture: {0}", metadata.FilePath);
+				return nullptr;
+			}
+
+			return std::make_shared<FixtureAsset>(handle, metadata.FilePath, std::move(fixtureData->Bytes));
+		}
+	};
+
+}
+
+int main(int argc, char** argv)
+{
+	Nebula::Log::Init();
+
+	std::string directory = argc > 1 ? argv[1] : "fixtures";
+	uint32_t threadCount = argc > 2 ? (uint32_t)std::stoul(argv[2]) : 8;
+	float seconds = argc > 3 ? std::stof(argv[3]) : 5.0f;
+
+	Nebula::AssetManager::Init();
+	Nebula::AssetManager::RegisterImporter(Nebula::AssetType::Texture2D, std::make_shared<FixtureImporter>());
+	Nebula::JobSystem::Init();
+
+	// Smaller than the fixtures together, so eviction and reloads run alongside the loads
+	Nebula::AssetManager::SetMemoryBudget(256);
+
+	Nebula::AssetStressTest::Start(std::filesystem::path(directory), threadCount, seconds);
+
+	// Stands in for the main loop, worker loads finish in Update()
+	while (Nebula::AssetStressTest::IsRunning())
+	{
+		Nebula::AssetManager::Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	Nebula::AssetManager::WaitForAsyncLoads();
+	Nebula::AssetStressTestResult result = Nebula::AssetStressTest::GetResult();
+
+	Nebula::JobSystem::Shutdown();
+	Nebula::AssetManager::Shutdown();
+
+	if (result.Paths == 0)
+	{
+		NB_ERROR("No fixtures found in {0}", directory);
+		return 1;
+	}
+	return result.Failures == 0 && result.DuplicateHandles == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+# Script AOT Compiler
+# Precompiles NebulaScriptCore.dll and the project's Scripts.dll with Mono's AOT compiler,
+# so the Runtime doesn't JIT script code on startup. Run it from the game's directory
+# (the one containing Library/ and Assets/) after building the scripts.
+#
+# The Runtime picks the images up automatically, start it with --jit to ignore them.
+# With -Full the BCL is compiled too and the Runtime has to be started with --full-aot.
+# Mono's AOT compiler needs an assembler and linker; on Windows pass the prefix of a
+# mingw-w64 binutils install with -ToolPrefix (e.g. "C:\mingw64\bin\x86_64-w64-mingw32-").
+
+param(
+    [string]$ProjectDir = (Get-Location).Path,
+    [string]$ScriptAssembly = "Assets\Scripts\bin\Debug\Scripts.dll",
+    [string]$MonoPath = "",
+    [string]$ToolPrefix = "",
+    [switch]$Full
+)
+
+Write-Host "====================================" -ForegroundColor Cyan
+Write-Host "Script AOT Compiler" -ForegroundColor Cyan
+Write-Host "====================================" -ForegroundColor Cyan
+Write-Host ""
+
+# Find mono.exe
+if (-not $MonoPath) {
+    $monoPaths = @(
+        "C:\Program Files\Mono",
+        "C:\Program Files (x86)\Mono",
+        "$env:ProgramFiles\Mono",
+        "${env:ProgramFiles(x86)}\Mono"
+    )
+    foreach ($path in $monoPaths) {
+        if (Test-Path "$path\bin\mono.exe") {
+            $MonoPath = $path
+            break
+        }
+    }
+}
+
+$monoExe = Join-Path $MonoPath "bin\mono.exe"
+if (-not $MonoPath -or -not (Test-Path $monoExe)) {
+    Write-Host "mono.exe not found. Install Mono or pass -MonoPath." -ForegroundColor Red
+    exit 1
+}
+Write-Host "Using Mono at: $MonoPath" -ForegroundColor Green
+
+$aotOptions = @()
+if ($Full) { $aotOptions += "full" }
+if ($ToolPrefix) { $aotOptions += "tool-prefix=$ToolPrefix" }
+$aotArg = if ($aotOptions.Count -gt 0) { "--aot=" + ($aotOptions -join ",") } else { "--aot" }
+
+$assemblies = @(
+    (Join-Path $ProjectDir "Library\NebulaScriptCore.dll"),
+    (Join-Path $ProjectDir $ScriptAssembly)
+)
+
+# Full AOT disables the JIT, so everything the scripts call into has to be compiled as well
+if ($Full) {
+    # The images have to sit next to the BCL the Runtime loads (lib\ beside the executable)
+    $bclDir = Join-Path $ProjectDir "lib\mono\4.5"
+    if (-not (Test-Path $bclDir)) { $bclDir = Join-Path $MonoPath "lib\mono\4.5" }
+    $assemblies += @(
+        (Join-Path $bclDir "mscorlib.dll"),
+        (Join-Path $bclDir "System.dll"),
+        (Join-Path $bclDir "System.Core.dll")
+    )
+}
+
+$failed = 0
+foreach ($assembly in $assemblies) {
+    if (-not (Test-Path $assembly)) {
+        Write-Host "  Missing: $assembly" -ForegroundColor Yellow
+        $failed++
+        continue
+    }
+
+    Write-Host "  Compiling $assembly" -ForegroundColor White
+    & $monoExe $aotArg $assembly
+    if ($LASTEXITCODE -ne 0) {
+        Write-Host "  AOT compilation failed for $assembly" -ForegroundColor Red
+        $failed++
+    }
+}
+
+Write-Host ""
+if ($failed -eq 0) {
+    Write-Host "AOT compilation complete!" -ForegroundColor Green
+} else {
+    Write-Host "$failed assembly(s) were not compiled" -ForegroundColor Red
+}
+Write-Host "====================================" -ForegroundColor Cyan
+exit $failed
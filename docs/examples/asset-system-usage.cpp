@@ -39,7 +39,7 @@ public:
             auto texture = Nebula::AssetManager::GetAsset<Nebula::TextureAsset>(handle);
             
             // Get metadata
-            Nebula::AssetMetadata& metadata = Nebula::AssetManager::GetMetadata(handle);
+            Nebula::AssetMetadata metadata = Nebula::AssetManager::GetMetadata(handle);
             NB_INFO("Asset type: {0}", Nebula::AssetTypeToString(metadata.Type));
             NB_INFO("Is loaded: {0}", metadata.IsLoaded ? "Yes" : "No");
         }
@@ -145,11 +145,14 @@ project "Nebula"
         {
             "{COPYFILE} %{cfg.buildtarget.relpath} \"../bin/" .. outputdir .. "/Runtime/\"",
             "{COPYFILE} %{cfg.buildtarget.relpath} \"../bin/" .. outputdir .. "/Cosmic/\"",
+            "{COPYFILE} %{cfg.buildtarget.relpath} \"../bin/" .. outputdir .. "/AssetStressTest/\"",
             "{COPYFILE} ../Nebula/vendor/openal-soft/build/%{cfg.buildcfg}/OpenAL32.dll \"../bin/" .. outputdir .. "/Nebula/\"",
             "{COPYFILE} ../Nebula/vendor/openal-soft/build/%{cfg.buildcfg}/OpenAL32.dll \"../bin/" .. outputdir .. "/Runtime/\"",
             "{COPYFILE} ../Nebula/vendor/openal-soft/build/%{cfg.buildcfg}/OpenAL32.dll \"../bin/" .. outputdir .. "/Cosmic/\"",
+            "{COPYFILE} ../Nebula/vendor/openal-soft/build/%{cfg.buildcfg}/OpenAL32.dll \"../bin/" .. outputdir .. "/AssetStressTest/\"",
             "{COPYFILE} ../Nebula/vendor/mono-build/mono-2.0-sgen.dll \"../bin/" .. outputdir .. "/Runtime/\"",
             "{COPYFILE} ../Nebula/vendor/mono-build/mono-2.0-sgen.dll \"../bin/" .. outputdir .. "/Cosmic/\"",
+            "{COPYFILE} ../Nebula/vendor/mono-build/mono-2.0-sgen.dll \"../bin/" .. outputdir .. "/AssetStressTest/\"",
             "{COPYDIR} ../Nebula/vendor/mono-build/lib/4.5 ../bin/" .. outputdir .. "/Runtime/lib/mono/4.5",
             "{COPYDIR} ../Nebula/vendor/mono-build/lib/4.5 ../bin/" .. outputdir .. "/Cosmic/lib/mono/4.5",
         }
@@ -412,3 +415,70 @@ project "Cosmic"
     filter "configurations:Dist"
         defines "NB_DIST"
         optimize "On"
+
+group "Tests"
+project "AssetStressTest"
+    location "Tests/AssetStressTest"
+    kind "ConsoleApp"
+    language "C++"
+    
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+    
+    files
+    {
+        "Tests/%{prj.name}/src/**.h",
+        "Tests/%{prj.name}/src/**.cpp"
+    }
+    
+    includedirs
+    {
+        "Nebula/src",
+        "Tests/%{prj.name}/src",
+        "%{IncludeDir.spdlog}",
+    }
+    
+    links
+    {
+        "Nebula",
+    }
+
+    -- Fixtures next to the executable, the test loads fixtures/ by default
+    postbuildcommands
+    {
+        "{COPYDIR} fixtures ../../bin/" .. outputdir .. "/AssetStressTest/fixtures",
+    }
+
+    filter "system:windows"
+        cppdialect "C++17"
+        staticruntime "Off"
+        systemversion "latest"
+        buildoptions { "/utf-8", "/FS" }
+
+        defines
+        {
+            "NB_PLATFORM_WINDOWS",
+        }
+
+        debugdir ("bin/" .. outputdir .. "/AssetStressTest")
+
+    filter "system:macosx"
+        cppdialect "C++17"
+        systemversion "10.15"
+
+        defines
+        {
+            "NB_PLATFORM_MACOS"
+        }
+    
+    filter "configurations:Debug"
+        defines "NB_DEBUG"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines "NB_RELEASE"
+        optimize "On"
+
+    filter "configurations:Dist"
+        defines "NB_DIST"
+        optimize "On"